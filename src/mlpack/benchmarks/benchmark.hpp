@@ -0,0 +1,149 @@
+/**
+ * @file benchmark.hpp
+ *
+ * A small harness for the mlpack benchmark executable.  Each benchmark is run
+ * several times on a synthetic dataset and the fastest run is reported along
+ * with the pruning statistics of the last run.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_HPP
+
+#include <mlpack/core.hpp>
+
+#include <chrono>
+#include <iomanip>
+
+namespace mlpack {
+namespace benchmark {
+
+/**
+ * The result of a single benchmark run.  Counters that do not apply to a
+ * benchmark are left at zero.
+ */
+struct BenchmarkResult
+{
+  BenchmarkResult() : seconds(0.0), baseCases(0), scores(0), prunes(0) { }
+
+  //! Wall time of the timed part of the benchmark, in seconds.
+  double seconds;
+  //! Number of base cases (point-to-point evaluations).
+  size_t baseCases;
+  //! Number of node scores.
+  size_t scores;
+  //! Number of pruned nodes reported by the traverser.
+  size_t prunes;
+};
+
+/**
+ * Measures wall time from construction until Seconds() is called.
+ */
+class WallClock
+{
+ public:
+  //! Start the clock.
+  WallClock() : start(std::chrono::high_resolution_clock::now()) { }
+
+  //! Get the elapsed time in seconds.
+  double Seconds() const
+  {
+    return std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - start).count();
+  }
+
+ private:
+  //! The time the clock was started.
+  std::chrono::high_resolution_clock::time_point start;
+};
+
+/**
+ * Runs benchmarks whose name matches a filter and prints one line per
+ * benchmark to the given stream, as tab-separated columns:
+ *
+ *   benchmark tree mode points dimensions seconds base_cases scores prunes
+ *
+ * A benchmark is any functor taking no arguments and returning a
+ * BenchmarkResult with the seconds field set to the time of the part of the
+ * work that should be measured (so that e.g. tree construction can be
+ * excluded from a search benchmark).
+ */
+class BenchmarkRunner
+{
+ public:
+  /**
+   * Create the runner.
+   *
+   * @param stream Stream to write results to.
+   * @param filter Only benchmarks whose full name ("benchmark/tree/mode")
+   *     contains this string are run.
+   * @param trials Number of times each benchmark is run.
+   */
+  BenchmarkRunner(std::ostream& stream,
+                  const std::string& filter,
+                  const size_t trials) :
+      stream(stream),
+      filter(filter),
+      trials(std::max(trials, (size_t) 1))
+  {
+    stream << "benchmark\ttree\tmode\tpoints\tdimensions\tseconds\tbase_cases"
+        << "\tscores\tprunes" << std::endl;
+  }
+
+  /**
+   * Run the given benchmark, if it matches the filter, and report the fastest
+   * of all trials.
+   *
+   * @param benchmark Name of the benchmark (e.g. "knn").
+   * @param tree Name of the tree type.
+   * @param mode Name of the traversal mode.
+   * @param dataset Dataset the benchmark runs on (used for reporting only).
+   * @param function The benchmark to run.
+   */
+  template<typename FunctionType>
+  void Run(const std::string& benchmark,
+           const std::string& tree,
+           const std::string& mode,
+           const arma::mat& dataset,
+           FunctionType function)
+  {
+    const std::string name = benchmark + "/" + tree + "/" + mode;
+    if (name.find(filter) == std::string::npos)
+      return;
+
+    Log::Info << "Running " << name << " on " << dataset.n_cols << " points in "
+        << dataset.n_rows << " dimensions." << std::endl;
+
+    BenchmarkResult best;
+    for (size_t t = 0; t < trials; ++t)
+    {
+      const BenchmarkResult result = function();
+      if (t == 0 || result.seconds < best.seconds)
+        best.seconds = result.seconds;
+      best.baseCases = result.baseCases;
+      best.scores = result.scores;
+      best.prunes = result.prunes;
+    }
+
+    stream << benchmark << "\t" << tree << "\t" << mode << "\t"
+        << dataset.n_cols << "\t" << dataset.n_rows << "\t" << std::fixed
+        << std::setprecision(6) << best.seconds << "\t" << best.baseCases
+        << "\t" << best.scores << "\t" << best.prunes << std::endl;
+  }
+
+ private:
+  //! Stream to write results to.
+  std::ostream& stream;
+  //! Only benchmarks containing this string are run.
+  std::string filter;
+  //! Number of times each benchmark is run.
+  size_t trials;
+};
+
+} // namespace benchmark
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,480 @@
+/**
+ * @file benchmarks_main.cpp
+ *
+ * Benchmarks for tree construction and the tree-based search methods (KNN,
+ * KFN, range search, FastMKS and rank-approximate search) on synthetic
+ * datasets.  For each benchmark the wall time and, where the method exposes
+ * them, the number of base cases, scores and prunes are reported.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/cli.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
+#include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/core/tree/octree.hpp>
+#include <mlpack/core/tree/spill_tree.hpp>
+#include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/range_search/range_search.hpp>
+#include <mlpack/methods/range_search/range_search_rules.hpp>
+#include <mlpack/methods/fastmks/fastmks.hpp>
+#include <mlpack/methods/fastmks/fastmks_rules.hpp>
+#include <mlpack/methods/rann/ra_search.hpp>
+
+#include "benchmark.hpp"
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::neighbor;
+using namespace mlpack::range;
+using namespace mlpack::fastmks;
+using namespace mlpack::kernel;
+using namespace mlpack::tree;
+using namespace mlpack::metric;
+
+PROGRAM_INFO("mlpack benchmarks",
+    "This program benchmarks tree construction for each tree type, KNN, KFN "
+    "and range search in single-tree and dual-tree mode, FastMKS, and "
+    "rank-approximate nearest neighbor search on uniformly random synthetic "
+    "datasets.  KNN and KFN are also benchmarked with the greedy single-tree "
+    "traversal (mode 'greedy'), and for the binary space trees KNN, KFN and "
+    "range search are benchmarked with the breadth-first dual-tree traversal "
+    "(mode 'breadth-first'), which is parallel with OpenMP.  For each "
+    "benchmark one tab-separated line is printed with the wall time of the "
+    "fastest trial and the number of base cases, scores and prunes of the "
+    "search (zero if not applicable)."
+    "\n\n"
+    "The dataset sizes and dimensionalities can be given with --points (-n) "
+    "and --dimensions (-d); every combination is benchmarked.  Benchmarks can "
+    "be selected with --filter (-f), which is matched against the name "
+    "'benchmark/tree/mode', for example 'knn/kd/dual'.");
+
+PARAM_VECTOR_IN(int, "points", "Numbers of points in the synthetic datasets "
+    "(default 1000 and 10000).", "n");
+PARAM_VECTOR_IN(int, "dimensions", "Dimensionalities of the synthetic datasets "
+    "(default 3 and 10).", "d");
+PARAM_INT_IN("k", "Number of neighbors to search for.", "k", 5);
+PARAM_INT_IN("trials", "Number of times each benchmark is run; the fastest run "
+    "is reported.", "t", 3);
+PARAM_STRING_IN("filter", "Only run benchmarks whose name contains this "
+    "string.", "f", "");
+PARAM_INT_IN("seed", "Random seed (0 uses the default seed).", "s", 0);
+
+/**
+ * Benchmark the construction of a tree on the dataset.
+ */
+template<typename TreeType>
+BenchmarkResult ConstructionBenchmark(const arma::mat& dataset)
+{
+  BenchmarkResult result;
+  WallClock clock;
+  TreeType tree(dataset);
+  result.seconds = clock.Seconds();
+
+  return result;
+}
+
+/**
+ * Benchmark monochromatic k-nearest or k-furthest neighbor search with the
+ * given tree type, driving the rules and traversers directly so the number of
+ * prunes is available.  Only the search is timed.  If greedy is true, the
+ * greedy single-tree traverser is used (and dualTree is ignored); its results
+ * are approximate.
+ */
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+BenchmarkResult NeighborSearchBenchmark(const arma::mat& dataset,
+                                        const size_t k,
+                                        const bool dualTree,
+                                        const bool greedy = false)
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<SortPolicy>,
+      arma::mat> Tree;
+  typedef NeighborSearchRules<SortPolicy, EuclideanDistance, Tree> RuleType;
+
+  Tree tree(dataset);
+  EuclideanDistance metric;
+
+  BenchmarkResult result;
+  WallClock clock;
+  RuleType rules(tree.Dataset(), tree.Dataset(), k, metric, 0, true);
+  if (greedy)
+  {
+    GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+    for (size_t i = 0; i < tree.Dataset().n_cols; ++i)
+      traverser.Traverse(i, tree);
+    result.prunes = traverser.NumPrunes();
+  }
+  else if (dualTree)
+  {
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(tree, tree);
+    result.prunes = traverser.NumPrunes();
+  }
+  else
+  {
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    for (size_t i = 0; i < tree.Dataset().n_cols; ++i)
+      traverser.Traverse(i, tree);
+    result.prunes = traverser.NumPrunes();
+  }
+  result.seconds = clock.Seconds();
+
+  result.baseCases = rules.BaseCases();
+  result.scores = rules.Scores();
+  return result;
+}
+
+/**
+ * Benchmark monochromatic k-nearest or k-furthest neighbor search with the
+ * breadth-first dual-tree traverser, which only binary space trees provide.
+ * With OpenMP, disjoint query subtrees are traversed by parallel workers, and
+ * their counts are merged into the rules.  Only the search is timed.
+ */
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+BenchmarkResult BreadthFirstNeighborSearchBenchmark(const arma::mat& dataset,
+                                                    const size_t k)
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<SortPolicy>,
+      arma::mat> Tree;
+  typedef NeighborSearchRules<SortPolicy, EuclideanDistance, Tree> RuleType;
+
+  Tree tree(dataset);
+  EuclideanDistance metric;
+
+  BenchmarkResult result;
+  WallClock clock;
+  RuleType rules(tree.Dataset(), tree.Dataset(), k, metric, 0, true);
+  typename Tree::template BreadthFirstDualTreeTraverser<RuleType>
+      traverser(rules);
+  traverser.Traverse(tree, tree);
+  result.seconds = clock.Seconds();
+
+  result.prunes = traverser.NumPrunes();
+  result.baseCases = rules.BaseCases();
+  result.scores = rules.Scores();
+  return result;
+}
+
+/**
+ * Benchmark monochromatic range search with the given tree type.  Only the
+ * search is timed.
+ */
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+BenchmarkResult RangeSearchBenchmark(const arma::mat& dataset,
+                                     const math::Range& range,
+                                     const bool dualTree)
+{
+  typedef TreeType<EuclideanDistance, RangeSearchStat, arma::mat> Tree;
+  typedef RangeSearchRules<EuclideanDistance, Tree> RuleType;
+
+  Tree tree(dataset);
+  EuclideanDistance metric;
+  std::vector<std::vector<size_t>> neighbors(dataset.n_cols);
+  std::vector<std::vector<double>> distances(dataset.n_cols);
+
+  BenchmarkResult result;
+  WallClock clock;
+  RuleType rules(tree.Dataset(), tree.Dataset(), range, neighbors, distances,
+      metric, true);
+  if (dualTree)
+  {
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(tree, tree);
+    result.prunes = traverser.NumPrunes();
+  }
+  else
+  {
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    for (size_t i = 0; i < tree.Dataset().n_cols; ++i)
+      traverser.Traverse(i, tree);
+    result.prunes = traverser.NumPrunes();
+  }
+  result.seconds = clock.Seconds();
+
+  result.baseCases = rules.BaseCases();
+  result.scores = rules.Scores();
+  return result;
+}
+
+/**
+ * Benchmark monochromatic range search with the breadth-first dual-tree
+ * traverser of the given binary space tree type.  The range search rules can't
+ * be forked, so this traversal is serial.  Only the search is timed.
+ */
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+BenchmarkResult BreadthFirstRangeSearchBenchmark(const arma::mat& dataset,
+                                                 const math::Range& range)
+{
+  typedef TreeType<EuclideanDistance, RangeSearchStat, arma::mat> Tree;
+  typedef RangeSearchRules<EuclideanDistance, Tree> RuleType;
+
+  Tree tree(dataset);
+  EuclideanDistance metric;
+  std::vector<std::vector<size_t>> neighbors(dataset.n_cols);
+  std::vector<std::vector<double>> distances(dataset.n_cols);
+
+  BenchmarkResult result;
+  WallClock clock;
+  RuleType rules(tree.Dataset(), tree.Dataset(), range, neighbors, distances,
+      metric, true);
+  typename Tree::template BreadthFirstDualTreeTraverser<RuleType>
+      traverser(rules);
+  traverser.Traverse(tree, tree);
+  result.seconds = clock.Seconds();
+
+  result.prunes = traverser.NumPrunes();
+  result.baseCases = rules.BaseCases();
+  result.scores = rules.Scores();
+  return result;
+}
+
+/**
+ * Benchmark monochromatic FastMKS with the linear kernel on a cover tree.
+ * Only the search is timed.
+ */
+BenchmarkResult FastMKSBenchmark(const arma::mat& dataset,
+                                 const size_t k,
+                                 const bool dualTree)
+{
+  typedef StandardCoverTree<IPMetric<LinearKernel>, FastMKSStat, arma::mat>
+      Tree;
+  typedef FastMKSRules<LinearKernel, Tree> RuleType;
+
+  Tree tree(dataset);
+
+  BenchmarkResult result;
+  WallClock clock;
+  RuleType rules(tree.Dataset(), tree.Dataset(), k, tree.Metric().Kernel());
+  if (dualTree)
+  {
+    // FastMKS does not exclude the query point itself; that does not change
+    // the amount of work done.
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(tree, tree);
+    result.prunes = traverser.NumPrunes();
+  }
+  else
+  {
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    for (size_t i = 0; i < tree.Dataset().n_cols; ++i)
+      traverser.Traverse(i, tree);
+    result.prunes = traverser.NumPrunes();
+  }
+  result.seconds = clock.Seconds();
+
+  result.baseCases = rules.BaseCases();
+  result.scores = rules.Scores();
+  return result;
+}
+
+/**
+ * Benchmark monochromatic rank-approximate nearest neighbor search with the
+ * given tree type.  RASearch does not expose its counters, so only the wall
+ * time of the search is reported.
+ */
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+BenchmarkResult RASearchBenchmark(const arma::mat& dataset,
+                                  const size_t k,
+                                  const bool dualTree)
+{
+  typedef RASearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+      RASearchType;
+  RASearchType ra(dataset, false, !dualTree);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  BenchmarkResult result;
+  WallClock clock;
+  ra.Search(k, neighbors, distances);
+  result.seconds = clock.Seconds();
+
+  return result;
+}
+
+/**
+ * Run the construction, KNN, KFN and range search benchmarks for one tree
+ * type.
+ */
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RunTreeBenchmarks(BenchmarkRunner& runner,
+                       const std::string& treeName,
+                       const arma::mat& dataset,
+                       const size_t k,
+                       const math::Range& range)
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> KNNTree;
+
+  runner.Run("construction", treeName, "-", dataset,
+      [&]() { return ConstructionBenchmark<KNNTree>(dataset); });
+
+  const bool modes[] = { false, true };
+  for (size_t m = 0; m < 2; ++m)
+  {
+    const bool dualTree = modes[m];
+    const std::string mode = dualTree ? "dual" : "single";
+
+    runner.Run("knn", treeName, mode, dataset, [&]() {
+        return NeighborSearchBenchmark<NearestNeighborSort, TreeType>(dataset,
+            k, dualTree); });
+    runner.Run("kfn", treeName, mode, dataset, [&]() {
+        return NeighborSearchBenchmark<FurthestNeighborSort, TreeType>(dataset,
+            k, dualTree); });
+    runner.Run("range", treeName, mode, dataset, [&]() {
+        return RangeSearchBenchmark<TreeType>(dataset, range, dualTree); });
+  }
+
+  // The range search rules can't choose a single child, so only KNN and KFN
+  // have a greedy traversal.
+  runner.Run("knn", treeName, "greedy", dataset, [&]() {
+      return NeighborSearchBenchmark<NearestNeighborSort, TreeType>(dataset,
+          k, false, true); });
+  runner.Run("kfn", treeName, "greedy", dataset, [&]() {
+      return NeighborSearchBenchmark<FurthestNeighborSort, TreeType>(dataset,
+          k, false, true); });
+}
+
+/**
+ * Run the KNN, KFN and range search benchmarks with the breadth-first dual-tree
+ * traversal for one binary space tree type.
+ */
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RunBreadthFirstBenchmarks(BenchmarkRunner& runner,
+                               const std::string& treeName,
+                               const arma::mat& dataset,
+                               const size_t k,
+                               const math::Range& range)
+{
+  runner.Run("knn", treeName, "breadth-first", dataset, [&]() {
+      return BreadthFirstNeighborSearchBenchmark<NearestNeighborSort,
+          TreeType>(dataset, k); });
+  runner.Run("kfn", treeName, "breadth-first", dataset, [&]() {
+      return BreadthFirstNeighborSearchBenchmark<FurthestNeighborSort,
+          TreeType>(dataset, k); });
+  runner.Run("range", treeName, "breadth-first", dataset, [&]() {
+      return BreadthFirstRangeSearchBenchmark<TreeType>(dataset, range); });
+}
+
+int main(int argc, char** argv)
+{
+  CLI::ParseCommandLine(argc, argv);
+
+  if (CLI::GetParam<int>("seed") != 0)
+    math::RandomSeed((size_t) CLI::GetParam<int>("seed"));
+  else
+    math::RandomSeed((size_t) std::time(NULL));
+
+  std::vector<int> points = CLI::GetParam<std::vector<int>>("points");
+  std::vector<int> dimensions = CLI::GetParam<std::vector<int>>("dimensions");
+  if (points.empty())
+    points = { 1000, 10000 };
+  if (dimensions.empty())
+    dimensions = { 3, 10 };
+
+  if (CLI::GetParam<int>("k") <= 0)
+    Log::Fatal << "Invalid k: " << CLI::GetParam<int>("k") << "; must be "
+        << "greater than 0." << std::endl;
+  if (CLI::GetParam<int>("trials") <= 0)
+    Log::Fatal << "Invalid number of trials: " << CLI::GetParam<int>("trials")
+        << "; must be greater than 0." << std::endl;
+
+  const size_t k = (size_t) CLI::GetParam<int>("k");
+  BenchmarkRunner runner(std::cout, CLI::GetParam<std::string>("filter"),
+      (size_t) CLI::GetParam<int>("trials"));
+
+  for (size_t p = 0; p < points.size(); ++p)
+  {
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      if (points[p] <= (int) k || dimensions[d] <= 0)
+        Log::Fatal << "Invalid dataset size " << points[p] << "x"
+            << dimensions[d] << "." << std::endl;
+
+      const arma::mat dataset(dimensions[d], points[p], arma::fill::randu);
+
+      // Choose the radius of the range search so that a ball around each
+      // point contains about 10 points on average: the volume of the d-ball
+      // of radius r is pi^(d/2) r^d / Gamma(d/2 + 1).
+      const double dim = dimensions[d];
+      const double radius = std::pow(10.0 * std::tgamma(dim / 2.0 + 1.0) /
+          (points[p] * std::pow(arma::datum::pi, dim / 2.0)), 1.0 / dim);
+      const math::Range range(0.0, radius);
+
+      RunTreeBenchmarks<KDTree>(runner, "kd", dataset, k, range);
+      RunTreeBenchmarks<BallTree>(runner, "ball", dataset, k, range);
+      RunTreeBenchmarks<StandardCoverTree>(runner, "cover", dataset, k, range);
+      RunTreeBenchmarks<RTree>(runner, "r", dataset, k, range);
+      RunTreeBenchmarks<RStarTree>(runner, "r-star", dataset, k, range);
+      RunTreeBenchmarks<XTree>(runner, "x", dataset, k, range);
+      RunTreeBenchmarks<HilbertRTree>(runner, "hilbert-r", dataset, k, range);
+      RunTreeBenchmarks<RPlusTree>(runner, "r-plus", dataset, k, range);
+      RunTreeBenchmarks<RPlusPlusTree>(runner, "r-plus-plus", dataset, k,
+          range);
+      RunTreeBenchmarks<VPTree>(runner, "vp", dataset, k, range);
+      RunTreeBenchmarks<RPTree>(runner, "rp", dataset, k, range);
+      RunTreeBenchmarks<MaxRPTree>(runner, "max-rp", dataset, k, range);
+      RunTreeBenchmarks<UBTree>(runner, "ub", dataset, k, range);
+      RunTreeBenchmarks<Octree>(runner, "oct", dataset, k, range);
+
+      // Only the binary space trees have a breadth-first traverser (the cover
+      // tree's is its depth-first traverser).
+      RunBreadthFirstBenchmarks<KDTree>(runner, "kd", dataset, k, range);
+      RunBreadthFirstBenchmarks<BallTree>(runner, "ball", dataset, k, range);
+      RunBreadthFirstBenchmarks<VPTree>(runner, "vp", dataset, k, range);
+      RunBreadthFirstBenchmarks<RPTree>(runner, "rp", dataset, k, range);
+      RunBreadthFirstBenchmarks<MaxRPTree>(runner, "max-rp", dataset, k,
+          range);
+      RunBreadthFirstBenchmarks<UBTree>(runner, "ub", dataset, k, range);
+
+      // Spill trees need a special query tree for dual-tree search, so only
+      // their construction is benchmarked here.
+      runner.Run("construction", "sp", "-", dataset, [&]() {
+          return ConstructionBenchmark<SPTree<EuclideanDistance,
+              NeighborSearchStat<NearestNeighborSort>, arma::mat>>(dataset);
+          });
+
+      runner.Run("fastmks", "cover", "single", dataset,
+          [&]() { return FastMKSBenchmark(dataset, k, false); });
+      runner.Run("fastmks", "cover", "dual", dataset,
+          [&]() { return FastMKSBenchmark(dataset, k, true); });
+
+      for (size_t m = 0; m < 2; ++m)
+      {
+        const bool dualTree = (m == 1);
+        const std::string mode = dualTree ? "dual" : "single";
+        runner.Run("rann", "kd", mode, dataset, [&]() {
+            return RASearchBenchmark<KDTree>(dataset, k, dualTree); });
+        runner.Run("rann", "cover", mode, dataset, [&]() {
+            return RASearchBenchmark<StandardCoverTree>(dataset, k, dualTree);
+            });
+        runner.Run("rann", "r-star", mode, dataset, [&]() {
+            return RASearchBenchmark<RStarTree>(dataset, k, dualTree); });
+      }
+    }
+  }
+
+  CLI::Destroy();
+}
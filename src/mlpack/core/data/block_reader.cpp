@@ -0,0 +1,228 @@
+/**
+ * @file block_reader.cpp
+ *
+ * Implementation of the file-backed block readers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "block_reader.hpp"
+
+#include <cstdlib>
+
+namespace mlpack {
+namespace data {
+
+BinaryBlockReader::BinaryBlockReader(const std::string& filename,
+                                     const size_t blockSize,
+                                     const bool transposed) :
+    filename(filename),
+    stream(filename.c_str(), std::fstream::binary),
+    blockSize(std::max(blockSize, (size_t) 1)),
+    transposed(transposed),
+    rows(0),
+    cols(0),
+    dataOffset(0),
+    position(0)
+{
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  // The header is the format string followed by the matrix size, as written by
+  // Armadillo's arma_binary format.
+  std::string header;
+  size_t fileRows = 0, fileCols = 0;
+  stream >> header >> fileRows >> fileCols;
+  stream.get(); // The newline after the size.
+
+  if (!stream.good() || header != "ARMA_MAT_BIN_FN008")
+  {
+    std::ostringstream oss;
+    oss << "File '" << filename << "' is not a double-precision Armadillo "
+        << "binary matrix." << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  dataOffset = stream.tellg();
+  rows = transposed ? fileCols : fileRows;
+  cols = transposed ? fileRows : fileCols;
+}
+
+bool BinaryBlockReader::NextBlock(arma::mat& block)
+{
+  if (position >= cols)
+    return false;
+
+  const size_t count = std::min(blockSize, cols - position);
+  block.set_size(rows, count);
+
+  if (transposed)
+  {
+    // Each dimension is a column of the file, so read one contiguous run per
+    // dimension and scatter it into the corresponding row of the block.
+    arma::vec buffer(count);
+    for (size_t d = 0; d < rows; ++d)
+    {
+      stream.seekg(dataOffset + (std::streamoff) ((d * cols + position) *
+          sizeof(double)));
+      stream.read((char*) buffer.memptr(), count * sizeof(double));
+      block.row(d) = buffer.t();
+    }
+  }
+  else
+  {
+    // The points are stored contiguously, so the block is a single read.
+    stream.seekg(dataOffset + (std::streamoff) (position * rows *
+        sizeof(double)));
+    stream.read((char*) block.memptr(), count * rows * sizeof(double));
+  }
+
+  if (!stream.good())
+  {
+    std::ostringstream oss;
+    oss << "Error reading points " << position << " to " << position + count
+        << " of file '" << filename << "'; the file may be truncated."
+        << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  position += count;
+  return true;
+}
+
+CSVBlockReader::CSVBlockReader(const std::string& filename,
+                               const size_t blockSize) :
+    filename(filename),
+    stream(filename.c_str()),
+    blockSize(std::max(blockSize, (size_t) 1)),
+    rows(0),
+    cols(0),
+    position(0)
+{
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  // Take one pass to find the number of points and check that every line has
+  // the same number of values.
+  std::string line;
+  std::vector<double> values;
+  while (std::getline(stream, line))
+  {
+    if (IsBlank(line))
+      continue;
+
+    if (cols == 0)
+    {
+      values.resize(line.size() / 2 + 1);
+      rows = ParseLine(line, values.data(), values.size());
+    }
+    else if (ParseLine(line, values.data(), values.size()) != rows)
+    {
+      std::ostringstream oss;
+      oss << "Line " << cols + 1 << " of file '" << filename << "' does not "
+          << "have " << rows << " values." << std::endl;
+      throw std::runtime_error(oss.str());
+    }
+
+    ++cols;
+  }
+
+  if (cols == 0 || rows == 0)
+  {
+    std::ostringstream oss;
+    oss << "File '" << filename << "' contains no data." << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  Reset();
+}
+
+void CSVBlockReader::Reset()
+{
+  stream.clear();
+  stream.seekg(0);
+  position = 0;
+}
+
+bool CSVBlockReader::NextBlock(arma::mat& block)
+{
+  if (position >= cols)
+    return false;
+
+  const size_t count = std::min(blockSize, cols - position);
+  block.set_size(rows, count);
+
+  std::string line;
+  size_t i = 0;
+  while (i < count && std::getline(stream, line))
+  {
+    if (IsBlank(line))
+      continue;
+
+    ParseLine(line, block.colptr(i), rows);
+    ++i;
+  }
+
+  if (i != count)
+  {
+    std::ostringstream oss;
+    oss << "File '" << filename << "' changed while it was being read."
+        << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  position += count;
+  return true;
+}
+
+size_t CSVBlockReader::ParseLine(const std::string& line,
+                                 double* values,
+                                 const size_t maxValues)
+{
+  const char* current = line.c_str();
+  size_t found = 0;
+  while (*current != '\0')
+  {
+    // Skip any separators.
+    if (*current == ',' || *current == ' ' || *current == '\t' ||
+        *current == '\r')
+    {
+      ++current;
+      continue;
+    }
+
+    char* end;
+    const double value = std::strtod(current, &end);
+    if (end == current)
+    {
+      std::ostringstream oss;
+      oss << "Cannot parse '" << line << "' as numeric data." << std::endl;
+      throw std::runtime_error(oss.str());
+    }
+
+    if (found < maxValues)
+      values[found] = value;
+    ++found;
+    current = end;
+  }
+
+  return found;
+}
+
+bool CSVBlockReader::IsBlank(const std::string& line)
+{
+  return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+} // namespace data
+} // namespace mlpack
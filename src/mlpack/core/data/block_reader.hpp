@@ -0,0 +1,239 @@
+/**
+ * @file block_reader.hpp
+ *
+ * Readers that present a dataset as a sequence of column blocks, so that
+ * algorithms which only need a few passes over the data (such as the streaming
+ * variants of RandomizedSVD and PCA) never have to hold the full matrix in
+ * memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BLOCK_READER_HPP
+#define MLPACK_CORE_DATA_BLOCK_READER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A block reader over a matrix that is already in memory.  This is mostly
+ * useful for testing, and for calling the streaming interfaces of algorithms
+ * with data that happens to fit in memory anyway.
+ *
+ * All block readers share the same interface:
+ *
+ * @code
+ * size_t Rows() const;                // Dimensionality of each point.
+ * size_t Cols() const;                // Total number of points.
+ * void Reset();                       // Rewind to the first point.
+ * bool NextBlock(arma::mat& block);   // Read the next block; false when done.
+ * @endcode
+ *
+ * Each block holds at most BlockSize() points, one per column.
+ */
+class MatrixBlockReader
+{
+ public:
+  /**
+   * Create the reader on the given matrix.  The matrix is not copied and must
+   * outlive the reader.
+   *
+   * @param data Matrix to read from (one point per column).
+   * @param blockSize Maximum number of points in each block.
+   */
+  MatrixBlockReader(const arma::mat& data, const size_t blockSize = 1000) :
+      data(data),
+      blockSize(std::max(blockSize, (size_t) 1)),
+      position(0)
+  { /* Nothing to do. */ }
+
+  //! Get the dimensionality of the data.
+  size_t Rows() const { return data.n_rows; }
+  //! Get the number of points in the data.
+  size_t Cols() const { return data.n_cols; }
+  //! Get the maximum number of points in a block.
+  size_t BlockSize() const { return blockSize; }
+
+  //! Rewind to the first point.
+  void Reset() { position = 0; }
+
+  /**
+   * Store the next block of points in the given matrix.  Returns false (and
+   * leaves the matrix untouched) if there are no points left.
+   */
+  bool NextBlock(arma::mat& block)
+  {
+    if (position >= data.n_cols)
+      return false;
+
+    const size_t end = std::min(position + blockSize, (size_t) data.n_cols);
+    block = data.cols(position, end - 1);
+    position = end;
+    return true;
+  }
+
+ private:
+  //! The data to read from.
+  const arma::mat& data;
+  //! The maximum number of points in each block.
+  size_t blockSize;
+  //! The index of the next point to be read.
+  size_t position;
+};
+
+/**
+ * A block reader over a file saved in Armadillo's binary format (arma_binary,
+ * double precision).  Only the header is read when the reader is constructed;
+ * each call to NextBlock() reads just the requested points from disk.
+ *
+ * By default the file is assumed to be stored transposed (one point per row),
+ * which is what data::Save() writes.  In that layout every dimension of a block
+ * is a contiguous run in the file, so a block costs one read per dimension.
+ */
+class BinaryBlockReader
+{
+ public:
+  /**
+   * Open the given file and read its header.  If the file cannot be opened or
+   * is not a double-precision arma_binary file, a std::runtime_error is
+   * thrown.
+   *
+   * @param filename Name of the file to read.
+   * @param blockSize Maximum number of points in each block.
+   * @param transposed If true, the file holds one point per row (the default
+   *     for data::Save()).
+   */
+  BinaryBlockReader(const std::string& filename,
+                    const size_t blockSize = 1000,
+                    const bool transposed = true);
+
+  //! Get the dimensionality of the data.
+  size_t Rows() const { return rows; }
+  //! Get the number of points in the data.
+  size_t Cols() const { return cols; }
+  //! Get the maximum number of points in a block.
+  size_t BlockSize() const { return blockSize; }
+
+  //! Rewind to the first point.
+  void Reset() { position = 0; }
+
+  /**
+   * Store the next block of points in the given matrix.  Returns false (and
+   * leaves the matrix untouched) if there are no points left.
+   */
+  bool NextBlock(arma::mat& block);
+
+ private:
+  //! The name of the file (used for error messages).
+  std::string filename;
+  //! The open file.
+  std::ifstream stream;
+  //! The maximum number of points in each block.
+  size_t blockSize;
+  //! Whether the file holds one point per row.
+  bool transposed;
+  //! The dimensionality of the data.
+  size_t rows;
+  //! The number of points in the data.
+  size_t cols;
+  //! The offset of the first element after the header.
+  std::streamoff dataOffset;
+  //! The index of the next point to be read.
+  size_t position;
+};
+
+/**
+ * A block reader over a numeric CSV file with one point per line (the layout
+ * data::Load() expects by default).  Values may be separated by commas, spaces
+ * or tabs.  The file is scanned once at construction to count the points, and
+ * after that lines are parsed only as their block is requested.
+ *
+ * Unlike data::Load(), no categorical mapping is done; every field must be
+ * numeric.
+ */
+class CSVBlockReader
+{
+ public:
+  /**
+   * Open the given file and count its points.  If the file cannot be opened,
+   * is empty, or has lines of differing lengths, a std::runtime_error is
+   * thrown.
+   *
+   * @param filename Name of the file to read.
+   * @param blockSize Maximum number of points in each block.
+   */
+  CSVBlockReader(const std::string& filename, const size_t blockSize = 1000);
+
+  //! Get the dimensionality of the data.
+  size_t Rows() const { return rows; }
+  //! Get the number of points in the data.
+  size_t Cols() const { return cols; }
+  //! Get the maximum number of points in a block.
+  size_t BlockSize() const { return blockSize; }
+
+  //! Rewind to the first point.
+  void Reset();
+
+  /**
+   * Store the next block of points in the given matrix.  Returns false (and
+   * leaves the matrix untouched) if there are no points left.
+   */
+  bool NextBlock(arma::mat& block);
+
+ private:
+  /**
+   * Parse a single line into the given column.  Returns the number of values
+   * found; at most maxValues are written.
+   */
+  static size_t ParseLine(const std::string& line,
+                          double* values,
+                          const size_t maxValues);
+
+  //! Returns true if the line holds no values.
+  static bool IsBlank(const std::string& line);
+
+  //! The name of the file (used for error messages).
+  std::string filename;
+  //! The open file.
+  std::ifstream stream;
+  //! The maximum number of points in each block.
+  size_t blockSize;
+  //! The dimensionality of the data.
+  size_t rows;
+  //! The number of points in the data.
+  size_t cols;
+  //! The index of the next point to be read.
+  size_t position;
+};
+
+/**
+ * Compute the mean of all points given by a block reader in a single pass.  The
+ * reader is rewound before and after the pass.
+ *
+ * @param reader Block reader to compute the mean of.
+ * @param mean Vector to store the mean in.
+ */
+template<typename BlockReaderType>
+void BlockMean(BlockReaderType& reader, arma::vec& mean)
+{
+  mean.zeros(reader.Rows());
+  reader.Reset();
+
+  arma::mat block;
+  while (reader.NextBlock(block))
+    mean += arma::sum(block, 1);
+
+  mean /= reader.Cols();
+  reader.Reset();
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include <boost/bimap.hpp>
 
+#include "string_map.hpp"
 #include "map_policies/increment_policy.hpp"
 
 namespace mlpack {
@@ -30,6 +31,11 @@ namespace data {
  * (Datatype::numeric or Datatype::categorical) as well as mappings from strings
  * to unsigned integers and vice versa.
  *
+ * The mappings of each dimension are held in their own StringMap, a flat hash
+ * table that stores each distinct string once.  Large batches of strings from a
+ * single dimension can be mapped with MapTokens(), which deduplicates them in
+ * parallel before passing each new string to the policy.
+ *
  * @tparam PolicyType Mapping policy used to specify MapString();
  */
 template <typename PolicyType>
@@ -74,6 +80,25 @@ class DatasetMapper
   T MapString(const std::string& string,
               const size_t dimension);
 
+  /**
+   * Map a batch of strings that all belong to the given dimension, giving the
+   * same values as calling MapString() on each of them in order, provided that
+   * mapping them does not change the type of the dimension (this holds after
+   * the first pass done by data::Load()).  The strings are split into chunks
+   * that are searched in parallel; strings without a mapping are deduplicated
+   * within each chunk, and then each distinct new string is passed to the
+   * policy once, in the order of its first occurrence.
+   *
+   * @tparam T Numeric type to map to (int/double/float/etc.).
+   * @param tokens Strings to map.
+   * @param dimension Index of the dimension of the strings.
+   * @param values Vector to store the mapped values in.
+   */
+  template<typename T>
+  void MapTokens(const std::vector<std::string>& tokens,
+                 const size_t dimension,
+                 arma::Row<T>& values);
+
   /**
    * Return the string that corresponds to a given value in a given dimension.
    * If the string is not a valid mapping in the given dimension, a
@@ -119,11 +144,7 @@ class DatasetMapper
    * Serialize the dataset information.
    */
   template<typename Archive>
-  void Serialize(Archive& ar, const unsigned int /* version */)
-  {
-    ar & data::CreateNVP(types, "types");
-    ar & data::CreateNVP(maps, "maps");
-  }
+  void Serialize(Archive& ar, const unsigned int version);
 
   //! Return the policy of the mapper.
   const PolicyType& Policy() const;
@@ -137,13 +158,10 @@ class DatasetMapper
   //! Types of each dimension.
   std::vector<Datatype> types;
 
-  // BiMapType definition
-  using BiMapType = boost::bimap<std::string, typename PolicyType::MappedType>;
-
-  // Mappings from strings to integers.
-  // Map entries will only exist for dimensions that are categorical.
-  // MapType = map<dimension, pair<bimap<string, MappedType>, numMappings>>
-  using MapType = std::unordered_map<size_t, std::pair<BiMapType, size_t>>;
+  // Mappings from strings to values, indexed by dimension.  Dimensions without
+  // any mappings have an empty map (or none, if no higher dimension has been
+  // mapped).
+  using MapType = std::vector<StringMap<typename PolicyType::MappedType>>;
 
   //! maps object stores string and numerical pairs.
   MapType maps;
@@ -159,6 +177,10 @@ using DatasetInfo = DatasetMapper<data::IncrementPolicy>;
 } // namespace data
 } // namespace mlpack
 
+//! Set the serialization version of the DatasetMapper class.
+BOOST_TEMPLATE_CLASS_VERSION(template<typename PolicyType>,
+    mlpack::data::DatasetMapper<PolicyType>, 1);
+
 #include "dataset_mapper_impl.hpp"
 
 #endif
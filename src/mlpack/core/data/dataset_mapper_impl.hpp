@@ -16,6 +16,10 @@
 // In case it hasn't already been included.
 #include "dataset_mapper.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
@@ -76,9 +80,87 @@ template<typename T>
 inline T DatasetMapper<PolicyType>::MapString(const std::string& string,
                                               const size_t dimension)
 {
+  if (dimension >= maps.size())
+    maps.resize(dimension + 1);
+
   return policy.template MapString<MapType, T>(string, dimension, maps, types);
 }
 
+template<typename PolicyType>
+template<typename T>
+void DatasetMapper<PolicyType>::MapTokens(
+    const std::vector<std::string>& tokens,
+    const size_t dimension,
+    arma::Row<T>& values)
+{
+  if (dimension >= maps.size())
+    maps.resize(dimension + 1);
+
+  values.set_size(tokens.size());
+
+  // Small batches aren't worth splitting.
+  const size_t minChunkSize = 4096;
+  size_t numChunks = 1;
+#ifdef HAS_OPENMP
+  numChunks = omp_get_max_threads();
+#endif
+  numChunks = std::max(std::min(numChunks, tokens.size() / minChunkSize),
+      (size_t) 1);
+
+  // First, resolve the strings that already have a mapping, and collect the
+  // distinct strings of each chunk that don't.  The map isn't modified, so it
+  // can be searched by every thread.
+  const StringMap<typename PolicyType::MappedType>& map = maps[dimension];
+  std::vector<StringMap<size_t>> unmapped(numChunks);
+  std::vector<size_t> unmappedIndices(tokens.size());
+
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables.
+  #pragma omp parallel for
+  for (intmax_t c = 0; c < (intmax_t) numChunks; ++c)
+  {
+    const size_t begin = c * tokens.size() / numChunks;
+    const size_t end = (c + 1) * tokens.size() / numChunks;
+    for (size_t i = begin; i < end; ++i)
+    {
+      size_t index;
+      if (map.Find(tokens[i], index))
+      {
+        values[i] = T(map.Value(index));
+        unmappedIndices[i] = 0;
+      }
+      else
+      {
+        // Index 0 is used for strings that were found, so shift by one.
+        unmappedIndices[i] = unmapped[c].Insert(tokens[i], 0) + 1;
+      }
+    }
+  }
+
+  // Now let the policy map each new string, in order of first occurrence.
+  std::vector<std::vector<T>> unmappedValues(numChunks);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    unmappedValues[c].resize(unmapped[c].Size());
+    for (size_t i = 0; i < unmapped[c].Size(); ++i)
+    {
+      unmappedValues[c][i] = policy.template MapString<MapType, T>(
+          unmapped[c].String(i), dimension, maps, types);
+    }
+  }
+
+  // Finally, fill in the values of the strings that were mapped.
+  #pragma omp parallel for
+  for (intmax_t c = 0; c < (intmax_t) numChunks; ++c)
+  {
+    const size_t begin = c * tokens.size() / numChunks;
+    const size_t end = (c + 1) * tokens.size() / numChunks;
+    for (size_t i = begin; i < end; ++i)
+      if (unmappedIndices[i] != 0)
+        values[i] = unmappedValues[c][unmappedIndices[i] - 1];
+  }
+}
+
 // Return the string corresponding to a value in a given dimension.
 template<typename PolicyType>
 inline const std::string& DatasetMapper<PolicyType>::UnmapString(
@@ -86,7 +168,8 @@ inline const std::string& DatasetMapper<PolicyType>::UnmapString(
     const size_t dimension)
 {
   // Throw an exception if the value doesn't exist.
-  if (maps[dimension].first.right.count(value) == 0)
+  size_t index;
+  if (dimension >= maps.size() || !maps[dimension].FindValue(value, index))
   {
     std::ostringstream oss;
     oss << "DatasetMapper<PolicyType>::UnmapString(): value '" << value
@@ -94,7 +177,7 @@ inline const std::string& DatasetMapper<PolicyType>::UnmapString(
     throw std::invalid_argument(oss.str());
   }
 
-  return maps[dimension].first.right.at(value);
+  return maps[dimension].String(index);
 }
 
 // Return the value corresponding to a string in a given dimension.
@@ -104,7 +187,8 @@ inline typename PolicyType::MappedType DatasetMapper<PolicyType>::UnmapValue(
     const size_t dimension)
 {
   // Throw an exception if the value doesn't exist.
-  if (maps[dimension].first.left.count(string) == 0)
+  size_t index;
+  if (dimension >= maps.size() || !maps[dimension].Find(string, index))
   {
     std::ostringstream oss;
     oss << "DatasetMapper<PolicyType>::UnmapValue(): string '" << string
@@ -112,7 +196,7 @@ inline typename PolicyType::MappedType DatasetMapper<PolicyType>::UnmapValue(
     throw std::invalid_argument(oss.str());
   }
 
-  return maps[dimension].first.left.at(string);
+  return maps[dimension].Value(index);
 }
 
 // Get the type of a particular dimension.
@@ -143,7 +227,55 @@ template<typename PolicyType>
 inline
 size_t DatasetMapper<PolicyType>::NumMappings(const size_t dimension) const
 {
-  return (maps.count(dimension) == 0) ? 0 : maps.at(dimension).second;
+  return (dimension >= maps.size()) ? 0 : maps[dimension].Size();
+}
+
+template<typename PolicyType>
+template<typename Archive>
+void DatasetMapper<PolicyType>::Serialize(Archive& ar,
+                                          const unsigned int version)
+{
+  ar & data::CreateNVP(types, "types");
+
+  // Backward compatibility: older versions of DatasetMapper stored the
+  // mappings as a map from dimension to a boost::bimap and the number of
+  // mappings.
+  if (version == 0)
+  {
+    typedef boost::bimap<std::string, typename PolicyType::MappedType>
+        BiMapType;
+    std::unordered_map<size_t, std::pair<BiMapType, size_t>> oldMaps;
+    ar & data::CreateNVP(oldMaps, "maps");
+
+    maps.clear();
+    for (const auto& dimensionMap : oldMaps)
+    {
+      if (dimensionMap.first >= maps.size())
+        maps.resize(dimensionMap.first + 1);
+
+      // Insert the strings in order of their values, so that mappings made by
+      // IncrementPolicy keep their indices.
+      for (const auto& entry : dimensionMap.second.first.right)
+        maps[dimensionMap.first].Insert(entry.second, entry.first);
+    }
+  }
+  else
+  {
+    size_t numMaps = maps.size();
+    ar & data::CreateNVP(numMaps, "numMaps");
+    if (Archive::is_loading::value)
+    {
+      maps.clear();
+      maps.resize(numMaps);
+    }
+
+    for (size_t i = 0; i < numMaps; ++i)
+    {
+      std::ostringstream name;
+      name << "map" << i;
+      ar & data::CreateNVP(maps[i], name.str());
+    }
+  }
 }
 
 template<typename PolicyType>
@@ -308,6 +308,37 @@ private:
     inFile.clear();
     inFile.seekg(0, std::ios::beg);
 
+    // The strings of categorical dimensions are collected for a block of lines
+    // and then mapped all at once, so that the DatasetMapper can deduplicate
+    // them in parallel.  Whether a dimension is collected is decided at the
+    // start of each block.
+    const size_t blockLines = std::max((size_t) 1,
+        (size_t) 1048576 / std::max(rows, (size_t) 1));
+    size_t blockStart = 0;
+    std::vector<bool> collect(rows);
+    std::vector<std::vector<std::string>> tokens(rows);
+    arma::Row<T> mapped;
+
+    auto startBlock = [&]()
+    {
+      blockStart = col;
+      for (size_t d = 0; d < rows; ++d)
+        collect[d] = (infoSet.Type(d) == Datatype::categorical);
+    };
+
+    auto mapBlock = [&]()
+    {
+      for (size_t d = 0; d < rows; ++d)
+      {
+        if (tokens[d].empty())
+          continue;
+
+        infoSet.template MapTokens<T>(tokens[d], d, mapped);
+        inout.submat(d, blockStart, d, col - 1) = mapped;
+        tokens[d].clear();
+      }
+    };
+
     /**
      * This is the parse rule for strings.  When we get a string we have to pass
      * it to the DatasetMapper.
@@ -318,10 +349,14 @@ private:
       std::string str(iter.begin(), iter.end());
       boost::trim(str);
 
-      inout(row, col) = infoSet.template MapString<T>(std::move(str), row);
+      if (row < rows && collect[row])
+        tokens[row].push_back(std::move(str));
+      else
+        inout(row, col) = infoSet.template MapString<T>(std::move(str), row);
       ++row;
     };
 
+    startBlock();
     while (std::getline(inFile, line))
     {
       // Remove whitespace from either side.
@@ -354,7 +389,15 @@ private:
 
       // Increment the column index.
       ++col;
+
+      if (col - blockStart == blockLines)
+      {
+        mapBlock();
+        startBlock();
+      }
     }
+
+    mapBlock();
   }
 
   //! Spirit rule for parsing.
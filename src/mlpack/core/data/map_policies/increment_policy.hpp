@@ -14,7 +14,6 @@
 
 #include <mlpack/prereqs.hpp>
 #include <unordered_map>
-#include <boost/bimap.hpp>
 #include <mlpack/core/data/map_policies/datatype.hpp>
 
 namespace mlpack {
@@ -71,10 +70,11 @@ class IncrementPolicy
    * the given dimension. This function is used as a helper function for
    * DatasetMapper class.
    *
-   * @tparam MapType Type of unordered_map that contains mapped value pairs
+   * @tparam MapType Type of vector that contains the StringMap of each
+   *     dimension.
    * @param string String to find/create mapping for.
    * @param dimension Index of the dimension of the string.
-   * @param maps Unordered map given by the DatasetMapper.
+   * @param maps Maps given by the DatasetMapper.
    * @param types Vector containing the type information about each dimensions.
    */
   template<typename MapType, typename T>
@@ -103,28 +103,20 @@ class IncrementPolicy
 
     // The token must be mapped.
 
-    // If this condition is true, either we have no mapping for the given string
-    // or we have no mappings for the given dimension at all.  In either case,
-    // we create a mapping.
-    if (maps.count(dimension) == 0 ||
-        maps[dimension].first.left.count(string) == 0)
-    {
-      // This string does not exist yet.
-      size_t& numMappings = maps[dimension].second;
+    // If the string already has a mapping, return it.
+    size_t index;
+    if (maps[dimension].Find(string, index))
+      return maps[dimension].Value(index);
 
-      // Change type of the feature to categorical.
-      if (numMappings == 0)
-        types[dimension] = Datatype::categorical;
+    // This string does not exist yet.
+    const size_t numMappings = maps[dimension].Size();
 
-      typedef boost::bimap<std::string, MappedType>::value_type PairType;
-      maps[dimension].first.insert(PairType(string, numMappings));
-      return T(numMappings++);
-    }
-    else
-    {
-      // This string already exists in the mapping.
-      return maps[dimension].first.left.at(string);
-    }
+    // Change type of the feature to categorical.
+    if (numMappings == 0)
+      types[dimension] = Datatype::categorical;
+
+    maps[dimension].Insert(string, numMappings);
+    return T(numMappings);
   }
 }; // class IncrementPolicy
 
@@ -14,7 +14,6 @@
 
 #include <mlpack/prereqs.hpp>
 #include <unordered_map>
-#include <boost/bimap.hpp>
 #include <mlpack/core/data/map_policies/datatype.hpp>
 #include <limits>
 
@@ -73,10 +72,11 @@ class MissingPolicy
    * dimension. This function is used as a helper function for DatasetMapper
    * class.
    *
-   * @tparam MapType Type of unordered_map that contains mapped value pairs
+   * @tparam MapType Type of vector that contains the StringMap of each
+   *     dimension.
    * @param string String to find/create mapping for.
    * @param dimension Index of the dimension of the string.
-   * @param maps Unordered map given by the DatasetMapper.
+   * @param maps Maps given by the DatasetMapper.
    * @param types Vector containing the type information about each dimensions.
    */
   template<typename MapType, typename T>
@@ -101,15 +101,8 @@ class MissingPolicy
     {
       // Everything is mapped to NaN.  However we must still keep track of
       // everything that we have mapped, so we add it to the maps if needed.
-      if (maps.count(dimension) == 0 ||
-          maps[dimension].first.left.count(string) == 0)
-      {
-        // This string does not exist yet.
-        typedef boost::bimap<std::string, MappedType>::value_type PairType;
-        maps[dimension].first.insert(PairType(string,
-            std::numeric_limits<MappedType>::quiet_NaN()));
-        maps[dimension].second++;
-      }
+      maps[dimension].Insert(string,
+          std::numeric_limits<MappedType>::quiet_NaN());
 
       return std::numeric_limits<T>::quiet_NaN();
     }
@@ -0,0 +1,205 @@
+/**
+ * @file string_map.hpp
+ *
+ * Definition of the StringMap class, a flat hash table from strings to mapped
+ * values that is used by DatasetMapper to hold the mappings of one dimension.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STRING_MAP_HPP
+#define MLPACK_CORE_DATA_STRING_MAP_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <deque>
+#include <functional>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A map from strings to values of type MappedType that can also be searched in
+ * the reverse direction.  Each string is given a dense index in the order it
+ * was inserted; the strings, their hashes and their values are stored in
+ * arrays indexed by this index, and an open-addressing hash table with linear
+ * probing holds only the indices.  This uses much less memory than a node-based
+ * bidirectional map when there are many distinct strings, and lookups touch
+ * only a few contiguous slots.
+ *
+ * The strings are kept in a std::deque, which allocates them in large blocks
+ * and never moves them, so references returned by String() stay valid as more
+ * strings are inserted.
+ *
+ * Lookups are const and may be done by several threads at once, as long as no
+ * thread is inserting at the same time.
+ *
+ * @tparam MappedType Type of the values that strings are mapped to.
+ */
+template<typename MappedType>
+class StringMap
+{
+ public:
+  //! Create an empty map.
+  StringMap() : slots(minSlots, 0) { }
+
+  //! Get the number of strings in the map.
+  size_t Size() const { return strings.size(); }
+
+  /**
+   * Find the index of the given string.
+   *
+   * @param string String to search for.
+   * @param index Set to the index of the string, if it is found.
+   * @return Whether the string is in the map.
+   */
+  bool Find(const std::string& string, size_t& index) const
+  {
+    const size_t hash = std::hash<std::string>()(string);
+    for (size_t slot = hash & (slots.size() - 1); slots[slot] != 0;
+         slot = (slot + 1) & (slots.size() - 1))
+    {
+      const size_t i = slots[slot] - 1;
+      if (hashes[i] == hash && strings[i] == string)
+      {
+        index = i;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Find the index of a string mapped to the given value.  Maps filled by
+   * IncrementPolicy hold the value i at index i, so this is constant time for
+   * them; otherwise the values are searched in order.
+   *
+   * @param value Value to search for.
+   * @param index Set to the index of the first string with that value, if any.
+   * @return Whether any string is mapped to the value.
+   */
+  bool FindValue(const size_t value, size_t& index) const
+  {
+    if (value < values.size() && values[value] == value)
+    {
+      index = value;
+      return true;
+    }
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      if (values[i] == value)
+      {
+        index = i;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * Map the given string to the given value, if the string is not already in
+   * the map; otherwise the existing value is kept.
+   *
+   * @param string String to insert.
+   * @param value Value of the string.
+   * @return Index of the string.
+   */
+  size_t Insert(const std::string& string, const MappedType& value)
+  {
+    size_t index;
+    if (Find(string, index))
+      return index;
+
+    // Keep the table at most half full, so that probe sequences stay short.
+    if (2 * (strings.size() + 1) > slots.size())
+      Rehash(2 * slots.size());
+
+    index = strings.size();
+    strings.push_back(string);
+    hashes.push_back(std::hash<std::string>()(string));
+    values.push_back(value);
+    Place(index);
+
+    return index;
+  }
+
+  //! Get the string with the given index.
+  const std::string& String(const size_t index) const { return strings[index]; }
+  //! Get the value of the string with the given index.
+  const MappedType& Value(const size_t index) const { return values[index]; }
+
+  //! Remove all strings from the map.
+  void Clear()
+  {
+    strings.clear();
+    hashes.clear();
+    values.clear();
+    slots.assign(minSlots, 0);
+  }
+
+  //! Serialize the map.  Only the strings and the values are stored.
+  template<typename Archive>
+  void Serialize(Archive& ar, const unsigned int /* version */)
+  {
+    std::vector<std::string> stringList;
+    if (Archive::is_saving::value)
+      stringList.assign(strings.begin(), strings.end());
+
+    ar & data::CreateNVP(stringList, "strings");
+    ar & data::CreateNVP(values, "values");
+
+    if (Archive::is_loading::value)
+    {
+      strings.assign(stringList.begin(), stringList.end());
+      hashes.resize(strings.size());
+      for (size_t i = 0; i < strings.size(); ++i)
+        hashes[i] = std::hash<std::string>()(strings[i]);
+
+      size_t numSlots = minSlots;
+      while (numSlots < 2 * strings.size())
+        numSlots *= 2;
+      Rehash(numSlots);
+    }
+  }
+
+ private:
+  //! Rebuild the hash table with the given number of slots (a power of two).
+  void Rehash(const size_t numSlots)
+  {
+    slots.assign(numSlots, 0);
+    for (size_t i = 0; i < strings.size(); ++i)
+      Place(i);
+  }
+
+  //! Put the string with the given index in the first free slot of its probe
+  //! sequence.
+  void Place(const size_t index)
+  {
+    size_t slot = hashes[index] & (slots.size() - 1);
+    while (slots[slot] != 0)
+      slot = (slot + 1) & (slots.size() - 1);
+    slots[slot] = index + 1;
+  }
+
+  //! The initial number of slots of the hash table.
+  static const size_t minSlots = 16;
+
+  //! The strings, by index.
+  std::deque<std::string> strings;
+  //! The hash of each string, by index.
+  std::vector<size_t> hashes;
+  //! The value of each string, by index.
+  std::vector<MappedType> values;
+  //! The hash table; each slot holds the index of a string plus one, or 0 if
+  //! it is empty.
+  std::vector<size_t> slots;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
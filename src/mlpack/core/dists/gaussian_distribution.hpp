@@ -95,6 +95,16 @@ class GaussianDistribution
     probabilities = arma::exp(logProbabilities);
   }
 
+  /**
+   * Calculates the multivariate Gaussian log probability density function for
+   * each data point (column) in the given matrix.  This uses one triangular
+   * solve with the Cholesky factor of the covariance for all of the points, so
+   * it is much faster than calling LogProbability() on each point.
+   *
+   * @param x List of observations.
+   * @param logProbabilities Output log probabilities for each input
+   *     observation.
+   */
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const;
 
   /**
@@ -167,27 +177,19 @@ class GaussianDistribution
   void FactorCovariance();
 };
 
-/**
-* Calculates the multivariate Gaussian log probability density function for each
-* data point (column) in the given matrix
-*
-* @param x List of observations.
-* @param probabilities Output log probabilities for each input observation.
-*/
 inline void GaussianDistribution::LogProbability(const arma::mat& x,
                                                  arma::vec& logProbabilities) const
 {
   // Column i of 'diffs' is the difference between x.col(i) and the mean.
-  arma::mat diffs = x - (mean * arma::ones<arma::rowvec>(x.n_cols));
-
-  // Now, we only want to calculate the diagonal elements of (diffs' * cov^-1 *
-  // diffs).  We just don't need any of the other elements.  We can calculate
-  // the right hand part of the equation (instead of the left side) so that
-  // later we are referencing columns, not rows -- that is faster.
-  const arma::mat rhs = -0.5 * invCov * diffs;
-  arma::vec logExponents(diffs.n_cols); // We will now fill this.
-  for (size_t i = 0; i < diffs.n_cols; i++)
-    logExponents(i) = accu(diffs.unsafe_col(i) % rhs.unsafe_col(i));
+  arma::mat diffs = x;
+  diffs.each_col() -= mean;
+
+  // We only want the diagonal elements of (diffs' * cov^-1 * diffs).  Since
+  // cov = L L^T, element i is the squared norm of column i of L^-1 * diffs,
+  // which a single triangular solve gives for all of the points.
+  const arma::mat whitened = arma::solve(arma::trimatl(covLower), diffs);
+  const arma::vec logExponents = -0.5 *
+      arma::trans(arma::sum(arma::square(whitened), 0));
 
   const size_t k = x.n_rows;
 
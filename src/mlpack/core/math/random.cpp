@@ -20,6 +20,10 @@ MLPACK_EXPORT std::mt19937 randGen;
 MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist(0.0, 1.0);
 // Global normal distribution.
 MLPACK_EXPORT std::normal_distribution<> randNormalDist(0.0, 1.0);
+// Seed of the streams returned by ThreadStream().
+MLPACK_EXPORT size_t randStreamSeed = 0;
+// Number of calls to RandomSeed(), used to reset the streams of ThreadStream().
+MLPACK_EXPORT size_t randStreamEpoch = 0;
 
 } // namespace math
 } // namespace mlpack
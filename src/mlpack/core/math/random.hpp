@@ -15,6 +15,10 @@
 #include <mlpack/mlpack_export.hpp>
 #include <random>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace math /** Miscellaneous math routines. */ {
 
@@ -29,11 +33,16 @@ extern MLPACK_EXPORT std::mt19937 randGen;
 extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
 // Global normal distribution.
 extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
+// Seed of the streams returned by ThreadStream().
+extern MLPACK_EXPORT size_t randStreamSeed;
+// Number of calls to RandomSeed(), used to reset the streams of ThreadStream().
+extern MLPACK_EXPORT size_t randStreamEpoch;
 
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
  * The seed is casted to a 32-bit integer before being given to the random
  * number generator, but a size_t is taken as a parameter for API consistency.
+ * The streams returned by ThreadStream() are reset to use the full seed.
  *
  * @param seed Seed for the random number generator.
  */
@@ -41,6 +50,8 @@ inline void RandomSeed(const size_t seed)
 {
   randGen.seed((uint32_t) seed);
   srand((unsigned int) seed);
+  randStreamSeed = seed;
+  ++randStreamEpoch;
 #if ARMA_VERSION_MAJOR > 3 || \
     (ARMA_VERSION_MAJOR == 3 && ARMA_VERSION_MINOR >= 930)
   // Armadillo >= 3.930 has its own random number generator internally that we
@@ -102,6 +113,328 @@ inline double RandNormal(const double mean, const double variance)
   return variance * randNormalDist(randGen) + mean;
 }
 
+/**
+ * Draw a seed for a family of RandomStream objects from the global random
+ * number generator.  After RandomSeed() is called with the same seed, the same
+ * sequence of stream seeds is drawn, so results computed with the streams are
+ * reproducible.
+ */
+inline size_t RandomStreamSeed()
+{
+  const uint64_t hi = randGen();
+  const uint64_t lo = randGen();
+  return (size_t) ((hi << 32) | lo);
+}
+
+/**
+ * An independent stream of random numbers, identified by a seed and a stream
+ * index.  Unlike the global generator, a RandomStream can be used by one
+ * thread while other threads use other streams, so parallel code can give each
+ * thread or each task (for instance, each query point) its own stream.  The
+ * numbers drawn from a stream depend only on its seed and its index, so the
+ * results do not depend on the number of threads or on the order in which the
+ * streams are used.
+ *
+ * The stream is the counter-based Philox4x32-10 generator: the i'th block of
+ * four 32-bit numbers is a bijection of the counter (i, stream) keyed by the
+ * seed.  The state is therefore only a few words, and creating a stream is
+ * free.  For more information, see
+ *
+ * @code
+ * @inproceedings{salmon2011parallel,
+ *   title={Parallel random numbers: as easy as 1, 2, 3},
+ *   author={Salmon, J.K. and Moraes, M.A. and Dror, R.O. and Shaw, D.E.},
+ *   booktitle={Proceedings of the 2011 International Conference for High
+ *       Performance Computing, Networking, Storage and Analysis},
+ *   pages={16:1--16:12},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * RandomStream satisfies the requirements of a uniform random bit generator,
+ * so it can also be used with the distributions of the standard library.
+ */
+class RandomStream
+{
+ public:
+  //! The type of the generated numbers.
+  typedef uint32_t result_type;
+
+  /**
+   * Create the stream with the given index for the given seed.
+   *
+   * @param seed Seed of the family of streams (see RandomStreamSeed()).
+   * @param stream Index of the stream.
+   */
+  RandomStream(const size_t seed = 0, const size_t stream = 0) :
+      seed(seed),
+      stream(stream),
+      counter(0),
+      position(4),
+      hasNormal(false),
+      nextNormal(0.0)
+  {
+    // Nothing to do.
+  }
+
+  //! Get the smallest number that can be generated.
+  static constexpr result_type min() { return 0; }
+  //! Get the largest number that can be generated.
+  static constexpr result_type max() { return 0xFFFFFFFF; }
+
+  //! Generate a uniform random 32-bit number.
+  result_type operator()()
+  {
+    if (position == 4)
+    {
+      Block(counter++, buffer);
+      position = 0;
+    }
+
+    return buffer[position++];
+  }
+
+  //! Generate a uniform random number between 0 and 1, with 53 random bits.
+  double Random()
+  {
+    const uint32_t hi = (*this)();
+    const uint32_t lo = (*this)();
+    return ToDouble(hi, lo);
+  }
+
+  //! Generate a uniform random number in the specified range.
+  double Random(const double lo, const double hi)
+  {
+    return lo + (hi - lo) * Random();
+  }
+
+  //! Generate a uniform random integer.
+  int RandInt(const int hiExclusive)
+  {
+    return (int) std::floor((double) hiExclusive * Random());
+  }
+
+  //! Generate a uniform random integer.
+  int RandInt(const int lo, const int hiExclusive)
+  {
+    return lo + (int) std::floor((double) (hiExclusive - lo) * Random());
+  }
+
+  /**
+   * Generate a normally distributed random number with mean 0 and variance 1.
+   * The numbers are generated in pairs with the Box-Muller transform.
+   */
+  double RandNormal()
+  {
+    if (hasNormal)
+    {
+      hasNormal = false;
+      return nextNormal;
+    }
+
+    const double u1 = Random();
+    const double u2 = Random();
+    double z0, z1;
+    BoxMuller(u1, u2, z0, z1);
+    hasNormal = true;
+    nextNormal = z1;
+    return z0;
+  }
+
+  /**
+   * Generate a normally distributed random number with specified mean and
+   * variance, in the same way as math::RandNormal(mean, variance).
+   *
+   * @param mean Mean of distribution.
+   * @param variance Variance of distribution.
+   */
+  double RandNormal(const double mean, const double variance)
+  {
+    return variance * RandNormal() + mean;
+  }
+
+  /**
+   * Fill the given matrix, vector or cube with uniform random numbers between 0
+   * and 1.  Element i is computed from block i / 2 after the current position
+   * of the stream, so large objects are filled in parallel with OpenMP, and
+   * the result does not depend on the number of threads.  The stream is then
+   * advanced past the blocks that were used.
+   *
+   * @param x Object to fill; its size is kept.
+   */
+  template<typename ObjectType>
+  void Randu(ObjectType& x)
+  {
+    typedef typename ObjectType::elem_type ElemType;
+    ElemType* mem = x.memptr();
+    const size_t n = x.n_elem;
+    const size_t numBlocks = (n + 1) / 2;
+    const uint64_t first = counter;
+
+    // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+    // loop variables.
+    #pragma omp parallel for schedule(static) \
+        if (numBlocks >= minParallelBlocks)
+    for (intmax_t b = 0; b < (intmax_t) numBlocks; ++b)
+    {
+      uint32_t words[4];
+      Block(first + b, words);
+      mem[2 * b] = (ElemType) ToDouble(words[0], words[1]);
+      if (2 * (size_t) b + 1 < n)
+        mem[2 * b + 1] = (ElemType) ToDouble(words[2], words[3]);
+    }
+
+    Skip(numBlocks);
+  }
+
+  /**
+   * Fill the given matrix, vector or cube with normally distributed random
+   * numbers with mean 0 and variance 1.  As with Randu(), each pair of elements
+   * is computed from its own block, so large objects are filled in parallel
+   * and the result does not depend on the number of threads.
+   *
+   * @param x Object to fill; its size is kept.
+   */
+  template<typename ObjectType>
+  void Randn(ObjectType& x)
+  {
+    typedef typename ObjectType::elem_type ElemType;
+    ElemType* mem = x.memptr();
+    const size_t n = x.n_elem;
+    const size_t numBlocks = (n + 1) / 2;
+    const uint64_t first = counter;
+
+    // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+    // loop variables.
+    #pragma omp parallel for schedule(static) \
+        if (numBlocks >= minParallelBlocks)
+    for (intmax_t b = 0; b < (intmax_t) numBlocks; ++b)
+    {
+      uint32_t words[4];
+      Block(first + b, words);
+      double z0, z1;
+      BoxMuller(ToDouble(words[0], words[1]), ToDouble(words[2], words[3]), z0,
+          z1);
+      mem[2 * b] = (ElemType) z0;
+      if (2 * (size_t) b + 1 < n)
+        mem[2 * b + 1] = (ElemType) z1;
+    }
+
+    Skip(numBlocks);
+  }
+
+  //! Get the seed of the stream.
+  size_t Seed() const { return (size_t) seed; }
+  //! Get the index of the stream.
+  size_t Stream() const { return (size_t) stream; }
+
+ private:
+  //! Compute the block of numbers with the given index.
+  void Block(const uint64_t index, uint32_t* words) const
+  {
+    uint32_t c[4] = { (uint32_t) index, (uint32_t) (index >> 32),
+        (uint32_t) stream, (uint32_t) (stream >> 32) };
+    uint32_t k0 = (uint32_t) seed;
+    uint32_t k1 = (uint32_t) (seed >> 32);
+
+    for (size_t round = 0; round < 10; ++round)
+    {
+      if (round > 0)
+      {
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+      }
+
+      const uint64_t p0 = (uint64_t) 0xD2511F53 * c[0];
+      const uint64_t p1 = (uint64_t) 0xCD9E8D57 * c[2];
+      c[0] = ((uint32_t) (p1 >> 32)) ^ c[1] ^ k0;
+      c[1] = (uint32_t) p1;
+      c[2] = ((uint32_t) (p0 >> 32)) ^ c[3] ^ k1;
+      c[3] = (uint32_t) p0;
+    }
+
+    for (size_t i = 0; i < 4; ++i)
+      words[i] = c[i];
+  }
+
+  //! Start the next draw at a new block, after skipping the given number of
+  //! blocks.
+  void Skip(const size_t numBlocks)
+  {
+    counter += numBlocks;
+    position = 4;
+    hasNormal = false;
+  }
+
+  //! Convert two 32-bit numbers to a uniform number in [0, 1).
+  static double ToDouble(const uint32_t hi, const uint32_t lo)
+  {
+    return ((hi >> 5) * 67108864.0 + (lo >> 6)) * (1.0 / 9007199254740992.0);
+  }
+
+  //! Transform two uniform numbers in [0, 1) to two independent standard
+  //! normal numbers.
+  static void BoxMuller(const double u1, const double u2, double& z0,
+                        double& z1)
+  {
+    // 1 - u1 is in (0, 1], so the logarithm is finite.
+    const double r = std::sqrt(-2.0 * std::log(1.0 - u1));
+    const double theta = 2.0 * M_PI * u2;
+    z0 = r * std::cos(theta);
+    z1 = r * std::sin(theta);
+  }
+
+  //! The smallest number of blocks that is filled in parallel.
+  static const size_t minParallelBlocks = 8192;
+
+  //! The seed (the key of the generator).
+  uint64_t seed;
+  //! The index of the stream (the upper half of the counter).
+  uint64_t stream;
+  //! The index of the next block (the lower half of the counter).
+  uint64_t counter;
+  //! The current block of numbers.
+  uint32_t buffer[4];
+  //! The position of the next number in the buffer.
+  size_t position;
+  //! Whether the second number of the last Box-Muller pair is unused.
+  bool hasNormal;
+  //! The second number of the last Box-Muller pair.
+  double nextNormal;
+};
+
+/**
+ * Get the random stream of the calling thread.  When a thread first calls this
+ * function, and after every call to RandomSeed(), its stream is reset to the
+ * stream whose seed is the one given to RandomSeed() and whose index is the
+ * OpenMP thread number of the thread.  So, within a parallel region, each
+ * thread draws from its own stream without locking, and a computation that
+ * divides its work between threads in a fixed way (for instance, with static
+ * scheduling) is reproducible for a given number of threads.
+ *
+ * When the results must not depend on the number of threads, or when parallel
+ * regions are nested, create one RandomStream per task instead, with a seed
+ * from RandomStreamSeed() and the index of the task as the stream index.
+ */
+inline RandomStream& ThreadStream()
+{
+  static thread_local RandomStream stream;
+  static thread_local size_t epoch = 0;
+
+  if (epoch != randStreamEpoch + 1)
+  {
+#ifdef HAS_OPENMP
+    const size_t thread = (size_t) omp_get_thread_num();
+#else
+    const size_t thread = 0;
+#endif
+    stream = RandomStream(randStreamSeed, thread);
+    epoch = randStreamEpoch + 1;
+  }
+
+  return stream;
+}
+
 /**
  * Obtains no more than maxNumSamples distinct samples. Each sample belongs to
  * [loInclusive, hiExclusive).
@@ -140,6 +473,47 @@ inline void ObtainDistinctSamples(const size_t loInclusive,
   }
 }
 
+/**
+ * Obtains no more than maxNumSamples distinct samples, drawn from the given
+ * stream instead of the global random number generator.  Each sample belongs
+ * to [loInclusive, hiExclusive).
+ *
+ * @param loInclusive The lower bound (inclusive).
+ * @param hiExclusive The high bound (exclusive).
+ * @param maxNumSamples The maximum number of samples to obtain.
+ * @param distinctSamples The samples that will be obtained.
+ * @param rng The stream to draw the samples from.
+ */
+inline void ObtainDistinctSamples(const size_t loInclusive,
+                                  const size_t hiExclusive,
+                                  const size_t maxNumSamples,
+                                  arma::uvec& distinctSamples,
+                                  RandomStream& rng)
+{
+  const size_t samplesRangeSize = hiExclusive - loInclusive;
+
+  if (samplesRangeSize > maxNumSamples)
+  {
+    arma::Col<size_t> samples;
+
+    samples.zeros(samplesRangeSize);
+
+    for (size_t i = 0; i < maxNumSamples; i++)
+      samples[(size_t) rng.RandInt(samplesRangeSize)]++;
+
+    distinctSamples = arma::find(samples > 0);
+
+    if (loInclusive > 0)
+      distinctSamples += loInclusive;
+  }
+  else
+  {
+    distinctSamples.set_size(samplesRangeSize);
+    for (size_t i = 0; i < samplesRangeSize; i++)
+      distinctSamples[i] = loInclusive + i;
+  }
+}
+
 } // namespace math
 } // namespace mlpack
 
@@ -60,8 +60,12 @@ namespace optimization {
  *
  * @tparam DecomposableFunctionType Decomposable objective function type to be
  *         minimized.
+ * @tparam ObjectivePolicyType Policy that decides how the objective used for
+ *     the convergence test is tracked (see
+ *     mlpack::optimization::ExactObjective).
  */
-template<typename DecomposableFunctionType>
+template<typename DecomposableFunctionType,
+         typename ObjectivePolicyType = ExactObjective>
 class AdaDelta
 {
  public:
@@ -83,6 +87,7 @@ class AdaDelta
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
    * @param shuffle If true, the function order is shuffled; otherwise, each
    *        function is visited in linear order.
+   * @param objectivePolicy Instantiated policy used to track the objective.
    */
   AdaDelta(DecomposableFunctionType& function,
            const double stepSize = 1.0,
@@ -90,7 +95,8 @@ class AdaDelta
            const double epsilon = 1e-6,
            const size_t maxIterations = 100000,
            const double tolerance = 1e-5,
-           const bool shuffle = true);
+           const bool shuffle = true,
+           const ObjectivePolicyType& objectivePolicy = ObjectivePolicyType());
 
   /**
    * Optimize the given function using AdaDelta. The given starting point will
@@ -143,9 +149,17 @@ class AdaDelta
   //! Modify whether or not the individual functions are shuffled.
   bool& Shuffle() { return optimizer.Shuffle(); }
 
+  //! Get the objective policy.
+  const ObjectivePolicyType& ObjectivePolicy() const
+  {
+    return optimizer.ObjectivePolicy();
+  }
+  //! Modify the objective policy.
+  ObjectivePolicyType& ObjectivePolicy() { return optimizer.ObjectivePolicy(); }
+
  private:
   //! The Stochastic Gradient Descent object with AdaDelta policy.
-  SGD<DecomposableFunctionType, AdaDeltaUpdate> optimizer;
+  SGD<DecomposableFunctionType, AdaDeltaUpdate, ObjectivePolicyType> optimizer;
 };
 
 } // namespace optimization
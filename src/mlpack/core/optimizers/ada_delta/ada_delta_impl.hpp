@@ -19,20 +19,23 @@
 namespace mlpack {
 namespace optimization {
 
-template<typename DecomposableFunctionType>
-AdaDelta<DecomposableFunctionType>::AdaDelta(DecomposableFunctionType& function,
-                                             const double stepSize,
-                                             const double rho,
-                                             const double epsilon,
-                                             const size_t maxIterations,
-                                             const double tolerance,
-                                             const bool shuffle) :
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+AdaDelta<DecomposableFunctionType, ObjectivePolicyType>::AdaDelta(
+    DecomposableFunctionType& function,
+    const double stepSize,
+    const double rho,
+    const double epsilon,
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const ObjectivePolicyType& objectivePolicy) :
     optimizer(function,
               stepSize,
               maxIterations,
               tolerance,
               shuffle,
-              AdaDeltaUpdate(rho, epsilon))
+              AdaDeltaUpdate(rho, epsilon),
+              objectivePolicy)
 { /* Nothing to do. */ }
 
 } // namespace optimization
@@ -59,8 +59,12 @@ namespace optimization {
  *
  * @tparam DecomposableFunctionType Decomposable objective function type to be
  *         minimized.
+ * @tparam ObjectivePolicyType Policy that decides how the objective used for
+ *     the convergence test is tracked (see
+ *     mlpack::optimization::ExactObjective).
  */
-template<typename DecomposableFunctionType>
+template<typename DecomposableFunctionType,
+         typename ObjectivePolicyType = ExactObjective>
 class AdaGrad
 {
  public:
@@ -80,13 +84,15 @@ class AdaGrad
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
    * @param shuffle If true, the function order is shuffled; otherwise, each
    *        function is visited in linear order.
+   * @param objectivePolicy Instantiated policy used to track the objective.
    */
   AdaGrad(DecomposableFunctionType& function,
           const double stepSize = 0.01,
           const double epsilon = 1e-8,
           const size_t maxIterations = 100000,
           const double tolerance = 1e-5,
-          const bool shuffle = true);
+          const bool shuffle = true,
+          const ObjectivePolicyType& objectivePolicy = ObjectivePolicyType());
 
   /**
    * Optimize the given function using AdaGrad. The given starting point will
@@ -135,9 +141,17 @@ class AdaGrad
   //! Modify whether or not the individual functions are shuffled.
   bool& Shuffle() { return optimizer.Shuffle(); }
 
+  //! Get the objective policy.
+  const ObjectivePolicyType& ObjectivePolicy() const
+  {
+    return optimizer.ObjectivePolicy();
+  }
+  //! Modify the objective policy.
+  ObjectivePolicyType& ObjectivePolicy() { return optimizer.ObjectivePolicy(); }
+
  private:
   //! The Stochastic Gradient Descent object with AdaGrad policy.
-  SGD<DecomposableFunctionType, AdaGradUpdate> optimizer;
+  SGD<DecomposableFunctionType, AdaGradUpdate, ObjectivePolicyType> optimizer;
 };
 
 } // namespace optimization
@@ -18,19 +18,22 @@
 namespace mlpack {
 namespace optimization {
 
-template<typename DecomposableFunctionType>
-AdaGrad<DecomposableFunctionType>::AdaGrad(DecomposableFunctionType& function,
-                                           const double stepSize,
-                                           const double epsilon,
-                                           const size_t maxIterations,
-                                           const double tolerance,
-                                           const bool shuffle) :
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+AdaGrad<DecomposableFunctionType, ObjectivePolicyType>::AdaGrad(
+    DecomposableFunctionType& function,
+    const double stepSize,
+    const double epsilon,
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const ObjectivePolicyType& objectivePolicy) :
     optimizer(function,
               stepSize,
               maxIterations,
               tolerance,
               shuffle,
-              AdaGradUpdate(epsilon))
+              AdaGradUpdate(epsilon),
+              objectivePolicy)
 { /* Nothing to do. */ }
 
 } // namespace optimization
@@ -19,6 +19,10 @@
 #define MLPACK_CORE_OPTIMIZERS_ADAM_ADAM_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/objective_policies/exact_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/moving_average_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/sampled_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/no_objective.hpp>
 
 namespace mlpack {
 namespace optimization {
@@ -60,8 +64,12 @@ namespace optimization {
  *
  * @tparam DecomposableFunctionType Decomposable objective function type to be
  *     minimized.
+ * @tparam ObjectivePolicyType Policy that decides how the objective used for
+ *     the convergence test is tracked (see
+ *     mlpack::optimization::ExactObjective).
  */
-template<typename DecomposableFunctionType>
+template<typename DecomposableFunctionType,
+         typename ObjectivePolicyType = ExactObjective>
 class Adam
 {
  public:
@@ -86,6 +94,7 @@ class Adam
    *        function is visited in linear order.
    * @param adaMax If true, then the AdaMax optimizer is used; otherwise, by
    *        default the Adam optimizer is used.
+   * @param objectivePolicy Instantiated policy used to track the objective.
    */
   Adam(DecomposableFunctionType& function,
       const double stepSize = 0.001,
@@ -95,7 +104,8 @@ class Adam
       const size_t maxIterations = 100000,
       const double tolerance = 1e-5,
       const bool shuffle = true,
-      const bool adaMax = false);
+      const bool adaMax = false,
+      const ObjectivePolicyType& objectivePolicy = ObjectivePolicyType());
 
   /**
    * Optimize the given function using Adam. The given starting point will be
@@ -152,6 +162,11 @@ class Adam
   //! Modify wehther or not the AdaMax optimizer is to be used.
   bool& AdaMax() { return adaMax; }
 
+  //! Get the objective policy.
+  const ObjectivePolicyType& ObjectivePolicy() const { return objectivePolicy; }
+  //! Modify the objective policy.
+  ObjectivePolicyType& ObjectivePolicy() { return objectivePolicy; }
+
  private:
   //! The instantiated function.
   DecomposableFunctionType& function;
@@ -180,6 +195,9 @@ class Adam
 
   //! Specifies whether or not the AdaMax optimizer is to be used.
   bool adaMax;
+
+  //! The policy used to track the objective.
+  ObjectivePolicyType objectivePolicy;
 };
 
 } // namespace optimization
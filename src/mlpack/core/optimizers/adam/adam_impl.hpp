@@ -21,16 +21,18 @@
 namespace mlpack {
 namespace optimization {
 
-template<typename DecomposableFunctionType>
-Adam<DecomposableFunctionType>::Adam(DecomposableFunctionType& function,
-                                     const double stepSize,
-                                     const double beta1,
-                                     const double beta2,
-                                     const double eps,
-                                     const size_t maxIterations,
-                                     const double tolerance,
-                                     const bool shuffle,
-                                     const bool adaMax) :
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+Adam<DecomposableFunctionType, ObjectivePolicyType>::Adam(
+    DecomposableFunctionType& function,
+    const double stepSize,
+    const double beta1,
+    const double beta2,
+    const double eps,
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const bool adaMax,
+    const ObjectivePolicyType& objectivePolicy) :
     function(function),
     stepSize(stepSize),
     beta1(beta1),
@@ -39,12 +41,14 @@ Adam<DecomposableFunctionType>::Adam(DecomposableFunctionType& function,
     maxIterations(maxIterations),
     tolerance(tolerance),
     shuffle(shuffle),
-    adaMax(adaMax)
+    adaMax(adaMax),
+    objectivePolicy(objectivePolicy)
 { /* Nothing to do. */ }
 
 //! Optimize the function (minimize).
-template<typename DecomposableFunctionType>
-double Adam<DecomposableFunctionType>::Optimize(arma::mat& iterate)
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+double Adam<DecomposableFunctionType, ObjectivePolicyType>::Optimize(
+    arma::mat& iterate)
 {
   // Find the number of functions to use.
   const size_t numFunctions = function.NumFunctions();
@@ -60,9 +64,8 @@ double Adam<DecomposableFunctionType>::Optimize(arma::mat& iterate)
   double overallObjective = 0;
   double lastObjective = DBL_MAX;
 
-  // Calculate the first objective function.
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
+  // Initialize the objective policy.
+  objectivePolicy.Initialize(function, iterate, 1);
 
   // Now iterate!
   arma::mat gradient(iterate.n_rows, iterate.n_cols);
@@ -90,28 +93,32 @@ double Adam<DecomposableFunctionType>::Optimize(arma::mat& iterate)
     // Is this iteration the start of a sequence?
     if ((currentFunction % numFunctions) == 0)
     {
-      // Output current objective function.
-      Log::Info << "Adam: iteration " << i << ", objective " << overallObjective
-          << "." << std::endl;
-
-      if (std::isnan(overallObjective) || std::isinf(overallObjective))
-      {
-        Log::Warn << "Adam: converged to " << overallObjective
-            << "; terminating with failure. Try a smaller step size?"
-            << std::endl;
-        return overallObjective;
-      }
-
-      if (std::abs(lastObjective - overallObjective) < tolerance)
+      // The objective policy may not have an objective for every sequence.
+      if (objectivePolicy.EpochObjective(function, iterate, overallObjective))
       {
-        Log::Info << "Adam: minimized within tolerance " << tolerance << "; "
-            << "terminating optimization." << std::endl;
-        return overallObjective;
+        // Output current objective function.
+        Log::Info << "Adam: iteration " << i << ", objective "
+            << overallObjective << "." << std::endl;
+
+        if (std::isnan(overallObjective) || std::isinf(overallObjective))
+        {
+          Log::Warn << "Adam: converged to " << overallObjective
+              << "; terminating with failure. Try a smaller step size?"
+              << std::endl;
+          return overallObjective;
+        }
+
+        if (std::abs(lastObjective - overallObjective) < tolerance)
+        {
+          Log::Info << "Adam: minimized within tolerance " << tolerance << "; "
+              << "terminating optimization." << std::endl;
+          return overallObjective;
+        }
+
+        lastObjective = overallObjective;
       }
 
       // Reset the counter variables.
-      lastObjective = overallObjective;
-      overallObjective = 0;
       currentFunction = 0;
 
       if (shuffle) // Determine order of visitation.
@@ -119,10 +126,9 @@ double Adam<DecomposableFunctionType>::Optimize(arma::mat& iterate)
     }
 
     // Evaluate the gradient for this iteration.
-    if (shuffle)
-      function.Gradient(iterate, visitationOrder[currentFunction], gradient);
-    else
-      function.Gradient(iterate, currentFunction, gradient);
+    const size_t index = shuffle ? visitationOrder[currentFunction] :
+        currentFunction;
+    function.Gradient(iterate, index, gradient);
 
     // And update the iterate.
     m *= beta1;
@@ -159,12 +165,8 @@ double Adam<DecomposableFunctionType>::Optimize(arma::mat& iterate)
                   m / (arma::sqrt(v) + eps);
     }
 
-    // Now add that to the overall objective function.
-    if (shuffle)
-      overallObjective += function.Evaluate(iterate,
-          visitationOrder[currentFunction]);
-    else
-      overallObjective += function.Evaluate(iterate, currentFunction);
+    // Let the objective policy track the objective of the new point.
+    objectivePolicy.Update(function, iterate, index, 1);
   }
 
   Log::Info << "Adam: maximum iterations (" << maxIterations << ") reached; "
@@ -0,0 +1,136 @@
+/**
+ * @file batch_function_traits.hpp
+ *
+ * Detection of the optional batch Evaluate() and Gradient() overloads of a
+ * decomposable function, and helpers that use them when they are available
+ * and fall back to the per-point overloads otherwise.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_MINIBATCH_SGD_BATCH_FUNCTION_TRAITS_HPP
+#define MLPACK_CORE_OPTIMIZERS_MINIBATCH_SGD_BATCH_FUNCTION_TRAITS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+HAS_MEM_FUNC(Evaluate, HasBatchEvaluateCheck);
+HAS_MEM_FUNC(Gradient, HasBatchGradientCheck);
+
+/**
+ * 'value' is true if the DecomposableFunctionType class has the members
+ *
+ *   double Evaluate(const arma::mat& coordinates,
+ *                   const size_t begin,
+ *                   const size_t batchSize);
+ *   void Gradient(const arma::mat& coordinates,
+ *                 const size_t begin,
+ *                 const size_t batchSize,
+ *                 arma::mat& gradient);
+ *
+ * (either of which may be const), which evaluate the sum of the objective and
+ * of the gradient over the functions begin, ..., begin + batchSize - 1.
+ */
+template<typename DecomposableFunctionType>
+struct HasBatchFunctions
+{
+  static const bool value =
+    (HasBatchEvaluateCheck<DecomposableFunctionType,
+        double(DecomposableFunctionType::*)(const arma::mat&,
+                                            const size_t,
+                                            const size_t) const>::value ||
+     HasBatchEvaluateCheck<DecomposableFunctionType,
+        double(DecomposableFunctionType::*)(const arma::mat&,
+                                            const size_t,
+                                            const size_t)>::value) &&
+    (HasBatchGradientCheck<DecomposableFunctionType,
+        void(DecomposableFunctionType::*)(const arma::mat&,
+                                          const size_t,
+                                          const size_t,
+                                          arma::mat&) const>::value ||
+     HasBatchGradientCheck<DecomposableFunctionType,
+        void(DecomposableFunctionType::*)(const arma::mat&,
+                                          const size_t,
+                                          const size_t,
+                                          arma::mat&)>::value);
+};
+
+//! Evaluate the sum of the objective over the given batch, using the batch
+//! overload of the function.
+template<typename DecomposableFunctionType>
+double BatchEvaluate(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    const size_t batchSize,
+    const typename std::enable_if<
+        HasBatchFunctions<DecomposableFunctionType>::value>::type* = 0)
+{
+  return function.Evaluate(coordinates, begin, batchSize);
+}
+
+//! Evaluate the sum of the objective over the given batch one function at a
+//! time.
+template<typename DecomposableFunctionType>
+double BatchEvaluate(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    const size_t batchSize,
+    const typename std::enable_if<
+        !HasBatchFunctions<DecomposableFunctionType>::value>::type* = 0)
+{
+  double objective = 0;
+  for (size_t j = begin; j < begin + batchSize; ++j)
+    objective += function.Evaluate(coordinates, j);
+
+  return objective;
+}
+
+//! Evaluate the sum of the gradient over the given batch, using the batch
+//! overload of the function.  The scratch matrix is not used.
+template<typename DecomposableFunctionType>
+void BatchGradient(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    const size_t batchSize,
+    arma::mat& gradient,
+    arma::mat& /* scratch */,
+    const typename std::enable_if<
+        HasBatchFunctions<DecomposableFunctionType>::value>::type* = 0)
+{
+  function.Gradient(coordinates, begin, batchSize, gradient);
+}
+
+//! Evaluate the sum of the gradient over the given batch one function at a
+//! time.  The per-function gradients are stored in the scratch matrix, so it
+//! is only allocated once if it is reused between calls.
+template<typename DecomposableFunctionType>
+void BatchGradient(
+    DecomposableFunctionType& function,
+    const arma::mat& coordinates,
+    const size_t begin,
+    const size_t batchSize,
+    arma::mat& gradient,
+    arma::mat& scratch,
+    const typename std::enable_if<
+        !HasBatchFunctions<DecomposableFunctionType>::value>::type* = 0)
+{
+  function.Gradient(coordinates, begin, gradient);
+  for (size_t j = begin + 1; j < begin + batchSize; ++j)
+  {
+    function.Gradient(coordinates, j, scratch);
+    gradient += scratch;
+  }
+}
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,12 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "batch_function_traits.hpp"
+#include <mlpack/core/optimizers/objective_policies/exact_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/moving_average_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/sampled_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/no_objective.hpp>
+
 namespace mlpack {
 namespace optimization {
 
@@ -67,10 +73,31 @@ namespace optimization {
  * function on the first point in the dataset (presumably, the dataset is held
  * internally in the DecomposableFunctionType).
  *
+ * Optionally, the DecomposableFunctionType may also implement
+ *
+ *   double Evaluate(const arma::mat& coordinates,
+ *                   const size_t begin,
+ *                   const size_t batchSize);
+ *   void Gradient(const arma::mat& coordinates,
+ *                 const size_t begin,
+ *                 const size_t batchSize,
+ *                 arma::mat& gradient);
+ *
+ * which return the sum of the objective (or gradient) over the functions
+ * begin, ..., begin + batchSize - 1.  If both are available (this is detected
+ * at compile time, see HasBatchFunctions), each mini-batch is processed with
+ * one call to each of them, which allows the function to use matrix operations
+ * over the whole batch.  Otherwise the per-point functions are called for each
+ * point of the batch.
+ *
  * @tparam DecomposableFunctionType Decomposable objective function type to be
  *     minimized.
+ * @tparam ObjectivePolicyType Policy that decides how the objective used for
+ *     the convergence test is tracked (see
+ *     mlpack::optimization::ExactObjective).
  */
-template<typename DecomposableFunctionType>
+template<typename DecomposableFunctionType,
+         typename ObjectivePolicyType = ExactObjective>
 class MiniBatchSGD
 {
  public:
@@ -89,13 +116,16 @@ class MiniBatchSGD
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
    * @param shuffle If true, the mini-batch order is shuffled; otherwise, each
    *     mini-batch is visited in linear order.
+   * @param objectivePolicy Instantiated policy used to track the objective.
    */
   MiniBatchSGD(DecomposableFunctionType& function,
                const size_t batchSize = 1000,
                const double stepSize = 0.01,
                const size_t maxIterations = 100000,
                const double tolerance = 1e-5,
-               const bool shuffle = true);
+               const bool shuffle = true,
+               const ObjectivePolicyType& objectivePolicy =
+                   ObjectivePolicyType());
 
   /**
    * Optimize the given function using mini-batch SGD.  The given starting point
@@ -137,6 +167,11 @@ class MiniBatchSGD
   //! Modify whether or not the individual functions are shuffled.
   bool& Shuffle() { return shuffle; }
 
+  //! Get the objective policy.
+  const ObjectivePolicyType& ObjectivePolicy() const { return objectivePolicy; }
+  //! Modify the objective policy.
+  ObjectivePolicyType& ObjectivePolicy() { return objectivePolicy; }
+
  private:
   //! The instantiated function.
   DecomposableFunctionType& function;
@@ -156,6 +191,9 @@ class MiniBatchSGD
   //! Controls whether or not the individual functions are shuffled when
   //! iterating.
   bool shuffle;
+
+  //! The policy used to track the objective.
+  ObjectivePolicyType objectivePolicy;
 };
 
 } // namespace optimization
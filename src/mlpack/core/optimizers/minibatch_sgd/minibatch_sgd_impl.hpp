@@ -18,25 +18,28 @@
 namespace mlpack {
 namespace optimization {
 
-template<typename DecomposableFunctionType>
-MiniBatchSGD<DecomposableFunctionType>::MiniBatchSGD(
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+MiniBatchSGD<DecomposableFunctionType, ObjectivePolicyType>::MiniBatchSGD(
     DecomposableFunctionType& function,
     const size_t batchSize,
     const double stepSize,
     const size_t maxIterations,
     const double tolerance,
-    const bool shuffle) :
+    const bool shuffle,
+    const ObjectivePolicyType& objectivePolicy) :
     function(function),
     batchSize(batchSize),
     stepSize(stepSize),
     maxIterations(maxIterations),
     tolerance(tolerance),
-    shuffle(shuffle)
+    shuffle(shuffle),
+    objectivePolicy(objectivePolicy)
 { /* Nothing to do. */ }
 
 //! Optimize the function (minimize).
-template<typename DecomposableFunctionType>
-double MiniBatchSGD<DecomposableFunctionType>::Optimize(arma::mat& iterate)
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+double MiniBatchSGD<DecomposableFunctionType, ObjectivePolicyType>::Optimize(
+    arma::mat& iterate)
 {
   // Find the number of functions.
   const size_t numFunctions = function.NumFunctions();
@@ -44,104 +47,74 @@ double MiniBatchSGD<DecomposableFunctionType>::Optimize(arma::mat& iterate)
   if (numFunctions % batchSize != 0)
     ++numBatches; // Capture last few.
 
-  // This is only used if shuffle is true.
-  arma::Col<size_t> visitationOrder;
+  // The order in which the batches are visited.
+  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
+      (numBatches - 1), numBatches);
   if (shuffle)
-    visitationOrder = arma::shuffle(arma::linspace<arma::Col<size_t>>(0,
-        (numBatches - 1), numBatches));
+    visitationOrder = arma::shuffle(visitationOrder);
 
   // To keep track of where we are and how things are going.
   size_t currentBatch = 0;
   double overallObjective = 0;
   double lastObjective = DBL_MAX;
 
-  // Calculate the first objective function.
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
+  // Initialize the objective policy.
+  objectivePolicy.Initialize(function, iterate, batchSize);
 
-  // Now iterate!
+  // Now iterate!  The scratch matrix is only used by functions that do not
+  // provide batch overloads.
   arma::mat gradient(iterate.n_rows, iterate.n_cols);
+  arma::mat scratch;
   for (size_t i = 1; i != maxIterations; ++i, ++currentBatch)
   {
     // Is this iteration the start of a sequence?
     if ((currentBatch % numBatches) == 0)
     {
-      // Output current objective function.
-      Log::Info << "Mini-batch SGD: iteration " << i << ", objective "
-          << overallObjective << "." << std::endl;
-
-      if (std::isnan(overallObjective) || std::isinf(overallObjective))
+      // The objective policy may not have an objective for every sequence.
+      if (objectivePolicy.EpochObjective(function, iterate, overallObjective))
       {
-        Log::Warn << "Mini-batch SGD: converged to " << overallObjective
-            << "; terminating with failure.  Try a smaller step size?"
-            << std::endl;
-        return overallObjective;
-      }
-
-      if (std::abs(lastObjective - overallObjective) < tolerance)
-      {
-        Log::Info << "Mini-batch SGD: minimized within tolerance " << tolerance
-            << "; terminating optimization." << std::endl;
-        return overallObjective;
+        // Output current objective function.
+        Log::Info << "Mini-batch SGD: iteration " << i << ", objective "
+            << overallObjective << "." << std::endl;
+
+        if (std::isnan(overallObjective) || std::isinf(overallObjective))
+        {
+          Log::Warn << "Mini-batch SGD: converged to " << overallObjective
+              << "; terminating with failure.  Try a smaller step size?"
+              << std::endl;
+          return overallObjective;
+        }
+
+        if (std::abs(lastObjective - overallObjective) < tolerance)
+        {
+          Log::Info << "Mini-batch SGD: minimized within tolerance "
+              << tolerance << "; terminating optimization." << std::endl;
+          return overallObjective;
+        }
+
+        lastObjective = overallObjective;
       }
 
       // Reset the counter variables.
-      lastObjective = overallObjective;
-      overallObjective = 0;
       currentBatch = 0;
 
       if (shuffle)
         visitationOrder = arma::shuffle(visitationOrder);
     }
 
-    // Evaluate the gradient for this mini-batch.
-    const size_t offset = (shuffle) ? batchSize * visitationOrder[currentBatch]
-        : batchSize * currentBatch;
-    function.Gradient(iterate, offset, gradient);
-    if (visitationOrder[currentBatch] != numBatches - 1)
-    {
-      for (size_t j = 1; j < batchSize; ++j)
-      {
-        arma::mat funcGradient;
-        function.Gradient(iterate, offset + j, funcGradient);
-        gradient += funcGradient;
-      }
-
-      // Now update the iterate.
-      iterate -= (stepSize / batchSize) * gradient;
-
-      // Add that to the overall objective function.
-      for (size_t j = 0; j < batchSize; ++j)
-        overallObjective += function.Evaluate(iterate, offset + j);
-    }
-    else
-    {
-      // Handle last batch differently: it's not a full-size batch.
-      const size_t lastBatchSize = numFunctions - offset - 1;
-      for (size_t j = 1; j < lastBatchSize; ++j)
-      {
-        arma::mat funcGradient;
-        function.Gradient(iterate, offset + j, funcGradient);
-        gradient += funcGradient;
-      }
+    // Evaluate the gradient for this mini-batch.  The last batch may not be a
+    // full-size batch.
+    const size_t offset = batchSize * visitationOrder[currentBatch];
+    const size_t effectiveBatchSize = std::min(batchSize,
+        numFunctions - offset);
+    BatchGradient(function, iterate, offset, effectiveBatchSize, gradient,
+        scratch);
 
-      // Ensure the last batch size isn't zero, to avoid division by zero before
-      // updating.
-      if (lastBatchSize > 0)
-      {
-        // Now update the iterate.
-        iterate -= (stepSize / lastBatchSize) * gradient;
-      }
-      else
-      {
-        // Now update the iterate.
-        iterate -= stepSize * gradient;
-      }
+    // Now update the iterate.
+    iterate -= (stepSize / effectiveBatchSize) * gradient;
 
-      // Add that to the overall objective function.
-      for (size_t j = 0; j < lastBatchSize; ++j)
-        overallObjective += function.Evaluate(iterate, offset + j);
-    }
+    // Let the objective policy track the objective of the new point.
+    objectivePolicy.Update(function, iterate, offset, effectiveBatchSize);
   }
 
   Log::Info << "Mini-batch SGD: maximum iterations (" << maxIterations << ") "
@@ -149,8 +122,9 @@ double MiniBatchSGD<DecomposableFunctionType>::Optimize(arma::mat& iterate)
 
   // Calculate final objective.
   overallObjective = 0;
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
+  for (size_t offset = 0; offset < numFunctions; offset += batchSize)
+    overallObjective += BatchEvaluate(function, iterate, offset,
+        std::min(batchSize, numFunctions - offset));
 
   return overallObjective;
 }
@@ -0,0 +1,130 @@
+/**
+ * @file exact_objective.hpp
+ *
+ * Objective tracking policy that sums the objective of every function after it
+ * has been used for an update.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_EXACT_OBJECTIVE_HPP
+#define MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_EXACT_OBJECTIVE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/minibatch_sgd/batch_function_traits.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+/**
+ * Objective tracking policy for the stochastic optimizers (SGD, MiniBatchSGD,
+ * Adam, RMSProp, AdaDelta, AdaGrad and SMORMS3).  An objective policy decides
+ * what objective value the optimizer uses to report progress and to test for
+ * convergence at the end of each pass over the data.  It must implement the
+ * following functions:
+ *
+ *   // Called once before the first update; batchSize is the number of
+ *   // functions the optimizer uses for each update.
+ *   template<typename DecomposableFunctionType>
+ *   void Initialize(DecomposableFunctionType& function,
+ *                   const arma::mat& iterate,
+ *                   const size_t batchSize);
+ *
+ *   // Called after the iterate has been updated using the gradient of the
+ *   // functions begin, ..., begin + batchSize - 1.
+ *   template<typename DecomposableFunctionType>
+ *   void Update(DecomposableFunctionType& function,
+ *               const arma::mat& iterate,
+ *               const size_t begin,
+ *               const size_t batchSize);
+ *
+ *   // Called at the start of each pass over the data; returns false if there
+ *   // is no objective value to report and test for convergence.
+ *   template<typename DecomposableFunctionType>
+ *   bool EpochObjective(DecomposableFunctionType& function,
+ *                       const arma::mat& iterate,
+ *                       double& objective);
+ *
+ * ExactObjective is the default policy.  It evaluates the objective of every
+ * function right after the update that used it, and reports the sum over the
+ * last pass.  This is the most accurate estimate, but it roughly doubles the
+ * cost of each pass; see MovingAverageObjective, SampledObjective and
+ * NoObjective for cheaper alternatives.
+ */
+class ExactObjective
+{
+ public:
+  //! Construct the exact objective policy.
+  ExactObjective() : objective(0) { }
+
+  /**
+   * Compute the objective of the starting point, which is reported at the
+   * start of the first pass.  The functions are evaluated in batches of the
+   * size the optimizer uses, so that functions with batch overloads (such as
+   * FFN) never evaluate the whole dataset at once.
+   *
+   * @param function Function being optimized.
+   * @param iterate Starting point.
+   * @param batchSize Number of functions the optimizer uses for each update.
+   */
+  template<typename DecomposableFunctionType>
+  void Initialize(DecomposableFunctionType& function,
+                  const arma::mat& iterate,
+                  const size_t batchSize)
+  {
+    const size_t numFunctions = function.NumFunctions();
+
+    objective = 0;
+    for (size_t begin = 0; begin < numFunctions; begin += batchSize)
+    {
+      objective += BatchEvaluate(function, iterate, begin,
+          std::min(batchSize, numFunctions - begin));
+    }
+  }
+
+  /**
+   * Add the objective of the functions that were just used for an update.
+   *
+   * @param function Function being optimized.
+   * @param iterate Updated parameters.
+   * @param begin Index of the first function in the batch.
+   * @param batchSize Number of functions in the batch.
+   */
+  template<typename DecomposableFunctionType>
+  void Update(DecomposableFunctionType& function,
+              const arma::mat& iterate,
+              const size_t begin,
+              const size_t batchSize)
+  {
+    objective += BatchEvaluate(function, iterate, begin, batchSize);
+  }
+
+  /**
+   * Report the objective summed over the last pass and reset the sum.
+   *
+   * @param function Function being optimized.
+   * @param iterate Current parameters.
+   * @param epochObjective Set to the objective of the last pass.
+   * @return Always true.
+   */
+  template<typename DecomposableFunctionType>
+  bool EpochObjective(DecomposableFunctionType& /* function */,
+                      const arma::mat& /* iterate */,
+                      double& epochObjective)
+  {
+    epochObjective = objective;
+    objective = 0;
+    return true;
+  }
+
+ private:
+  //! The objective summed over the current pass.
+  double objective;
+};
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
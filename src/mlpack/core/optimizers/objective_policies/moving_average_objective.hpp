@@ -0,0 +1,141 @@
+/**
+ * @file moving_average_objective.hpp
+ *
+ * Objective tracking policy that keeps an exponential moving average of the
+ * loss of the batches used for the updates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_MOVING_AVERAGE_OBJECTIVE_HPP
+#define MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_MOVING_AVERAGE_OBJECTIVE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/minibatch_sgd/batch_function_traits.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+/**
+ * Objective tracking policy that keeps an exponential moving average of the
+ * per-function loss of the batches used for the updates.  Only one out of
+ * every 'interval' batches is evaluated, so the overhead of tracking the
+ * objective is reduced by that factor.  The average is bias-corrected (as in
+ * Adam) and scaled by the number of functions, so the reported value is an
+ * estimate of the full objective.  Because it is an estimate, the tolerance
+ * should be chosen larger than with ExactObjective.  See ExactObjective for the
+ * interface of an objective policy.
+ */
+class MovingAverageObjective
+{
+ public:
+  /**
+   * Construct the moving average objective policy.
+   *
+   * @param decay Decay of the moving average, in [0, 1).
+   * @param interval Evaluate the loss of one out of every interval batches.
+   */
+  MovingAverageObjective(const double decay = 0.99,
+                         const size_t interval = 10) :
+      decay(decay),
+      interval(interval),
+      numFunctions(0),
+      average(0),
+      decayPower(1),
+      updates(0)
+  {
+    if (decay < 0.0 || decay >= 1.0)
+    {
+      Log::Fatal << "MovingAverageObjective: decay must be in [0, 1) (got "
+          << decay << ")." << std::endl;
+    }
+    if (interval == 0)
+    {
+      Log::Fatal << "MovingAverageObjective: interval must be positive."
+          << std::endl;
+    }
+  }
+
+  //! Reset the moving average.
+  template<typename DecomposableFunctionType>
+  void Initialize(DecomposableFunctionType& function,
+                  const arma::mat& /* iterate */,
+                  const size_t /* batchSize */)
+  {
+    numFunctions = function.NumFunctions();
+    average = 0;
+    decayPower = 1;
+    updates = 0;
+  }
+
+  /**
+   * Add the mean loss of the given batch to the moving average, if this batch
+   * is one of those that are evaluated.
+   *
+   * @param function Function being optimized.
+   * @param iterate Updated parameters.
+   * @param begin Index of the first function in the batch.
+   * @param batchSize Number of functions in the batch.
+   */
+  template<typename DecomposableFunctionType>
+  void Update(DecomposableFunctionType& function,
+              const arma::mat& iterate,
+              const size_t begin,
+              const size_t batchSize)
+  {
+    if ((updates++ % interval) != 0)
+      return;
+
+    const double loss = BatchEvaluate(function, iterate, begin, batchSize) /
+        batchSize;
+    average = decay * average + (1 - decay) * loss;
+    decayPower *= decay;
+  }
+
+  /**
+   * Report the current estimate of the objective.  Nothing is reported before
+   * the first batch has been evaluated.
+   */
+  template<typename DecomposableFunctionType>
+  bool EpochObjective(DecomposableFunctionType& /* function */,
+                      const arma::mat& /* iterate */,
+                      double& epochObjective)
+  {
+    if (updates == 0)
+      return false;
+
+    epochObjective = numFunctions * average / (1 - decayPower);
+    return true;
+  }
+
+  //! Get the decay of the moving average.
+  double Decay() const { return decay; }
+  //! Modify the decay of the moving average.
+  double& Decay() { return decay; }
+
+  //! Get the evaluation interval.
+  size_t Interval() const { return interval; }
+  //! Modify the evaluation interval.
+  size_t& Interval() { return interval; }
+
+ private:
+  //! The decay of the moving average.
+  double decay;
+  //! Only one out of every interval batches is evaluated.
+  size_t interval;
+  //! The number of functions, used to scale the per-function average.
+  size_t numFunctions;
+  //! The (biased) moving average of the per-function loss.
+  double average;
+  //! decay raised to the number of evaluated batches, for bias correction.
+  double decayPower;
+  //! The number of calls to Update().
+  size_t updates;
+};
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file no_objective.hpp
+ *
+ * Objective tracking policy that does not track the objective at all.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_NO_OBJECTIVE_HPP
+#define MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_NO_OBJECTIVE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+/**
+ * Objective tracking policy that never evaluates the objective while
+ * optimizing.  The tolerance is therefore never tested, and the optimizer only
+ * terminates when the maximum number of iterations is reached, so this policy
+ * should not be used with maxIterations = 0.  The objective of the final point
+ * is still computed once before Optimize() returns.  See ExactObjective for
+ * the interface of an objective policy.
+ */
+class NoObjective
+{
+ public:
+  //! Nothing to initialize.
+  template<typename DecomposableFunctionType>
+  void Initialize(DecomposableFunctionType& /* function */,
+                  const arma::mat& /* iterate */,
+                  const size_t /* batchSize */)
+  { /* Nothing to do. */ }
+
+  //! Nothing to track.
+  template<typename DecomposableFunctionType>
+  void Update(DecomposableFunctionType& /* function */,
+              const arma::mat& /* iterate */,
+              const size_t /* begin */,
+              const size_t /* batchSize */)
+  { /* Nothing to do. */ }
+
+  //! There is never an objective to report.
+  template<typename DecomposableFunctionType>
+  bool EpochObjective(DecomposableFunctionType& /* function */,
+                      const arma::mat& /* iterate */,
+                      double& /* epochObjective */)
+  {
+    return false;
+  }
+};
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
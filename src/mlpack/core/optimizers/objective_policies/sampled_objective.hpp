@@ -0,0 +1,134 @@
+/**
+ * @file sampled_objective.hpp
+ *
+ * Objective tracking policy that periodically evaluates the objective on a
+ * fixed sample of the functions.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_SAMPLED_OBJECTIVE_HPP
+#define MLPACK_CORE_OPTIMIZERS_OBJECTIVE_POLICIES_SAMPLED_OBJECTIVE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+/**
+ * Objective tracking policy that evaluates the objective every 'period' passes
+ * over the data, on a sample of the functions that is drawn once when the
+ * optimization starts.  Nothing is evaluated during the updates.  The sample
+ * objective is scaled by the number of functions, so the reported value is an
+ * estimate of the full objective; convergence is only tested on the passes
+ * where it is evaluated.  See ExactObjective for the interface of an objective
+ * policy.
+ */
+class SampledObjective
+{
+ public:
+  /**
+   * Construct the sampled objective policy.
+   *
+   * @param period Evaluate the objective every period passes over the data.
+   * @param sampleSize Number of functions in the sample (if larger than the
+   *     number of functions, every function is used).
+   */
+  SampledObjective(const size_t period = 1, const size_t sampleSize = 1000) :
+      period(period),
+      sampleSize(sampleSize),
+      numFunctions(0),
+      epoch(0)
+  {
+    if (period == 0 || sampleSize == 0)
+    {
+      Log::Fatal << "SampledObjective: period and sample size must be "
+          << "positive." << std::endl;
+    }
+  }
+
+  //! Draw the sample of functions that the objective is evaluated on.
+  template<typename DecomposableFunctionType>
+  void Initialize(DecomposableFunctionType& function,
+                  const arma::mat& /* iterate */,
+                  const size_t /* batchSize */)
+  {
+    numFunctions = function.NumFunctions();
+    epoch = 0;
+
+    if (sampleSize >= numFunctions)
+    {
+      sample = arma::linspace<arma::Col<size_t>>(0, numFunctions - 1,
+          numFunctions);
+    }
+    else
+    {
+      arma::Col<size_t> order = arma::shuffle(
+          arma::linspace<arma::Col<size_t>>(0, numFunctions - 1,
+          numFunctions));
+      sample = order.head(sampleSize);
+    }
+  }
+
+  //! Nothing is evaluated during the updates.
+  template<typename DecomposableFunctionType>
+  void Update(DecomposableFunctionType& /* function */,
+              const arma::mat& /* iterate */,
+              const size_t /* begin */,
+              const size_t /* batchSize */)
+  { /* Nothing to do. */ }
+
+  /**
+   * If this pass is one of those that are evaluated, estimate the objective on
+   * the sample.
+   *
+   * @param function Function being optimized.
+   * @param iterate Current parameters.
+   * @param epochObjective Set to the estimate of the objective.
+   * @return Whether the objective was evaluated.
+   */
+  template<typename DecomposableFunctionType>
+  bool EpochObjective(DecomposableFunctionType& function,
+                      const arma::mat& iterate,
+                      double& epochObjective)
+  {
+    if ((epoch++ % period) != 0)
+      return false;
+
+    epochObjective = 0;
+    for (size_t i = 0; i < sample.n_elem; ++i)
+      epochObjective += function.Evaluate(iterate, sample[i]);
+    epochObjective *= double(numFunctions) / sample.n_elem;
+
+    return true;
+  }
+
+  //! Get the evaluation period (in passes over the data).
+  size_t Period() const { return period; }
+  //! Modify the evaluation period (in passes over the data).
+  size_t& Period() { return period; }
+
+  //! Get the sample size.
+  size_t SampleSize() const { return sampleSize; }
+  //! Modify the sample size.
+  size_t& SampleSize() { return sampleSize; }
+
+ private:
+  //! The objective is evaluated every period passes.
+  size_t period;
+  //! The number of functions in the sample.
+  size_t sampleSize;
+  //! The number of functions, used to scale the sample objective.
+  size_t numFunctions;
+  //! The number of passes started so far.
+  size_t epoch;
+  //! The indices of the sampled functions.
+  arma::Col<size_t> sample;
+};
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * @file parallel_separable_function.hpp
+ *
+ * Wrapper that evaluates the objective and gradient of a separable function in
+ * parallel, for optimizers that use the full objective (L_BFGS,
+ * GradientDescent, AugLagrangian).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_PARALLEL_SEPARABLE_PARALLEL_SEPARABLE_FUNCTION_HPP
+#define MLPACK_CORE_OPTIMIZERS_PARALLEL_SEPARABLE_PARALLEL_SEPARABLE_FUNCTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/optimizers/minibatch_sgd/batch_function_traits.hpp>
+
+namespace mlpack {
+namespace optimization {
+
+/**
+ * ParallelSeparableFunction wraps a separable (decomposable) function, whose
+ * objective is the sum of the objectives of NumFunctions() functions (usually
+ * one per data point), and provides the full-objective interface
+ *
+ *   double Evaluate(const arma::mat& coordinates);
+ *   void Gradient(const arma::mat& coordinates, arma::mat& gradient);
+ *   const arma::mat& GetInitialPoint();
+ *
+ * used by L_BFGS, GradientDescent and AugLagrangian.  The functions are split
+ * into one contiguous block per OpenMP thread; each block is evaluated with
+ * the batch overloads of the wrapped function if it has them (see
+ * HasBatchFunctions), or one function at a time otherwise, and the results of
+ * the blocks are then summed in a fixed order, so for a given number of
+ * threads the result does not depend on scheduling.
+ *
+ * The wrapped FunctionType must implement
+ *
+ *   size_t NumFunctions();
+ *   double Evaluate(const arma::mat& coordinates, const size_t i);
+ *   void Gradient(const arma::mat& coordinates,
+ *                 const size_t i,
+ *                 arma::mat& gradient);
+ *   const arma::mat& GetInitialPoint();
+ *
+ * and these (or the batch overloads) must be safe to call from several threads
+ * at once.  That is the case for LogisticRegressionFunction,
+ * SoftmaxRegressionFunction and RegularizedSVDFunction, but not for functions
+ * that cache intermediate results in member variables (such as FFN).  If the
+ * wrapped function has constraints (NumConstraints(), EvaluateConstraint() and
+ * GradientConstraint()), they are forwarded so that the wrapper can be used
+ * with AugLagrangian; the per-function interface is forwarded too, so the
+ * wrapper can also be passed to SGD and MiniBatchSGD.
+ *
+ * For example, to train logistic regression with L-BFGS using all cores:
+ *
+ * @code
+ * LogisticRegressionFunction<> lrf(data, responses, lambda);
+ * ParallelSeparableFunction<LogisticRegressionFunction<>> plrf(lrf);
+ * L_BFGS<ParallelSeparableFunction<LogisticRegressionFunction<>>> lbfgs(plrf);
+ * arma::mat parameters = lrf.GetInitialPoint();
+ * lbfgs.Optimize(parameters);
+ * @endcode
+ *
+ * @tparam FunctionType Separable function to be wrapped.
+ */
+template<typename FunctionType>
+class ParallelSeparableFunction
+{
+ public:
+  /**
+   * Wrap the given function.  Blocks are never made smaller than minBlockSize
+   * functions, so small problems are not split over more threads than is
+   * useful.
+   *
+   * @param function Separable function to wrap.
+   * @param minBlockSize Minimum number of functions in each block.
+   */
+  ParallelSeparableFunction(FunctionType& function,
+                            const size_t minBlockSize = 1000);
+
+  /**
+   * Evaluate the full objective (the sum of the objectives of all of the
+   * functions) at the given coordinates.
+   *
+   * @param coordinates The coordinates to evaluate at.
+   */
+  double Evaluate(const arma::mat& coordinates);
+
+  /**
+   * Evaluate the full gradient (the sum of the gradients of all of the
+   * functions) at the given coordinates.
+   *
+   * @param coordinates The coordinates to evaluate at.
+   * @param gradient Matrix to store the gradient in.
+   */
+  void Gradient(const arma::mat& coordinates, arma::mat& gradient);
+
+  //! Get the initial point of the wrapped function.
+  const arma::mat& GetInitialPoint() { return function.GetInitialPoint(); }
+
+  //! Return the number of separable functions.
+  size_t NumFunctions() { return function.NumFunctions(); }
+
+  //! Evaluate the objective of the i'th function.
+  double Evaluate(const arma::mat& coordinates, const size_t i)
+  {
+    return function.Evaluate(coordinates, i);
+  }
+
+  //! Evaluate the gradient of the i'th function.
+  void Gradient(const arma::mat& coordinates,
+                const size_t i,
+                arma::mat& gradient)
+  {
+    function.Gradient(coordinates, i, gradient);
+  }
+
+  //! Evaluate the objective of the functions begin, ..., begin + batchSize - 1.
+  double Evaluate(const arma::mat& coordinates,
+                  const size_t begin,
+                  const size_t batchSize)
+  {
+    return BatchEvaluate(function, coordinates, begin, batchSize);
+  }
+
+  //! Evaluate the gradient of the functions begin, ..., begin + batchSize - 1.
+  void Gradient(const arma::mat& coordinates,
+                const size_t begin,
+                const size_t batchSize,
+                arma::mat& gradient)
+  {
+    arma::mat scratch;
+    BatchGradient(function, coordinates, begin, batchSize, gradient, scratch);
+  }
+
+  //! Return the number of constraints of the wrapped function.
+  size_t NumConstraints() { return function.NumConstraints(); }
+
+  //! Evaluate the given constraint of the wrapped function.
+  double EvaluateConstraint(const size_t index, const arma::mat& coordinates)
+  {
+    return function.EvaluateConstraint(index, coordinates);
+  }
+
+  //! Evaluate the gradient of the given constraint of the wrapped function.
+  void GradientConstraint(const size_t index,
+                          const arma::mat& coordinates,
+                          arma::mat& gradient)
+  {
+    function.GradientConstraint(index, coordinates, gradient);
+  }
+
+  //! Get the wrapped function.
+  const FunctionType& Function() const { return function; }
+  //! Modify the wrapped function.
+  FunctionType& Function() { return function; }
+
+  //! Get the minimum number of functions in each block.
+  size_t MinBlockSize() const { return minBlockSize; }
+  //! Modify the minimum number of functions in each block.
+  size_t& MinBlockSize() { return minBlockSize; }
+
+ private:
+  //! Compute the number of blocks to split the given number of functions into.
+  size_t NumBlocks(const size_t numFunctions) const;
+
+  //! The wrapped function.
+  FunctionType& function;
+
+  //! The minimum number of functions in each block.
+  size_t minBlockSize;
+};
+
+} // namespace optimization
+} // namespace mlpack
+
+// Include implementation.
+#include "parallel_separable_function_impl.hpp"
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * @file parallel_separable_function_impl.hpp
+ *
+ * Implementation of ParallelSeparableFunction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_OPTIMIZERS_PARALLEL_SEPARABLE_PARALLEL_SEPARABLE_FUNCTION_IMPL_HPP
+#define MLPACK_CORE_OPTIMIZERS_PARALLEL_SEPARABLE_PARALLEL_SEPARABLE_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "parallel_separable_function.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace optimization {
+
+template<typename FunctionType>
+ParallelSeparableFunction<FunctionType>::ParallelSeparableFunction(
+    FunctionType& function,
+    const size_t minBlockSize) :
+    function(function),
+    minBlockSize(std::max(minBlockSize, (size_t) 1))
+{ /* Nothing to do. */ }
+
+template<typename FunctionType>
+double ParallelSeparableFunction<FunctionType>::Evaluate(
+    const arma::mat& coordinates)
+{
+  const size_t numFunctions = function.NumFunctions();
+  const size_t numBlocks = NumBlocks(numFunctions);
+
+  // Each block writes its own objective, and they are summed in order below.
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables, so intmax_t is used.
+  arma::vec objectives(numBlocks);
+  #pragma omp parallel for schedule(static)
+  for (intmax_t block = 0; block < (intmax_t) numBlocks; ++block)
+  {
+    const size_t begin = block * numFunctions / numBlocks;
+    const size_t end = (block + 1) * numFunctions / numBlocks;
+    objectives[block] = BatchEvaluate(function, coordinates, begin,
+        end - begin);
+  }
+
+  return arma::accu(objectives);
+}
+
+template<typename FunctionType>
+void ParallelSeparableFunction<FunctionType>::Gradient(
+    const arma::mat& coordinates,
+    arma::mat& gradient)
+{
+  const size_t numFunctions = function.NumFunctions();
+  const size_t numBlocks = NumBlocks(numFunctions);
+
+  // There is only one block per thread, so storing one gradient per block is
+  // cheap, and summing them in order makes the result deterministic.
+  std::vector<arma::mat> gradients(numBlocks);
+  #pragma omp parallel for schedule(static)
+  for (intmax_t block = 0; block < (intmax_t) numBlocks; ++block)
+  {
+    const size_t begin = block * numFunctions / numBlocks;
+    const size_t end = (block + 1) * numFunctions / numBlocks;
+    arma::mat scratch;
+    BatchGradient(function, coordinates, begin, end - begin, gradients[block],
+        scratch);
+  }
+
+  gradient = std::move(gradients[0]);
+  for (size_t block = 1; block < numBlocks; ++block)
+    gradient += gradients[block];
+}
+
+template<typename FunctionType>
+size_t ParallelSeparableFunction<FunctionType>::NumBlocks(
+    const size_t numFunctions) const
+{
+#ifdef HAS_OPENMP
+  const size_t maxThreads = omp_get_max_threads();
+#else
+  const size_t maxThreads = 1;
+#endif
+
+  const size_t maxBlocks = (numFunctions + minBlockSize - 1) / minBlockSize;
+  return std::max(std::min(maxThreads, maxBlocks), (size_t) 1);
+}
+
+} // namespace optimization
+} // namespace mlpack
+
+#endif
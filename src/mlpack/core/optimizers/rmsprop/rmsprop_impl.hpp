@@ -20,21 +20,24 @@
 namespace mlpack {
 namespace optimization {
 
-template<typename DecomposableFunctionType>
-RMSProp<DecomposableFunctionType>::RMSProp(DecomposableFunctionType& function,
-                                           const double stepSize,
-                                           const double alpha,
-                                           const double epsilon,
-                                           const size_t maxIterations,
-                                           const double tolerance,
-                                           const bool shuffle) :
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+RMSProp<DecomposableFunctionType, ObjectivePolicyType>::RMSProp(
+    DecomposableFunctionType& function,
+    const double stepSize,
+    const double alpha,
+    const double epsilon,
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const ObjectivePolicyType& objectivePolicy) :
     optimizer(function,
               stepSize,
               maxIterations,
               tolerance,
               shuffle,
               RMSPropUpdate(epsilon,
-                            alpha))
+                            alpha),
+              objectivePolicy)
 { /* Nothing to do. */ }
 
 } // namespace optimization
@@ -17,6 +17,11 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/optimizers/sgd/update_policies/vanilla_update.hpp>
 #include <mlpack/core/optimizers/sgd/update_policies/momentum_update.hpp>
+#include <mlpack/core/optimizers/minibatch_sgd/batch_function_traits.hpp>
+#include <mlpack/core/optimizers/objective_policies/exact_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/moving_average_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/sampled_objective.hpp>
+#include <mlpack/core/optimizers/objective_policies/no_objective.hpp>
 
 namespace mlpack {
 namespace optimization {
@@ -73,10 +78,16 @@ namespace optimization {
  * @tparam UpdatePolicyType update policy used by SGD during the iterative update
  *     process. By default vanilla update policy (see
  *     mlpack::optimization::VanillaUpdate) is used.
+ * @tparam ObjectivePolicyType policy that decides how the objective used for
+ *     the convergence test is tracked.  By default the objective of every
+ *     function is evaluated after each update (see
+ *     mlpack::optimization::ExactObjective); MovingAverageObjective,
+ *     SampledObjective and NoObjective are cheaper alternatives.
  */
 template<
     typename DecomposableFunctionType,
-    typename UpdatePolicyType = VanillaUpdate
+    typename UpdatePolicyType = VanillaUpdate,
+    typename ObjectivePolicyType = ExactObjective
 >
 class SGD
 {
@@ -96,13 +107,17 @@ class SGD
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
    * @param shuffle If true, the function order is shuffled; otherwise, each
    *     function is visited in linear order.
+   * @param updatePolicy Instantiated update policy used to adjust the given
+   *     parameters.
+   * @param objectivePolicy Instantiated policy used to track the objective.
    */
   SGD(DecomposableFunctionType& function,
       const double stepSize = 0.01,
       const size_t maxIterations = 100000,
       const double tolerance = 1e-5,
       const bool shuffle = true,
-      const UpdatePolicyType updatePolicy = UpdatePolicyType());
+      const UpdatePolicyType updatePolicy = UpdatePolicyType(),
+      const ObjectivePolicyType& objectivePolicy = ObjectivePolicyType());
 
   /**
    * Optimize the given function using stochastic gradient descent.  The given
@@ -144,6 +159,11 @@ class SGD
   //! Modify the update policy.
   UpdatePolicyType& UpdatePolicy() { return updatePolicy; }
 
+  //! Get the objective policy.
+  const ObjectivePolicyType& ObjectivePolicy() const { return objectivePolicy; }
+  //! Modify the objective policy.
+  ObjectivePolicyType& ObjectivePolicy() { return objectivePolicy; }
+
  private:
   //! The instantiated function.
   DecomposableFunctionType& function;
@@ -163,6 +183,9 @@ class SGD
 
   //! The update policy used to update the parameters in each iteration.
   UpdatePolicyType updatePolicy;
+
+  //! The policy used to track the objective.
+  ObjectivePolicyType objectivePolicy;
 };
 
 template<typename DecomposableFunctionType>
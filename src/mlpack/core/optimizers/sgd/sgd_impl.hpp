@@ -23,26 +23,32 @@
 namespace mlpack {
 namespace optimization {
 
-template<typename DecomposableFunctionType, typename UpdatePolicyType>
-SGD<DecomposableFunctionType, UpdatePolicyType>::SGD(
+template<typename DecomposableFunctionType,
+         typename UpdatePolicyType,
+         typename ObjectivePolicyType>
+SGD<DecomposableFunctionType, UpdatePolicyType, ObjectivePolicyType>::SGD(
     DecomposableFunctionType& function,
     const double stepSize,
     const size_t maxIterations,
     const double tolerance,
     const bool shuffle,
-    const UpdatePolicyType updatePolicy) :
+    const UpdatePolicyType updatePolicy,
+    const ObjectivePolicyType& objectivePolicy) :
     function(function),
     stepSize(stepSize),
     maxIterations(maxIterations),
     tolerance(tolerance),
     shuffle(shuffle),
-    updatePolicy(updatePolicy)
+    updatePolicy(updatePolicy),
+    objectivePolicy(objectivePolicy)
 { /* Nothing to do. */ }
 
 //! Optimize the function (minimize).
-template<typename DecomposableFunctionType, typename UpdatePolicyType>
-double SGD<DecomposableFunctionType, UpdatePolicyType>::Optimize(
-    arma::mat& iterate)
+template<typename DecomposableFunctionType,
+         typename UpdatePolicyType,
+         typename ObjectivePolicyType>
+double SGD<DecomposableFunctionType, UpdatePolicyType, ObjectivePolicyType>::
+Optimize(arma::mat& iterate)
 {
   // Find the number of functions to use.
   const size_t numFunctions = function.NumFunctions();
@@ -60,11 +66,8 @@ double SGD<DecomposableFunctionType, UpdatePolicyType>::Optimize(
   double overallObjective = 0;
   double lastObjective = DBL_MAX;
 
-  // Calculate the first objective function.
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
-
-  // Initialize the update policy.
+  // Initialize the objective and update policies.
+  objectivePolicy.Initialize(function, iterate, 1);
   updatePolicy.Initialize(iterate.n_rows,iterate.n_cols);
 
   // Now iterate!
@@ -74,27 +77,32 @@ double SGD<DecomposableFunctionType, UpdatePolicyType>::Optimize(
     // Is this iteration the start of a sequence?
     if ((currentFunction % numFunctions) == 0)
     {
-      // Output current objective function.
-      Log::Info << "SGD: iteration " << i << ", objective " << overallObjective
-          << "." << std::endl;
-
-      if (std::isnan(overallObjective) || std::isinf(overallObjective))
-      {
-        Log::Warn << "SGD: converged to " << overallObjective << "; terminating"
-            << " with failure.  Try a smaller step size?" << std::endl;
-        return overallObjective;
-      }
-
-      if (std::abs(lastObjective - overallObjective) < tolerance)
+      // The objective policy may not have an objective for every sequence.
+      if (objectivePolicy.EpochObjective(function, iterate, overallObjective))
       {
-        Log::Info << "SGD: minimized within tolerance " << tolerance << "; "
-            << "terminating optimization." << std::endl;
-        return overallObjective;
+        // Output current objective function.
+        Log::Info << "SGD: iteration " << i << ", objective "
+            << overallObjective << "." << std::endl;
+
+        if (std::isnan(overallObjective) || std::isinf(overallObjective))
+        {
+          Log::Warn << "SGD: converged to " << overallObjective << "; "
+              << "terminating with failure.  Try a smaller step size?"
+              << std::endl;
+          return overallObjective;
+        }
+
+        if (std::abs(lastObjective - overallObjective) < tolerance)
+        {
+          Log::Info << "SGD: minimized within tolerance " << tolerance << "; "
+              << "terminating optimization." << std::endl;
+          return overallObjective;
+        }
+
+        lastObjective = overallObjective;
       }
 
       // Reset the counter variables.
-      lastObjective = overallObjective;
-      overallObjective = 0;
       currentFunction = 0;
 
       if (shuffle) // Determine order of visitation.
@@ -102,34 +110,23 @@ double SGD<DecomposableFunctionType, UpdatePolicyType>::Optimize(
     }
 
     // Evaluate the gradient for this iteration.
-    if (shuffle)
-      function.Gradient(iterate, visitationOrder[currentFunction], gradient);
-    else
-      function.Gradient(iterate, currentFunction, gradient);
+    const size_t index = shuffle ? visitationOrder[currentFunction] :
+        currentFunction;
+    function.Gradient(iterate, index, gradient);
 
     // Use the update policy to take a step.
     updatePolicy.Update(iterate, stepSize, gradient);
 
-    // Now add that to the overall objective function.
-    if (shuffle)
-    {
-      overallObjective += function.Evaluate(iterate,
-          visitationOrder[currentFunction]);
-    }
-    else
-    {
-      overallObjective += function.Evaluate(iterate, currentFunction);
-    }
+    // Let the objective policy track the objective of the new point.
+    objectivePolicy.Update(function, iterate, index, 1);
   }
 
   Log::Info << "SGD: maximum iterations (" << maxIterations << ") reached; "
       << "terminating optimization." << std::endl;
 
-  // Calculate final objective.
-  overallObjective = 0;
-  for (size_t i = 0; i < numFunctions; ++i)
-    overallObjective += function.Evaluate(iterate, i);
-  return overallObjective;
+  // Calculate final objective, with the batch overloads of the function if it
+  // has them.
+  return BatchEvaluate(function, iterate, 0, numFunctions);
 }
 
 } // namespace optimization
@@ -58,8 +58,12 @@ namespace optimization {
  *
  * @tparam DecomposableFunctionType Decomposable objective function type to be
  *     minimized.
+ * @tparam ObjectivePolicyType Policy that decides how the objective used for
+ *     the convergence test is tracked (see
+ *     mlpack::optimization::ExactObjective).
  */
-template<typename DecomposableFunctionType>
+template<typename DecomposableFunctionType,
+         typename ObjectivePolicyType = ExactObjective>
 class SMORMS3
 {
  public:
@@ -79,13 +83,15 @@ class SMORMS3
    * @param tolerance Maximum absolute tolerance to terminate algorithm.
    * @param shuffle If true, the function order is shuffled; otherwise, each
    *        function is visited in linear order.
+   * @param objectivePolicy Instantiated policy used to track the objective.
    */
   SMORMS3(DecomposableFunctionType& function,
       const double stepSize = 0.001,
       const double epsilon = 1e-16,
       const size_t maxIterations = 100000,
       const double tolerance = 1e-5,
-      const bool shuffle = true);
+      const bool shuffle = true,
+      const ObjectivePolicyType& objectivePolicy = ObjectivePolicyType());
 
   /**
    * Optimize the given function using SMORMS3. The given starting point will 
@@ -127,9 +133,17 @@ class SMORMS3
   //! Modify whether or not the individual functions are shuffled.
   bool& Shuffle() { return optimizer.Shuffle(); }
 
+  //! Get the objective policy.
+  const ObjectivePolicyType& ObjectivePolicy() const
+  {
+    return optimizer.ObjectivePolicy();
+  }
+  //! Modify the objective policy.
+  ObjectivePolicyType& ObjectivePolicy() { return optimizer.ObjectivePolicy(); }
+
  private:
   //! The Stochastic Gradient Descent object with SMORMS3Update update policy.
-  SGD<DecomposableFunctionType, SMORMS3Update> optimizer;
+  SGD<DecomposableFunctionType, SMORMS3Update, ObjectivePolicyType> optimizer;
 };
 
 } // namespace optimization
@@ -18,19 +18,22 @@
 namespace mlpack {
 namespace optimization {
 
-template<typename DecomposableFunctionType>
-SMORMS3<DecomposableFunctionType>::SMORMS3(DecomposableFunctionType& function,
-                                           const double stepSize,
-                                           const double epsilon,
-                                           const size_t maxIterations,
-                                           const double tolerance,
-                                           const bool shuffle) :
+template<typename DecomposableFunctionType, typename ObjectivePolicyType>
+SMORMS3<DecomposableFunctionType, ObjectivePolicyType>::SMORMS3(
+    DecomposableFunctionType& function,
+    const double stepSize,
+    const double epsilon,
+    const size_t maxIterations,
+    const double tolerance,
+    const bool shuffle,
+    const ObjectivePolicyType& objectivePolicy) :
     optimizer(function,
               stepSize,
               maxIterations,
               tolerance,
               shuffle,
-              SMORMS3Update(epsilon))
+              SMORMS3Update(epsilon),
+              objectivePolicy)
 { /* Nothing to do. */ }
 
 } // namespace optimization
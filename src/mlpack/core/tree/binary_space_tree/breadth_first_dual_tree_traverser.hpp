@@ -7,6 +7,10 @@
  * breadth-first manner with a given set of rules which indicate the branches
  * which can be pruned and the order in which to recurse.
  *
+ * If mlpack is compiled with OpenMP and the rules support forking (see the
+ * documentation of the class below), then disjoint query subtrees are traversed
+ * in parallel by worker threads.
+ *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
  * 3-clause BSD license along with mlpack.  If not, see
@@ -16,8 +20,13 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_BREADTH_FIRST_DUAL_TREE_TRAVERSER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
 #include <queue>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 #include "../binary_space_tree.hpp"
 
 namespace mlpack {
@@ -33,6 +42,34 @@ struct QueueFrame
   TraversalInfoType traversalInfo;
 };
 
+//! Check whether a rule type supports creating worker rules with Fork().
+HAS_MEM_FUNC(Fork, RuleHasForkCheck);
+//! Check whether a rule type supports merging worker rules with Merge().
+HAS_MEM_FUNC(Merge, RuleHasMergeCheck);
+
+/**
+ * Determine whether or not a rule type can be used by the parallel
+ * breadth-first traversal.  For this, the rule type must provide the two
+ * member functions
+ *
+ * @code
+ * RuleType Fork();
+ * void Merge(const RuleType& worker);
+ * @endcode
+ *
+ * where Fork() returns a rules object that shares its results with the
+ * original object but holds its own traversal state, and Merge() adds the
+ * statistics of a worker (such as the number of base cases) back into the
+ * original object.
+ */
+template<typename RuleType>
+struct IsForkableRule
+{
+  static const bool value =
+      RuleHasForkCheck<RuleType, RuleType(RuleType::*)()>::value &&
+      RuleHasMergeCheck<RuleType, void(RuleType::*)(const RuleType&)>::value;
+};
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -46,8 +83,24 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
  public:
   /**
    * Instantiate the dual-tree traverser with the given rule set.
+   *
+   * The traversal holds one priority queue of (query node, reference node)
+   * combinations for each query subtree; combinations in the queue are
+   * expanded in order of their score, so that the most promising reference
+   * nodes are visited first and pruning bounds tighten quickly.  Because the
+   * query subtrees of a binary space tree are disjoint, the queues of the two
+   * children of a query node can be processed independently.  If mlpack was
+   * compiled with OpenMP and RuleType satisfies IsForkableRule, each of those
+   * queues is handed to an OpenMP task with its own worker rules object (see
+   * IsForkableRule), as long as the query subtree holds at least
+   * MinForkSize() points.  Otherwise, the traversal is serial.
+   *
+   * @param rule Instantiated rules to use for the traversal.
+   * @param minForkSize Minimum number of points a query subtree must hold to
+   *     be traversed by a separate task.
    */
-  BreadthFirstDualTreeTraverser(RuleType& rule);
+  BreadthFirstDualTreeTraverser(RuleType& rule,
+                                const size_t minForkSize = 256);
 
   typedef QueueFrame<BinarySpaceTree, typename RuleType::TraversalInfoType>
       QueueFrameType;
@@ -84,10 +137,45 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   //! Modify the number of times a base case was calculated.
   size_t& NumBaseCases() { return numBaseCases; }
 
+  //! Get the minimum number of points in a query subtree to fork a task.
+  size_t MinForkSize() const { return minForkSize; }
+  //! Modify the minimum number of points in a query subtree to fork a task.
+  size_t& MinForkSize() { return minForkSize; }
+
  private:
+  /**
+   * Traverse the queues for the two children of the given query node.  This
+   * overload is used when the rules cannot be forked, and the children are
+   * traversed one after the other.
+   */
+  template<typename Rule = RuleType>
+  void TraverseChildren(
+      BinarySpaceTree& queryNode,
+      std::priority_queue<QueueFrameType>& leftChildQueue,
+      std::priority_queue<QueueFrameType>& rightChildQueue,
+      const typename std::enable_if<
+          !IsForkableRule<Rule>::value>::type* = 0);
+
+  /**
+   * Traverse the queues for the two children of the given query node.  This
+   * overload is used when the rules can be forked; if both children are large
+   * enough, each child is traversed in its own OpenMP task with a worker
+   * rules object.
+   */
+  template<typename Rule = RuleType>
+  void TraverseChildren(
+      BinarySpaceTree& queryNode,
+      std::priority_queue<QueueFrameType>& leftChildQueue,
+      std::priority_queue<QueueFrameType>& rightChildQueue,
+      const typename std::enable_if<
+          IsForkableRule<Rule>::value>::type* = 0);
+
   //! Reference to the rules with which the trees will be traversed.
   RuleType& rule;
 
+  //! The minimum number of points in a query subtree to fork a task.
+  size_t minForkSize;
+
   //! The number of prunes.
   size_t numPrunes;
 
@@ -29,8 +29,10 @@ template<typename MetricType,
 template<typename RuleType>
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BreadthFirstDualTreeTraverser<RuleType>::BreadthFirstDualTreeTraverser(
-    RuleType& rule) :
+    RuleType& rule,
+    const size_t minForkSize) :
     rule(rule),
+    minForkSize(minForkSize),
     numPrunes(0),
     numVisited(0),
     numScores(0),
@@ -84,8 +86,21 @@ BreadthFirstDualTreeTraverser<RuleType>::Traverse(
 
   queue.push(rootFrame);
 
-  // Start the traversal.
-  Traverse(queryRoot, queue);
+  // Start the traversal.  If the rules can be forked, the traversal of query
+  // subtrees will be split into OpenMP tasks, so we need a team of threads to
+  // execute them; the traversal itself starts on only one of them.
+  if (IsForkableRule<RuleType>::value)
+  {
+    #pragma omp parallel
+    {
+      #pragma omp single
+      Traverse(queryRoot, queue);
+    }
+  }
+  else
+  {
+    Traverse(queryRoot, queue);
+  }
 }
 
 template<typename MetricType,
@@ -198,12 +213,96 @@ BreadthFirstDualTreeTraverser<RuleType>::Traverse(
 
   // Now, recurse into the left and right children queues.  The order doesn't
   // matter.
+  TraverseChildren(queryNode, leftChildQueue, rightChildQueue);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+template<typename Rule>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BreadthFirstDualTreeTraverser<RuleType>::TraverseChildren(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    std::priority_queue<QueueFrameType>& leftChildQueue,
+    std::priority_queue<QueueFrameType>& rightChildQueue,
+    const typename std::enable_if<!IsForkableRule<Rule>::value>::type*)
+{
   if (leftChildQueue.size() > 0)
     Traverse(*queryNode.Left(), leftChildQueue);
   if (rightChildQueue.size() > 0)
     Traverse(*queryNode.Right(), rightChildQueue);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+template<typename Rule>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BreadthFirstDualTreeTraverser<RuleType>::TraverseChildren(
+    BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
+        queryNode,
+    std::priority_queue<QueueFrameType>& leftChildQueue,
+    std::priority_queue<QueueFrameType>& rightChildQueue,
+    const typename std::enable_if<IsForkableRule<Rule>::value>::type*)
+{
+  // Only fork if there is work for both children and both query subtrees are
+  // large enough that the task overhead is worth it.  The queues only hold
+  // combinations for the two (disjoint) query subtrees, so two workers can
+  // never touch the results for the same query point.
+  bool fork = !leftChildQueue.empty() && !rightChildQueue.empty() &&
+      (queryNode.Left()->Count() >= minForkSize) &&
+      (queryNode.Right()->Count() >= minForkSize);
+#ifdef HAS_OPENMP
+  fork = fork && (omp_get_num_threads() > 1);
+#else
+  fork = false;
+#endif
+
+  if (!fork)
+  {
+    if (leftChildQueue.size() > 0)
+      Traverse(*queryNode.Left(), leftChildQueue);
+    if (rightChildQueue.size() > 0)
+      Traverse(*queryNode.Right(), rightChildQueue);
+    return;
+  }
+
+  // The right child is traversed by a worker in a new task, while this thread
+  // continues with the left child using its own worker.  Each worker has its
+  // own traversal state, so the rules object held by this traverser is not
+  // touched until both tasks are finished.
+  RuleType leftRule(rule.Fork());
+  RuleType rightRule(rule.Fork());
+  BreadthFirstDualTreeTraverser leftTraverser(leftRule, minForkSize);
+  BreadthFirstDualTreeTraverser rightTraverser(rightRule, minForkSize);
+
+  #pragma omp task default(shared)
+  rightTraverser.Traverse(*queryNode.Right(), rightChildQueue);
+
+  leftTraverser.Traverse(*queryNode.Left(), leftChildQueue);
+
+  #pragma omp taskwait
+
+  // Collect the statistics of the workers.
+  rule.Merge(leftRule);
+  rule.Merge(rightRule);
+
+  numPrunes += leftTraverser.NumPrunes() + rightTraverser.NumPrunes();
+  numVisited += leftTraverser.NumVisited() + rightTraverser.NumVisited();
+  numScores += leftTraverser.NumScores() + rightTraverser.NumScores();
+  numBaseCases += leftTraverser.NumBaseCases() +
+      rightTraverser.NumBaseCases();
+}
+
 } // namespace tree
 } // namespace mlpack
 
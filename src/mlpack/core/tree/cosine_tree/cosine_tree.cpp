@@ -14,9 +14,17 @@
 
 #include <boost/math/distributions/normal.hpp>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
+// Nodes with fewer elements than this are processed serially, since starting a
+// team of threads would cost more than it saves.
+static const size_t parallelMinElements = 100000;
+
 CosineTree::CosineTree(const arma::mat& dataset) :
     dataset(dataset),
     parent(NULL),
@@ -28,12 +36,14 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   indices.resize(numColumns);
   l2NormsSquared.zeros(numColumns);
 
-  // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; i++)
+  // Set indices and calculate squared norms of the columns.  Visual Studio
+  // only implements OpenMP 2.0, which doesn't support unsigned loop variables.
+  #pragma omp parallel for schedule(static) \
+      if (numColumns * dataset.n_rows >= parallelMinElements)
+  for (intmax_t i = 0; i < (intmax_t) numColumns; i++)
   {
     indices[i] = i;
-    double l2Norm = arma::norm(dataset.col(i), 2);
-    l2NormsSquared(i) = l2Norm * l2Norm;
+    l2NormsSquared(i) = arma::dot(dataset.col(i), dataset.col(i));
   }
 
   // Frobenius norm of columns in the node.
@@ -41,6 +51,7 @@ CosineTree::CosineTree(const arma::mat& dataset) :
 
   // Calculate centroid of columns in the node.
   CalculateCentroid();
+  CalculateDistribution();
 
   splitPointIndex = ColumnSampleLS();
 }
@@ -69,6 +80,7 @@ CosineTree::CosineTree(CosineTree& parentNode,
 
   // Calculate centroid of columns in the node.
   CalculateCentroid();
+  CalculateDistribution();
 
   splitPointIndex = ColumnSampleLS();
 }
@@ -94,6 +106,10 @@ CosineTree::CosineTree(const arma::mat& dataset,
   // Initialize Monte Carlo error estimate for comparison.
   double monteCarloError = root.FrobNormSquared();
 
+  // The basis of the nodes in the queue, the orthonormalized centroids of the
+  // children of a split node, and the two together.
+  arma::mat queueBasis, childBasis, extendedBasis;
+
   while (monteCarloError > epsilon * root.FrobNormSquared())
   {
     // Pop node from queue with highest projection error.
@@ -122,27 +138,35 @@ CosineTree::CosineTree(const arma::mat& dataset,
     currentLeft = currentNode->Left();
     currentRight = currentNode->Right();
 
-    // Calculate basis vectors of left and right children.
-    arma::vec lBasisVector, rBasisVector;
-
-    ModifiedGramSchmidt(treeQueue, currentLeft->Centroid(), lBasisVector);
-    ModifiedGramSchmidt(treeQueue, currentRight->Centroid(), rBasisVector,
-                        &lBasisVector);
+    // Calculate basis vectors of left and right children, orthonormalizing
+    // both centroids against the current basis at once.
+    QueueBasis(treeQueue, queueBasis);
+    childBasis.set_size(dataset.n_rows, 2);
+    childBasis.col(0) = currentLeft->Centroid();
+    childBasis.col(1) = currentRight->Centroid();
+    BlockGramSchmidt(queueBasis, childBasis);
 
     // Add basis vectors to their respective nodes.
+    arma::vec lBasisVector = childBasis.col(0);
+    arma::vec rBasisVector = childBasis.col(1);
     currentLeft->BasisVector(lBasisVector);
     currentRight->BasisVector(rBasisVector);
 
+    // Once the children are pushed, the basis of the queue is the current
+    // basis plus the two new vectors, so all of the error estimates below can
+    // share it.
+    extendedBasis = arma::join_rows(queueBasis, childBasis);
+
     // Calculate Monte Carlo error estimates for child nodes.
-    MonteCarloError(currentLeft, treeQueue, &lBasisVector, &rBasisVector);
-    MonteCarloError(currentRight, treeQueue, &lBasisVector, &rBasisVector);
+    MonteCarloError(currentLeft, extendedBasis);
+    MonteCarloError(currentRight, extendedBasis);
 
     // Push child nodes into the priority queue.
     treeQueue.push(currentLeft);
     treeQueue.push(currentRight);
 
     // Calculate Monte Carlo error estimate for the root node.
-    monteCarloError = MonteCarloError(&root, treeQueue);
+    monteCarloError = MonteCarloError(&root, extendedBasis);
   }
 
   // Construct the subspace basis from the current priority queue.
@@ -162,39 +186,60 @@ void CosineTree::ModifiedGramSchmidt(CosineNodeQueue& treeQueue,
                                      arma::vec& newBasisVector,
                                      arma::vec* addBasisVector)
 {
-  // Set new basis vector to centroid.
-  newBasisVector = centroid;
+  // Collect the current basis, including the additional vector if given.
+  arma::mat basis;
+  QueueBasis(treeQueue, basis);
+  if (addBasisVector)
+    basis = arma::join_rows(basis, *addBasisVector);
 
-  // Variables for iterating throught the priority queue.
-  CosineTree *currentNode;
-  CosineNodeQueue::const_iterator i = treeQueue.begin();
+  arma::mat vectors(centroid);
+  BlockGramSchmidt(basis, vectors);
+  newBasisVector = vectors.col(0);
+}
 
-  // For every vector in the current basis, remove its projection from the
-  // centroid.
-  for ( ; i != treeQueue.end(); i++)
+void CosineTree::BlockGramSchmidt(const arma::mat& basis, arma::mat& vectors)
+{
+  // Remove the projection onto the basis from all vectors at once.  A second
+  // pass removes what is left over from rounding error in the first.
+  if (basis.n_cols > 0)
   {
-    currentNode = *i;
-
-    double projection = arma::dot(currentNode->BasisVector(), centroid);
-    newBasisVector -= projection * currentNode->BasisVector();
+    for (size_t pass = 0; pass < 2; ++pass)
+      vectors -= basis * (basis.t() * vectors);
   }
 
-  // If additional basis vector is passed, take it into account.
-  if (addBasisVector)
+  // Orthonormalize the new vectors against each other.  There are only a few
+  // of them, so this is done one at a time.
+  for (size_t i = 0; i < vectors.n_cols; ++i)
   {
-    double projection = arma::dot(*addBasisVector, centroid);
-    newBasisVector -= *addBasisVector * projection;
-  }
+    for (size_t j = 0; j < i; ++j)
+      vectors.col(i) -= arma::dot(vectors.col(j), vectors.col(i)) *
+          vectors.col(j);
 
-  // Normalize the modified centroid vector.
-  if (arma::norm(newBasisVector, 2))
-    newBasisVector /= arma::norm(newBasisVector, 2);
+    const double norm = arma::norm(vectors.col(i), 2);
+    if (norm)
+      vectors.col(i) /= norm;
+  }
 }
 
 double CosineTree::MonteCarloError(CosineTree* node,
                                    CosineNodeQueue& treeQueue,
                                    arma::vec* addBasisVector1,
                                    arma::vec* addBasisVector2)
+{
+  // Collect the current basis; the additional vectors are only used if both
+  // are given.
+  arma::mat basis;
+  QueueBasis(treeQueue, basis);
+  if (addBasisVector1 && addBasisVector2)
+  {
+    basis = arma::join_rows(basis, *addBasisVector1);
+    basis = arma::join_rows(basis, *addBasisVector2);
+  }
+
+  return MonteCarloError(node, basis);
+}
+
+double CosineTree::MonteCarloError(CosineTree* node, const arma::mat& basis)
 {
   std::vector<size_t> sampledIndices;
   arma::vec probabilities;
@@ -204,55 +249,24 @@ double CosineTree::MonteCarloError(CosineTree* node,
   size_t numSamples = log(node->NumColumns()) + 1;
   node->ColumnSamplesLS(sampledIndices, probabilities, numSamples);
 
-  // Get pointer to the original dataset.
-  arma::mat dataset = node->GetDataset();
+  // Gather the sampled columns, so that their projections onto the basis can
+  // be computed with a single matrix product.
+  const arma::mat& dataset = node->GetDataset();
+  arma::mat samples(dataset.n_rows, numSamples);
+  for (size_t i = 0; i < numSamples; i++)
+    samples.col(i) = dataset.col(sampledIndices[i]);
 
-  // Initialize weighted projection magnitudes as zeros.
+  // For each sample, calculate the weighted squared norm of the projection onto
+  // the current basis.
   arma::vec weightedMagnitudes;
-  weightedMagnitudes.zeros(numSamples);
-
-  // Set size of projection vector, depending on whether additional basis
-  // vectors are passed.
-  size_t projectionSize;
-  if (addBasisVector1 && addBasisVector2)
-    projectionSize = treeQueue.size() + 2;
+  if (basis.n_cols > 0)
+  {
+    weightedMagnitudes = arma::trans(arma::sum(arma::square(basis.t() *
+        samples), 0)) / probabilities;
+  }
   else
-    projectionSize = treeQueue.size();
-
-  // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; i++)
   {
-    // Initialize projection as a vector of zeros.
-    arma::vec projection;
-    projection.zeros(projectionSize);
-
-    CosineTree *currentNode;
-    CosineNodeQueue::const_iterator j = treeQueue.begin();
-
-    size_t k = 0;
-    // Compute the projection of the sampled vector onto the existing subspace.
-    for ( ; j != treeQueue.end(); j++, k++)
-    {
-      currentNode = *j;
-
-      projection(k) = arma::dot(dataset.col(sampledIndices[i]),
-                                currentNode->BasisVector());
-    }
-    // If two additional vectors are passed, take their projections.
-    if (addBasisVector1 && addBasisVector2)
-    {
-      projection(k++) = arma::dot(dataset.col(sampledIndices[i]),
-                                  *addBasisVector1);
-      projection(k) = arma::dot(dataset.col(sampledIndices[i]),
-                                *addBasisVector2);
-    }
-
-    // Calculate the Frobenius norm squared of the projected vector.
-    double frobProjection = arma::norm(projection, "frob");
-    double frobProjectionSquared = frobProjection * frobProjection;
-
-    // Calculate the weighted projection magnitude.
-    weightedMagnitudes(i) = frobProjectionSquared / probabilities(i);
+    weightedMagnitudes.zeros(numSamples);
   }
 
   // Compute mean and standard deviation of the weighted samples.
@@ -278,20 +292,18 @@ double CosineTree::MonteCarloError(CosineTree* node,
 
 void CosineTree::ConstructBasis(CosineNodeQueue& treeQueue)
 {
-  // Initialize basis as matrix of zeros.
-  basis.zeros(dataset.n_rows, treeQueue.size());
+  QueueBasis(treeQueue, basis);
+}
 
-  // Variables for iterating through the priority queue.
-  CosineTree *currentNode;
-  CosineNodeQueue::const_iterator i = treeQueue.begin();
+void CosineTree::QueueBasis(CosineNodeQueue& treeQueue, arma::mat& queueBasis)
+{
+  queueBasis.set_size(treeQueue.empty() ? 0 :
+      (*treeQueue.begin())->BasisVector().n_elem, treeQueue.size());
 
   // Transfer basis vectors from the queue to the basis matrix.
-  size_t j = 0;
-  for ( ; i != treeQueue.end(); i++, j++)
-  {
-    currentNode = *i;
-    basis.col(j) = currentNode->BasisVector();
-  }
+  CosineNodeQueue::const_iterator i = treeQueue.begin();
+  for (size_t j = 0; i != treeQueue.end(); i++, j++)
+    queueBasis.col(j) = (*i)->BasisVector();
 }
 
 void CosineTree::CosineNodeSplit()
@@ -335,17 +347,6 @@ void CosineTree::ColumnSamplesLS(std::vector<size_t>& sampledIndices,
                                  arma::vec& probabilities,
                                  size_t numSamples)
 {
-  // Initialize the cumulative distribution vector size.
-  arma::vec cDistribution;
-  cDistribution.zeros(numColumns + 1);
-
-  // Calculate cumulative length-squared distribution for the node.
-  for (size_t i = 0; i < numColumns; i++)
-  {
-    cDistribution(i + 1) = cDistribution(i) +
-        (l2NormsSquared(i) / frobNormSquared);
-  }
-
   // Initialize sizes of the 'sampledIndices' and 'probabilities' vectors.
   sampledIndices.resize(numSamples);
   probabilities.zeros(numSamples);
@@ -371,17 +372,6 @@ size_t CosineTree::ColumnSampleLS()
     return 0;
   }
 
-  // Initialize the cumulative distribution vector size.
-  arma::vec cDistribution;
-  cDistribution.zeros(numColumns + 1);
-
-  // Calculate cumulative length-squared distribution for the node.
-  for (size_t i = 0; i < numColumns; i++)
-  {
-    cDistribution(i + 1) = cDistribution(i) +
-        (l2NormsSquared(i) / frobNormSquared);
-  }
-
   // Generate a random value for sampling.
   double randValue = arma::randu();
   size_t start = 0, end = numColumns;
@@ -418,39 +408,69 @@ size_t CosineTree::BinarySearch(arma::vec& cDistribution,
   }
 }
 
+void CosineTree::CalculateDistribution()
+{
+  // Initialize the cumulative distribution vector size.
+  cDistribution.zeros(numColumns + 1);
+
+  // Calculate cumulative length-squared distribution for the node.  This is
+  // computed once per node, since the Monte Carlo error estimate samples from
+  // the root after every split.
+  for (size_t i = 0; i < numColumns; i++)
+  {
+    cDistribution(i + 1) = cDistribution(i) +
+        (l2NormsSquared(i) / frobNormSquared);
+  }
+}
+
 void CosineTree::CalculateCosines(arma::vec& cosines)
 {
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; i++)
+  const arma::vec splitPoint = dataset.col(indices[splitPointIndex]);
+  const double splitNorm = std::sqrt(l2NormsSquared(splitPointIndex));
+
+  // If norm is zero, store cosine value as zero. Else, calculate cosine value
+  // between two vectors.
+  if (splitNorm == 0)
+    return;
+
+  #pragma omp parallel for schedule(static) \
+      if (numColumns * dataset.n_rows >= parallelMinElements)
+  for (intmax_t i = 0; i < (intmax_t) numColumns; i++)
   {
-    // If norm is zero, store cosine value as zero. Else, calculate cosine value
-    // between two vectors.
-    if (l2NormsSquared(i) == 0)
-    {
-      cosines(i) = 0;
-    }
-    else
+    if (l2NormsSquared(i) != 0)
     {
-      cosines(i) =
-          std::abs(arma::norm_dot(dataset.col(indices[splitPointIndex]),
-                                  dataset.col(indices[i])));
+      cosines(i) = std::abs(arma::dot(splitPoint, dataset.col(indices[i]))) /
+          (splitNorm * std::sqrt(l2NormsSquared(i)));
     }
   }
 }
 
 void CosineTree::CalculateCentroid()
 {
-  // Initialize centroid as vector of zeros.
-  centroid.zeros(dataset.n_rows);
-
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; i++)
+  // Sum the columns in one block per thread.  The partial sums are added in
+  // order, so the centroid doesn't depend on how the blocks were scheduled.
+  size_t numBlocks = 1;
+#ifdef HAS_OPENMP
+  if (numColumns * dataset.n_rows >= parallelMinElements)
+    numBlocks = std::min((size_t) omp_get_max_threads(), numColumns);
+#endif
+
+  arma::mat partialSums(dataset.n_rows, numBlocks, arma::fill::zeros);
+
+  #pragma omp parallel for schedule(static) if (numBlocks > 1)
+  for (intmax_t block = 0; block < (intmax_t) numBlocks; ++block)
   {
-    centroid += dataset.col(indices[i]);
+    const size_t begin = block * numColumns / numBlocks;
+    const size_t end = (block + 1) * numColumns / numBlocks;
+    for (size_t i = begin; i < end; ++i)
+      partialSums.col(block) += dataset.col(indices[i]);
   }
-  centroid /= numColumns;
+
+  // Calculate centroid of columns in the node.
+  centroid = arma::sum(partialSums, 1) / numColumns;
 }
 
 } // namespace tree
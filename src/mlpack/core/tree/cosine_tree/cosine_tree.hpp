@@ -87,6 +87,19 @@ class CosineTree
                            arma::vec& newBasisVector,
                            arma::vec* addBasisVector = NULL);
 
+  /**
+   * Orthonormalizes the columns of 'vectors' with respect to the given basis
+   * and to each other.  The projection onto the basis is removed for all
+   * vectors at once (twice, to keep the result orthogonal to working
+   * precision), so the work is done with matrix products instead of one dot
+   * product per basis vector.  Columns that lie in the span of the basis are
+   * left as zero vectors.
+   *
+   * @param basis Matrix whose columns are orthonormal (or zero) basis vectors.
+   * @param vectors Vectors to orthonormalize; overwritten with the result.
+   */
+  void BlockGramSchmidt(const arma::mat& basis, arma::mat& vectors);
+
   /**
    * Estimates the squared error of the projection of the input node's matrix
    * onto the current vector subspace. A normal distribution is fit using
@@ -104,6 +117,17 @@ class CosineTree
                          arma::vec* addBasisVector1 = NULL,
                          arma::vec* addBasisVector2 = NULL);
 
+  /**
+   * Estimates the squared error of the projection of the input node's matrix
+   * onto the subspace spanned by the columns of the given basis.  This is the
+   * same estimate as above, but the projections of all samples are computed
+   * with a single matrix product.
+   *
+   * @param node Node for which Monte Carlo estimate is calculated.
+   * @param basis Matrix whose columns span the current subspace.
+   */
+  double MonteCarloError(CosineTree* node, const arma::mat& basis);
+
   /**
    * Constructs the final basis matrix, after the cosine tree construction.
    *
@@ -213,6 +237,12 @@ class CosineTree
   size_t SplitPointIndex() const { return indices[splitPointIndex]; }
 
  private:
+  //! Collect the basis vectors of all nodes in the queue as matrix columns.
+  static void QueueBasis(CosineNodeQueue& treeQueue, arma::mat& queueBasis);
+
+  //! Calculate the cumulative length-squared distribution of the columns.
+  void CalculateDistribution();
+
   //! Matrix for which cosine tree is constructed.
   const arma::mat& dataset;
   //! Cumulative probability for Monte Carlo error lower bound.
@@ -229,6 +259,8 @@ class CosineTree
   std::vector<size_t> indices;
   //! L2-norm squared of columns in the node.
   arma::vec l2NormsSquared;
+  //! Cumulative length-squared distribution of columns in the node.
+  arma::vec cDistribution;
   //! Centroid of columns of input matrix in the node.
   arma::vec centroid;
   //! Orthonormalized basis vector of the node.
@@ -13,6 +13,7 @@
 #include <boost/program_options.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <iostream>
+#include <fstream>
 
 #include "cli.hpp"
 #include "log.hpp"
@@ -61,14 +62,7 @@ CLI::~CLI()
   }
 
   // Terminate the program timers.
-  std::map<std::string, std::chrono::microseconds>::iterator it2;
-  for (it2 = timer.GetAllTimers().begin(); it2 != timer.GetAllTimers().end();
-       ++it2)
-  {
-    std::string i = (*it2).first;
-    if (timer.GetState(i) == 1)
-      Timer::Stop(i);
-  }
+  timer.StopAllTimers();
 
   // Did the user ask for verbose output?  If so we need to print everything.
   // But only if the user did not ask for help or info.
@@ -95,9 +89,10 @@ CLI::~CLI()
     }
 
     Log::Info << "Program timers:" << std::endl;
+    std::map<std::string, std::chrono::microseconds> timers =
+        timer.GetAllTimers();
     std::map<std::string, std::chrono::microseconds>::iterator it;
-    for (it = timer.GetAllTimers().begin(); it != timer.GetAllTimers().end();
-        ++it)
+    for (it = timers.begin(); it != timers.end(); ++it)
     {
       std::string i = (*it).first;
       Log::Info << "  " << i << ": ";
@@ -105,6 +100,18 @@ CLI::~CLI()
     }
   }
 
+  // Write the timers to a JSON file, if the user asked for it.
+  if (HasParam("timers_file") && !HasParam("help") && !HasParam("info"))
+  {
+    const std::string& filename = GetParam<std::string>("timers_file");
+    std::ofstream file(filename.c_str());
+    if (file.is_open())
+      timer.ToJSON(file);
+    else
+      Log::Warn << "Could not open '" << filename << "' for writing timers."
+          << std::endl;
+  }
+
   // Notify the user if we are debugging, but only if we actually parsed the
   // options.  This way this output doesn't show up inexplicably for someone who
   // may not have wanted it there, such as in Boost unit tests.
@@ -509,3 +516,6 @@ PARAM_STRING_IN("info", "Get help on a specific module or option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("timers_file", "If specified, write all program timers, with "
+    "call counts, minimum and maximum run times and nesting, to this file in "
+    "JSON format.", "", "");
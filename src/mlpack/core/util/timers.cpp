@@ -16,10 +16,54 @@
 
 #include <map>
 #include <string>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 using namespace mlpack;
 using namespace std::chrono;
 
+// Ids are never zero, so that a zero-initialized per-thread cache never
+// matches a live Timers object.
+std::atomic<size_t> Timers::nextId(1);
+
+namespace {
+
+//! The id of the "total_time" timer, which is registered first.
+const size_t totalTimeId = 0;
+
+//! Escape a string so that it can be written as a JSON string literal.
+std::string EscapeJSON(const std::string& str)
+{
+  std::ostringstream out;
+  for (size_t i = 0; i < str.size(); ++i)
+  {
+    const char c = str[i];
+    if (c == '"' || c == '\\')
+      out << '\\' << c;
+    else if (c == '\n')
+      out << "\\n";
+    else if (c == '\t')
+      out << "\\t";
+    else if ((unsigned char) c < 0x20)
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << (int) c << std::dec;
+    else
+      out << c;
+  }
+  return out.str();
+}
+
+} // anonymous namespace
+
+/**
+ * Get the handle of the given timer.
+ */
+TimerHandle Timer::Handle(const std::string& name)
+{
+  return CLI::GetSingleton().timer.Handle(name);
+}
+
 /**
  * Start the given timer.
  */
@@ -28,6 +72,14 @@ void Timer::Start(const std::string& name)
   CLI::GetSingleton().timer.StartTimer(name);
 }
 
+/**
+ * Start the given timer.
+ */
+void Timer::Start(const TimerHandle& handle)
+{
+  CLI::GetSingleton().timer.StartTimer(handle);
+}
+
 /**
  * Stop the given timer.
  */
@@ -36,6 +88,14 @@ void Timer::Stop(const std::string& name)
   CLI::GetSingleton().timer.StopTimer(name);
 }
 
+/**
+ * Stop the given timer.
+ */
+void Timer::Stop(const TimerHandle& handle)
+{
+  CLI::GetSingleton().timer.StopTimer(handle);
+}
+
 /**
  * Get the given timer.
  */
@@ -44,24 +104,160 @@ microseconds Timer::Get(const std::string& name)
   return CLI::GetSingleton().timer.GetTimer(name);
 }
 
-std::map<std::string, microseconds>& Timers::GetAllTimers()
+/**
+ * Get the given timer.
+ */
+microseconds Timer::Get(const TimerHandle& handle)
+{
+  return CLI::GetSingleton().timer.GetTimer(handle);
+}
+
+/**
+ * Get the statistics of the given timer.
+ */
+TimerStatistics Timer::GetStatistics(const std::string& name)
+{
+  std::map<std::string, TimerStatistics> statistics =
+      CLI::GetSingleton().timer.GetAllStatistics();
+  std::map<std::string, TimerStatistics>::const_iterator it =
+      statistics.find(name);
+  return (it == statistics.end()) ? TimerStatistics() : it->second;
+}
+
+/**
+ * Write all timers in JSON format.
+ */
+void Timer::ToJSON(std::ostream& stream)
+{
+  CLI::GetSingleton().timer.ToJSON(stream);
+}
+
+Timers::Timers() : id(nextId++)
+{
+  // Register "total_time" first so that it has id totalTimeId.
+  Handle("total_time");
+}
+
+TimerHandle Timers::Handle(const std::string& timerName)
+{
+  std::lock_guard<std::mutex> lock(registryLock);
+
+  std::map<std::string, size_t>::const_iterator it = handles.find(timerName);
+  if (it != handles.end())
+    return TimerHandle(it->second);
+
+  const size_t timerId = names.size();
+  names.push_back(timerName);
+  handles[timerName] = timerId;
+  return TimerHandle(timerId);
+}
+
+std::string Timers::Name(const size_t timerId)
+{
+  std::lock_guard<std::mutex> lock(registryLock);
+  return (timerId < names.size()) ? names[timerId] : std::string();
+}
+
+Timers::ThreadTimers& Timers::LocalTimers()
+{
+  // Each thread caches a pointer to its own records, so the registry lock is
+  // only taken the first time a thread uses the timers.  The owner id makes
+  // sure the cache is not used after the CLI singleton has been recreated.
+  static thread_local size_t cachedOwner = 0;
+  static thread_local ThreadTimers* cachedTimers = NULL;
+
+  if (cachedOwner != id)
+  {
+    std::lock_guard<std::mutex> lock(registryLock);
+    threadTimers.emplace_back(new ThreadTimers());
+    cachedTimers = threadTimers.back().get();
+    cachedOwner = id;
+  }
+
+  return *cachedTimers;
+}
+
+std::map<std::string, TimerStatistics> Timers::MergeStatistics()
 {
+  std::map<std::string, TimerStatistics> statistics;
+  for (size_t t = 0; t < threadTimers.size(); ++t)
+  {
+    ThreadTimers& local = *threadTimers[t];
+    std::lock_guard<std::mutex> lock(local.lock);
+    for (size_t i = 0; i < local.records.size(); ++i)
+    {
+      const TimerRecord& record = local.records[i];
+      if (!record.seen)
+        continue;
+
+      TimerStatistics& s = statistics[names[i]];
+      if (s.parent.empty() && record.parent != size_t(-1))
+        s.parent = names[record.parent];
+
+      if (record.calls == 0)
+        continue;
+
+      s.min = (s.calls == 0) ? record.min : std::min(s.min, record.min);
+      s.max = std::max(s.max, record.max);
+      s.total += record.total;
+      s.calls += record.calls;
+      ++s.threads;
+    }
+  }
+
+  return statistics;
+}
+
+std::map<std::string, microseconds> Timers::GetAllTimers()
+{
+  std::map<std::string, TimerStatistics> statistics = GetAllStatistics();
+
+  std::map<std::string, microseconds> timers;
+  std::map<std::string, TimerStatistics>::const_iterator it;
+  for (it = statistics.begin(); it != statistics.end(); ++it)
+    timers[it->first] = it->second.total;
+
   return timers;
 }
 
+std::map<std::string, TimerStatistics> Timers::GetAllStatistics()
+{
+  std::lock_guard<std::mutex> lock(registryLock);
+  return MergeStatistics();
+}
+
 microseconds Timers::GetTimer(const std::string& timerName)
 {
-  return timers[timerName];
+  return GetTimer(Handle(timerName));
+}
+
+microseconds Timers::GetTimer(const TimerHandle& handle)
+{
+  std::lock_guard<std::mutex> lock(registryLock);
+
+  microseconds total(0);
+  for (size_t t = 0; t < threadTimers.size(); ++t)
+  {
+    ThreadTimers& local = *threadTimers[t];
+    std::lock_guard<std::mutex> localLock(local.lock);
+    if (handle.ID() < local.records.size())
+      total += local.records[handle.ID()].total;
+  }
+
+  return total;
 }
 
 bool Timers::GetState(std::string timerName)
 {
-  return timerState[timerName];
+  const size_t timerId = Handle(timerName).ID();
+  ThreadTimers& local = LocalTimers();
+  std::lock_guard<std::mutex> lock(local.lock);
+  return (timerId < local.records.size()) && local.records[timerId].running;
 }
 
 void Timers::PrintTimer(const std::string& timerName)
 {
-  microseconds totalDuration = timers[timerName];
+  microseconds totalDuration = GetTimer(timerName);
   // Convert microseconds to seconds.
   seconds totalDurationSec = duration_cast<seconds>(totalDuration);
   microseconds totalDurationMicroSec =
@@ -127,42 +323,145 @@ high_resolution_clock::time_point Timers::GetTime()
 
 void Timers::StartTimer(const std::string& timerName)
 {
-  if ((timerState[timerName] == 1) && (timerName != "total_time"))
+  StartTimer(Handle(timerName));
+}
+
+void Timers::StartTimer(const TimerHandle& handle)
+{
+  if (!handle.IsValid())
+    throw std::runtime_error("Timer::Start(): invalid timer handle");
+
+  const size_t timerId = handle.ID();
+  ThreadTimers& local = LocalTimers();
   {
-    std::ostringstream error;
-    error << "Timer::Start(): timer '" << timerName
-        << "' has already been started";
-    throw std::runtime_error(error.str());
+    std::lock_guard<std::mutex> lock(local.lock);
+    if (local.records.size() <= timerId)
+      local.records.resize(timerId + 1);
+
+    TimerRecord& record = local.records[timerId];
+    if (!record.running || timerId == totalTimeId)
+    {
+      if (!record.running)
+      {
+        // The innermost running timer on this thread is the parent.
+        if (!record.seen && !local.active.empty())
+          record.parent = local.active.back();
+        local.active.push_back(timerId);
+      }
+
+      record.seen = true;
+      record.running = true;
+      record.startTime = GetTime();
+      return;
+    }
   }
 
-  timerState[timerName] = true;
+  // The lock is released before looking up the name; the registry lock is
+  // always taken before a thread's lock.
+  std::ostringstream error;
+  error << "Timer::Start(): timer '" << Name(timerId)
+      << "' has already been started";
+  throw std::runtime_error(error.str());
+}
+
+void Timers::StopTimer(const std::string& timerName)
+{
+  StopTimer(Handle(timerName));
+}
 
-  high_resolution_clock::time_point currTime = GetTime();
+void Timers::StopTimer(const TimerHandle& handle)
+{
+  if (!handle.IsValid())
+    throw std::runtime_error("Timer::Stop(): invalid timer handle");
 
-  // If the timer is added first time
-  if (timers.count(timerName) == 0)
+  const high_resolution_clock::time_point currTime = GetTime();
+
+  const size_t timerId = handle.ID();
+  ThreadTimers& local = LocalTimers();
   {
-    timers[timerName] = (microseconds) 0;
+    std::lock_guard<std::mutex> lock(local.lock);
+    if (timerId < local.records.size() && local.records[timerId].running)
+    {
+      StopRecord(local, timerId, currTime);
+      return;
+    }
+    else if (timerId == totalTimeId)
+    {
+      return;
+    }
   }
 
-  timerStartTime[timerName] = currTime;
+  std::ostringstream error;
+  error << "Timer::Stop(): timer '" << Name(timerId)
+      << "' has already been stopped";
+  throw std::runtime_error(error.str());
 }
 
-void Timers::StopTimer(const std::string& timerName)
+void Timers::StopRecord(ThreadTimers& local,
+                        const size_t timerId,
+                        const high_resolution_clock::time_point& time)
 {
-  if ((timerState[timerName] == 0) && (timerName != "total_time"))
+  TimerRecord& record = local.records[timerId];
+
+  // Calculate the delta time.
+  const microseconds delta = duration_cast<microseconds>(time -
+      record.startTime);
+  record.total += delta;
+  record.min = std::min(record.min, delta);
+  record.max = std::max(record.max, delta);
+  ++record.calls;
+  record.running = false;
+
+  // Timers are usually stopped in reverse order, so search from the back.
+  for (size_t i = local.active.size(); i > 0; --i)
   {
-    std::ostringstream error;
-    error << "Timer::Stop(): timer '" << timerName
-        << "' has already been stopped";
-    throw std::runtime_error(error.str());
+    if (local.active[i - 1] == timerId)
+    {
+      local.active.erase(local.active.begin() + (i - 1));
+      break;
+    }
   }
+}
+
+void Timers::StopAllTimers()
+{
+  const high_resolution_clock::time_point currTime = GetTime();
 
-  timerState[timerName] = false;
+  std::lock_guard<std::mutex> lock(registryLock);
+  for (size_t t = 0; t < threadTimers.size(); ++t)
+  {
+    ThreadTimers& local = *threadTimers[t];
+    std::lock_guard<std::mutex> localLock(local.lock);
+    for (size_t i = 0; i < local.records.size(); ++i)
+      if (local.records[i].running)
+        StopRecord(local, i, currTime);
+  }
+}
 
-  high_resolution_clock::time_point currTime = GetTime();
+void Timers::ToJSON(std::ostream& stream)
+{
+  std::map<std::string, TimerStatistics> statistics = GetAllStatistics();
 
-  // Calculate the delta time.
-  timers[timerName] += duration_cast<microseconds>(currTime -
-      timerStartTime[timerName]);
+  stream << "{" << std::endl << "  \"timers\": [";
+  std::map<std::string, TimerStatistics>::const_iterator it;
+  for (it = statistics.begin(); it != statistics.end(); ++it)
+  {
+    const TimerStatistics& s = it->second;
+    stream << ((it == statistics.begin()) ? "" : ",") << std::endl;
+    stream << "    {" << std::endl;
+    stream << "      \"name\": \"" << EscapeJSON(it->first) << "\","
+        << std::endl;
+    if (s.parent.empty())
+      stream << "      \"parent\": null," << std::endl;
+    else
+      stream << "      \"parent\": \"" << EscapeJSON(s.parent) << "\","
+          << std::endl;
+    stream << "      \"total_us\": " << s.total.count() << "," << std::endl;
+    stream << "      \"calls\": " << s.calls << "," << std::endl;
+    stream << "      \"min_us\": " << s.min.count() << "," << std::endl;
+    stream << "      \"max_us\": " << s.max.count() << "," << std::endl;
+    stream << "      \"threads\": " << s.threads << std::endl;
+    stream << "    }";
+  }
+  stream << std::endl << "  ]" << std::endl << "}" << std::endl;
 }
@@ -15,6 +15,11 @@
 
 #include <map>
 #include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <ostream>
 #include <chrono> // chrono library for cross platform timer calculation
 
 #if defined(_WIN32)
@@ -30,14 +35,81 @@
 
 namespace mlpack {
 
+/**
+ * An interned reference to a named timer.  A handle is obtained once with
+ * Timer::Handle() and can then be used to start and stop the timer without
+ * any string lookups, which makes it suitable for use in tight loops and in
+ * OpenMP parallel regions.
+ */
+class TimerHandle
+{
+ public:
+  //! Create an invalid handle.
+  TimerHandle() : id(size_t(-1)) { }
+
+  //! Create a handle referring to the timer with the given internal id.
+  explicit TimerHandle(const size_t id) : id(id) { }
+
+  //! Get the internal id of the timer.
+  size_t ID() const { return id; }
+
+  //! Return whether or not this handle refers to a timer.
+  bool IsValid() const { return id != size_t(-1); }
+
+ private:
+  //! The internal id of the timer.
+  size_t id;
+};
+
+/**
+ * Statistics of a single timer, merged over all threads that ran it.
+ */
+struct TimerStatistics
+{
+  //! Total time accumulated over all runs.
+  std::chrono::microseconds total;
+  //! Shortest single run (zero if the timer was never stopped).
+  std::chrono::microseconds min;
+  //! Longest single run.
+  std::chrono::microseconds max;
+  //! Number of completed runs.
+  size_t calls;
+  //! Number of threads that completed at least one run.
+  size_t threads;
+  //! Name of the enclosing timer when the timer was first started (empty if
+  //! it was started outside of any other timer).
+  std::string parent;
+
+  TimerStatistics() :
+      total(0), min(0), max(0), calls(0), threads(0) { }
+};
+
 /**
  * The timer class provides a way for mlpack methods to be timed.  The three
  * methods contained in this class allow a named timer to be started and
  * stopped, and its value to be obtained.
+ *
+ * Timers are accumulated separately for each thread and merged when they are
+ * queried, so it is safe to start and stop timers from inside OpenMP parallel
+ * regions.  A timer must be stopped by the same thread that started it.  For
+ * timers that are run very often, obtain a TimerHandle once with Handle() and
+ * use the handle overloads (or a ScopedTimer) to avoid the string lookup.
+ *
+ * Timers started while another timer is running on the same thread are
+ * recorded as nested in that timer; this hierarchy is reported by
+ * Timers::ToJSON().
  */
 class Timer
 {
  public:
+  /**
+   * Get the handle of the given timer, registering it if it does not exist
+   * yet.  The handle stays valid for the lifetime of the program.
+   *
+   * @param name Name of the timer.
+   */
+  static TimerHandle Handle(const std::string& name);
+
   /**
    * Start the given timer.  If a timer is started, then stopped, then
    * re-started, then re-stopped, the final value of the timer is the length of
@@ -51,6 +123,9 @@ class Timer
    */
   static void Start(const std::string& name);
 
+  //! Start the given timer by handle.  See Start(const std::string&).
+  static void Start(const TimerHandle& handle);
+
   /**
    * Stop the given timer.
    *
@@ -61,24 +136,99 @@ class Timer
    */
   static void Stop(const std::string& name);
 
+  //! Stop the given timer by handle.  See Stop(const std::string&).
+  static void Stop(const TimerHandle& handle);
+
   /**
-   * Get the value of the given timer.
+   * Get the value of the given timer, summed over all threads.
    *
    * @param name Name of timer to return value of.
    */
   static std::chrono::microseconds Get(const std::string& name);
+
+  //! Get the value of the given timer by handle.
+  static std::chrono::microseconds Get(const TimerHandle& handle);
+
+  /**
+   * Get the call count, minimum and maximum run time, and parent of the given
+   * timer, merged over all threads.
+   *
+   * @param name Name of timer to return statistics of.
+   */
+  static TimerStatistics GetStatistics(const std::string& name);
+
+  /**
+   * Write all timers to the given stream in JSON format.  See
+   * Timers::ToJSON().
+   *
+   * @param stream Stream to write to.
+   */
+  static void ToJSON(std::ostream& stream);
+};
+
+/**
+ * Start a timer on construction and stop it on destruction, so that a scope
+ * can be timed even if it is left through an exception.
+ *
+ * @code
+ * static const TimerHandle handle = Timer::Handle("base_cases");
+ * {
+ *   ScopedTimer t(handle);
+ *   // ... timed work ...
+ * }
+ * @endcode
+ */
+class ScopedTimer
+{
+ public:
+  //! Start the timer with the given handle.
+  explicit ScopedTimer(const TimerHandle& handle) : handle(handle)
+  {
+    Timer::Start(handle);
+  }
+
+  //! Start the timer with the given name.
+  explicit ScopedTimer(const std::string& name) : handle(Timer::Handle(name))
+  {
+    Timer::Start(handle);
+  }
+
+  //! Stop the timer.
+  ~ScopedTimer() { Timer::Stop(handle); }
+
+ private:
+  //! The timer being run.
+  TimerHandle handle;
+
+  // Scoped timers cannot be copied.
+  ScopedTimer(const ScopedTimer&);
+  ScopedTimer& operator=(const ScopedTimer&);
 };
 
 class Timers
 {
  public:
-  //! Nothing to do for the constructor.
-  Timers() { }
+  //! Give this object a unique id; nothing else to do.
+  Timers();
+
+  /**
+   * Returns the handle of the given timer, registering it if necessary.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  TimerHandle Handle(const std::string& timerName);
+
+  /**
+   * Returns a copy of all the timers used via this interface, summed over all
+   * threads.
+   */
+  std::map<std::string, std::chrono::microseconds> GetAllTimers();
 
   /**
-   * Returns a copy of all the timers used via this interface.
+   * Returns the statistics of all the timers used via this interface, merged
+   * over all threads.
    */
-  std::map<std::string, std::chrono::microseconds>& GetAllTimers();
+  std::map<std::string, TimerStatistics> GetAllStatistics();
 
   /**
    * Returns a copy of the timer specified.
@@ -87,6 +237,9 @@ class Timers
    */
   std::chrono::microseconds GetTimer(const std::string& timerName);
 
+  //! Returns a copy of the timer specified by handle.
+  std::chrono::microseconds GetTimer(const TimerHandle& handle);
+
   /**
    * Prints the specified timer.  If it took longer than a minute to complete
    * the timer will be displayed in days, hours, and minutes as well.
@@ -105,6 +258,9 @@ class Timers
    */
   void StartTimer(const std::string& timerName);
 
+  //! Start the timer specified by handle on the calling thread.
+  void StartTimer(const TimerHandle& handle);
+
   /**
    * Halts the timer, and replaces it's value with
    * the delta time from it's start
@@ -113,21 +269,86 @@ class Timers
    */
   void StopTimer(const std::string& timerName);
 
+  //! Stop the timer specified by handle on the calling thread.
+  void StopTimer(const TimerHandle& handle);
+
   /**
-   * Returns state of the given timer.
+   * Stops every running timer on every thread.  This should only be called
+   * when no other thread is using the timers (i.e. at program exit).
+   */
+  void StopAllTimers();
+
+  /**
+   * Returns state of the given timer on the calling thread.
    *
    * @param timerName The name of the timer in question.
    */
   bool GetState(std::string timerName);
 
+  /**
+   * Write all timers, with their call counts, minimum and maximum run times,
+   * number of threads and parent timer, to the given stream as a JSON object.
+   *
+   * @param stream Stream to write to.
+   */
+  void ToJSON(std::ostream& stream);
+
  private:
-  //! A map of all the timers that are being tracked.
-  std::map<std::string, std::chrono::microseconds> timers;
-  //! A map that contains whether or not each timer is currently running.
-  std::map<std::string, bool> timerState;
-  //! A map for the starting values of the timers.
-  std::map<std::string, std::chrono::high_resolution_clock::time_point>
-      timerStartTime;
+  //! Everything a single thread records about a single timer.
+  struct TimerRecord
+  {
+    TimerRecord() :
+        total(0), min(std::chrono::microseconds::max()), max(0), calls(0),
+        running(false), seen(false), parent(size_t(-1)) { }
+
+    std::chrono::microseconds total;
+    std::chrono::microseconds min;
+    std::chrono::microseconds max;
+    size_t calls;
+    bool running;
+    bool seen;
+    size_t parent;
+    std::chrono::high_resolution_clock::time_point startTime;
+  };
+
+  //! The timers of a single thread.  The lock is only ever contended while
+  //! the timers are being merged for output.
+  struct ThreadTimers
+  {
+    std::mutex lock;
+    //! Records, indexed by timer id.
+    std::vector<TimerRecord> records;
+    //! Ids of the timers that are currently running, innermost last.
+    std::vector<size_t> active;
+  };
+
+  //! Unique id of this object, used to validate the per-thread cache.
+  const size_t id;
+  //! Source of unique ids.
+  static std::atomic<size_t> nextId;
+
+  //! Protects names, handles and threadTimers.
+  std::mutex registryLock;
+  //! Timer names, indexed by timer id.
+  std::vector<std::string> names;
+  //! Map from timer names to timer ids.
+  std::map<std::string, size_t> handles;
+  //! The timers of every thread that has used this object.
+  std::vector<std::unique_ptr<ThreadTimers>> threadTimers;
+
+  //! Get the timers of the calling thread, creating them if necessary.
+  ThreadTimers& LocalTimers();
+
+  //! Get the name of the timer with the given id.
+  std::string Name(const size_t timerId);
+
+  //! Stop the given timer in the given thread's timers (the lock must be held).
+  void StopRecord(ThreadTimers& local,
+                  const size_t timerId,
+                  const std::chrono::high_resolution_clock::time_point& time);
+
+  //! Merge the statistics of all threads (the registry lock must be held).
+  std::map<std::string, TimerStatistics> MergeStatistics();
 
   std::chrono::high_resolution_clock::time_point GetTime();
 };
@@ -0,0 +1,253 @@
+/**
+ * @file weighted_als.hpp
+ *
+ * Weighted alternating least squares update rule for sparse rating matrices.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_WEIGHTED_ALS_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_WEIGHTED_ALS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements regularized alternating least squares for matrices
+ * where only the nonzero entries are observed.  Each row of W and each column
+ * of H is the solution of its own small rank x rank least squares problem,
+ * which involves only the observed entries of the corresponding row or column
+ * of V; these problems are independent, so they are solved in parallel with
+ * OpenMP.
+ *
+ * Two models are supported.  With explicit feedback (alpha = 0), only the
+ * observed ratings contribute to the loss, and the regularization of each row
+ * or column is scaled by its number of observations, as in
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title={Large-scale parallel collaborative filtering for the Netflix
+ *       prize},
+ *   author={Zhou, Y. and Wilkinson, D. and Schreiber, R. and Pan, R.},
+ *   booktitle={Algorithmic Aspects in Information and Management},
+ *   pages={337--348},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * With implicit feedback (alpha > 0), every entry contributes: observed entries
+ * have preference 1 and confidence 1 + alpha * V(i, j), and all other entries
+ * have preference 0 and confidence 1, as in
+ *
+ * @code
+ * @inproceedings{hu2008collaborative,
+ *   title={Collaborative filtering for implicit feedback datasets},
+ *   author={Hu, Y. and Koren, Y. and Volinsky, C.},
+ *   booktitle={Eighth IEEE International Conference on Data Mining},
+ *   pages={263--272},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * In that case the Gram matrix of the fixed factors is computed once per
+ * update and each subproblem only corrects it with its observed entries, so
+ * the cost stays linear in the number of nonzeros.
+ */
+class WeightedALSUpdate
+{
+ public:
+  /**
+   * Create the update rule with the given parameters.
+   *
+   * @param lambda Regularization parameter.
+   * @param alpha Confidence scaling for implicit feedback; 0 means explicit
+   *     feedback.
+   */
+  WeightedALSUpdate(const double lambda = 0.1, const double alpha = 0.0) :
+      lambda(lambda),
+      alpha(alpha)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Set initial values for the factorization.  In this case, we don't need to
+   * set anything.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& /* dataset */, const size_t /* rank */)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * The update rule for the basis matrix W.  Each row of W is solved for with H
+   * fixed, using the observed entries of the corresponding row of V.  Dense
+   * matrices are treated as sparse, with zeros unobserved.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  inline void WUpdate(const MatType& V,
+                      arma::mat& W,
+                      const arma::mat& H)
+  {
+    WUpdate(arma::sp_mat(V), W, H);
+  }
+
+  /**
+   * The update rule for the encoding matrix H.  Each column of H is solved for
+   * with W fixed, using the observed entries of the corresponding column of V.
+   * Dense matrices are treated as sparse, with zeros unobserved.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  inline void HUpdate(const MatType& V,
+                      const arma::mat& W,
+                      arma::mat& H)
+  {
+    HUpdate(arma::sp_mat(V), W, H);
+  }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Get the implicit feedback confidence scaling (0 for explicit feedback).
+  double Alpha() const { return alpha; }
+  //! Modify the implicit feedback confidence scaling (0 for explicit feedback).
+  double& Alpha() { return alpha; }
+
+  //! Serialize the WeightedALSUpdate object.
+  template<typename Archive>
+  void Serialize(Archive& ar, const unsigned int /* version */)
+  {
+    using data::CreateNVP;
+    ar & CreateNVP(lambda, "lambda");
+    ar & CreateNVP(alpha, "alpha");
+  }
+
+ private:
+  /**
+   * Solve for every column of 'factors' given the fixed factors, where column j
+   * of 'factors' is fit to the observed entries of column j of V, and row i of
+   * V corresponds to column i of 'fixed'.
+   *
+   * @param V Sparse matrix of observations.
+   * @param fixed Fixed factors (rank x V.n_rows).
+   * @param factors Factors to solve for (rank x V.n_cols).
+   */
+  void Solve(const arma::sp_mat& V,
+             const arma::mat& fixed,
+             arma::mat& factors) const
+  {
+    const size_t rank = fixed.n_rows;
+    factors.set_size(rank, V.n_cols);
+
+    // With implicit feedback, every subproblem starts from the Gram matrix of
+    // all the fixed factors.
+    arma::mat gram;
+    if (alpha > 0.0)
+      gram = fixed * fixed.t();
+
+    // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+    // loop variables.
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (intmax_t j = 0; j < (intmax_t) V.n_cols; ++j)
+    {
+      // Gather the fixed factors and values of the observed entries.
+      std::vector<arma::uword> rows;
+      std::vector<double> values;
+      arma::sp_mat::const_col_iterator it = V.begin_col(j);
+      for ( ; it != V.end_col(j); ++it)
+      {
+        rows.push_back(it.row());
+        values.push_back(*it);
+      }
+
+      arma::mat observed(rank, rows.size());
+      for (size_t k = 0; k < rows.size(); ++k)
+        observed.col(k) = fixed.col(rows[k]);
+      const arma::vec v(values);
+
+      arma::mat a;
+      arma::vec b;
+      if (alpha > 0.0)
+      {
+        // A = F F' + F_obs (C - I) F_obs' + lambda I, b = F_obs C p, with
+        // C = 1 + alpha * v and p = 1 on the observed entries.
+        const arma::vec confidence = 1.0 + alpha * v;
+        a = gram;
+        if (rows.size() > 0)
+        {
+          arma::mat scaled = observed;
+          scaled.each_row() %= (alpha * v).t();
+          a += scaled * observed.t();
+        }
+        b = observed * confidence;
+        a.diag() += lambda;
+      }
+      else
+      {
+        // A column with no observations has nothing to fit.
+        if (rows.size() == 0)
+        {
+          factors.col(j).zeros();
+          continue;
+        }
+
+        a = observed * observed.t();
+        b = observed * v;
+        a.diag() += lambda * rows.size();
+      }
+
+      arma::vec solution;
+      if (arma::solve(solution, a, b))
+        factors.col(j) = solution;
+      else
+        factors.col(j).zeros();
+    }
+  }
+
+  //! Regularization parameter.
+  double lambda;
+  //! Confidence scaling for implicit feedback (0 for explicit feedback).
+  double alpha;
+}; // class WeightedALSUpdate
+
+//! Update W from the observed entries of each row of V; V is transposed once
+//! so that its rows can be walked as sparse columns.
+template<>
+inline void WeightedALSUpdate::WUpdate<arma::sp_mat>(const arma::sp_mat& V,
+                                                     arma::mat& W,
+                                                     const arma::mat& H)
+{
+  const arma::sp_mat vt = V.t();
+  arma::mat wt;
+  Solve(vt, H, wt);
+  W = wt.t();
+}
+
+//! Update H from the observed entries of each column of V.
+template<>
+inline void WeightedALSUpdate::HUpdate<arma::sp_mat>(const arma::sp_mat& V,
+                                                     const arma::mat& W,
+                                                     arma::mat& H)
+{
+  Solve(V, W.t(), H);
+}
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
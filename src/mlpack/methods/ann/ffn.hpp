@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "visitor/batch_support_visitor.hpp"
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
 #include "visitor/output_height_visitor.hpp"
@@ -154,6 +155,42 @@ class FFN
                 const size_t i,
                 arma::mat& gradient);
 
+  /**
+   * Evaluate the feedforward network with the given parameters on the points
+   * begin, ..., begin + batchSize - 1 in a single forward pass, returning the
+   * sum of the objective over these points.  This is used by MiniBatchSGD.
+   * A single pass is only possible if all layers of the network (and the
+   * output layer) accept one point per input column (see IsBatchLayer; this is
+   * the case for the linear, activation, dropout and softmax layers, but not
+   * for the convolution and pooling layers).  Otherwise, the points are
+   * evaluated one at a time.
+   *
+   * @param parameters Matrix model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Evaluate the gradient of the feedforward network with the given
+   * parameters, summed over the points begin, ..., begin + batchSize - 1, with
+   * a single forward and backward pass.  This is used by MiniBatchSGD.  See
+   * Evaluate(parameters, begin, batchSize) for the requirements on the layers;
+   * if they are not met, the gradients of the points are computed one at a
+   * time.
+   *
+   * @param parameters Matrix of the model parameters to be optimized.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   * @param gradient Matrix to output gradient into.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                const size_t batchSize,
+                arma::mat& gradient);
+
   /*
    * Add a new module to the model.
    *
@@ -219,6 +256,20 @@ private:
    */
   void ResetGradients(arma::mat& gradient);
 
+  /**
+   * Run the forward pass on the points begin, ..., begin + batchSize - 1 and
+   * return the objective, in the given mode.
+   */
+  double EvaluateBatch(const size_t begin,
+                       const size_t batchSize,
+                       const bool deterministic);
+
+  /**
+   * Return true if all layers of the network and the output layer can process
+   * a batch of points in a single pass.
+   */
+  bool SupportsBatches() const;
+
   //! Instantiated outputlayer used to evaluate the network.
   OutputLayerType outputLayer;
 
@@ -216,6 +216,105 @@ void FFN<OutputLayerType, InitializationRuleType>::Gradient(
   Gradient();
 }
 
+template<typename OutputLayerType, typename InitializationRuleType>
+double FFN<OutputLayerType, InitializationRuleType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize)
+{
+  if (SupportsBatches())
+    return EvaluateBatch(begin, batchSize, true);
+
+  double objective = 0;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+    objective += Evaluate(parameters, i);
+
+  return objective;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType>
+void FFN<OutputLayerType, InitializationRuleType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize,
+    arma::mat& gradient)
+{
+  if (!SupportsBatches())
+  {
+    arma::mat pointGradient;
+    Gradient(parameters, begin, gradient);
+    for (size_t i = begin + 1; i < begin + batchSize; ++i)
+    {
+      Gradient(parameters, i, pointGradient);
+      gradient += pointGradient;
+    }
+
+    return;
+  }
+
+  if (gradient.is_empty())
+  {
+    if (parameter.is_empty())
+    {
+      ResetParameters();
+    }
+
+    gradient = arma::zeros<arma::mat>(parameter.n_rows, parameter.n_cols);
+  }
+  else
+  {
+    gradient.zeros();
+  }
+
+  EvaluateBatch(begin, batchSize, false);
+
+  outputLayer.Backward(std::move(boost::apply_visitor(outputParameterVisitor,
+      network.back())), std::move(currentTarget), std::move(error));
+
+  Backward();
+  ResetGradients(gradient);
+  Gradient();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType>
+double FFN<OutputLayerType, InitializationRuleType>::EvaluateBatch(
+    const size_t begin, const size_t batchSize, const bool deterministic)
+{
+  if (parameter.is_empty())
+  {
+    ResetParameters();
+  }
+
+  if (deterministic != this->deterministic)
+  {
+    this->deterministic = deterministic;
+    ResetDeterministic();
+  }
+
+  // The buffers are only reallocated when the batch size changes.
+  currentInput = predictors.cols(begin, begin + batchSize - 1);
+  currentTarget = responses.cols(begin, begin + batchSize - 1);
+
+  Forward(std::move(currentInput));
+  return outputLayer.Forward(std::move(boost::apply_visitor(
+      outputParameterVisitor, network.back())), std::move(currentTarget));
+}
+
+template<typename OutputLayerType, typename InitializationRuleType>
+bool FFN<OutputLayerType, InitializationRuleType>::SupportsBatches() const
+{
+  if (!IsBatchLayer<OutputLayerType>::value)
+    return false;
+
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    if (!boost::apply_visitor(BatchSupportVisitor(), network[i]))
+      return false;
+  }
+
+  return true;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType>
 void FFN<OutputLayerType, InitializationRuleType>::ResetParameters()
 {
@@ -48,7 +48,9 @@ template<typename eT>
 void Linear<InputDataType, OutputDataType>::Forward(
     const arma::Mat<eT>&& input, arma::Mat<eT>&& output)
 {
-  output = (weight * input) + bias;
+  // Each column of the input is a separate point.
+  output = weight * input;
+  output.each_col() += bias;
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -68,7 +70,8 @@ void Linear<InputDataType, OutputDataType>::Gradient(
 {
   gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::vectorise(
       error * input.t());
-  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) = error;
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
+      arma::sum(error, 1);
 }
 
 template<typename InputDataType, typename OutputDataType>
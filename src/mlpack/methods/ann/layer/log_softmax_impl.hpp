@@ -57,7 +57,9 @@ void LogSoftMax<InputDataType, OutputDataType>::Forward(
     return 0.0;
   } );
 
-  output = input - (maxInput + std::log(arma::accu(output)));
+  // Normalize each column (point) separately.
+  output = input - (maxInput + arma::repmat(arma::log(arma::sum(output)),
+      input.n_rows, 1));
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -67,7 +69,7 @@ void LogSoftMax<InputDataType, OutputDataType>::Backward(
     arma::Mat<eT>&& gy,
     arma::Mat<eT>&& g)
 {
-  g = gy - arma::exp(input) * arma::accu(gy);
+  g = gy - arma::exp(input) % arma::repmat(arma::sum(gy), input.n_rows, 1);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -164,24 +164,6 @@ class LSTM
   //! Locally-stored output 2 gate module.
   LayerTypes output2GateModule;
 
-  //! Locally-stored input gate module.
-  LayerTypes inputGateModule;
-
-  //! Locally-stored hidden state module.
-  LayerTypes hiddenStateModule;
-
-  //! Locally-stored forget gate module.
-  LayerTypes forgetGateModule;
-
-  //! Locally-stored output gate module.
-  LayerTypes outputGateModule;
-
-  //! Locally-stored cell module.
-  LayerTypes cellModule;
-
-  //! Locally-stored cell activation module.
-  LayerTypes cellActivationModule;
-
   //! Locally-stored output parameter visitor.
   OutputParameterVisitor outputParameterVisitor;
 
@@ -200,10 +182,19 @@ class LSTM
   //! Locally-stored number of gradient steps.
   size_t gradientStep;
 
-  //! Locally-stored cell parameters.
+  //! Locally-stored gate activations (input gate, hidden state, forget gate
+  //! and output gate, stacked) of each time step.
+  std::vector<arma::mat> gateActivation;
+
+  //! Locally-stored cell activation of each time step.
+  std::vector<arma::mat> cellActivation;
+
+  //! Locally-stored cell state at the beginning of each time step (one
+  //! preallocated buffer per step).
   std::vector<arma::mat> cellParameter;
 
-  //! Locally-stored output parameters.
+  //! Locally-stored output at the beginning of each time step (one
+  //! preallocated buffer per step).
   std::vector<arma::mat> outParameter;
 
   //! Locally-stored previous error.
@@ -42,28 +42,14 @@ LSTM<InputDataType, OutputDataType>::LSTM(
     gradientStep(0),
     deterministic(false)
 {
+  // The weights of all four gates are stacked, so the gate pre-activations are
+  // computed with one product with the input and one with the previous output.
   input2GateModule = new Linear<>(inSize, 4 * outSize);
   output2GateModule = new LinearNoBias<>(outSize, 4 * outSize);
 
   network.push_back(input2GateModule);
   network.push_back(output2GateModule);
 
-  inputGateModule = new SigmoidLayer<>();
-  hiddenStateModule = new TanHLayer<>();
-  forgetGateModule = new SigmoidLayer<>();
-  outputGateModule = new SigmoidLayer<>();
-
-  network.push_back(inputGateModule);
-  network.push_back(hiddenStateModule);
-  network.push_back(forgetGateModule);
-  network.push_back(outputGateModule);
-
-  cellModule = new IdentityLayer<>();
-  cellActivationModule = new TanHLayer<>();
-
-  network.push_back(cellModule);
-  network.push_back(cellActivationModule);
-
   prevOutput = arma::zeros<arma::mat>(outSize, 1);
   prevCell = arma::zeros<arma::mat>(outSize, 1);
   prevError = arma::zeros<arma::mat>(4 * outSize, 1);
@@ -75,15 +61,37 @@ template<typename eT>
 void LSTM<InputDataType, OutputDataType>::Forward(
     arma::Mat<eT>&& input, arma::Mat<eT>&& output)
 {
-  if (!deterministic)
+  // Every column of the input is a separate sequence, so we need one state for
+  // each of them.
+  if (prevOutput.n_cols != input.n_cols)
+  {
+    prevOutput.zeros(outSize, input.n_cols);
+    prevCell.zeros(outSize, input.n_cols);
+  }
+
+  // The states and activations of each time step are stored in preallocated
+  // buffers that are reused for every sequence.
+  if (gateActivation.size() != rho)
   {
-    cellParameter.push_back(prevCell);
-    outParameter.push_back(prevOutput);
+    gateActivation.resize(rho);
+    cellActivation.resize(rho);
+    cellParameter.resize(rho);
+    outParameter.resize(rho);
   }
 
-  arma::mat output1;
-  arma::mat output2;
-  arma::mat output3;
+  if (!deterministic)
+  {
+    // A new sequence starts, so the backward pass over the last sequence is
+    // finished, even if it was truncated.
+    if (forwardStep == 0)
+    {
+      backwardStep = 0;
+      gradientStep = 0;
+    }
+
+    cellParameter[forwardStep] = prevCell;
+    outParameter[forwardStep] = prevOutput;
+  }
 
   boost::apply_visitor(ForwardVisitor(std::move(input), std::move(
       boost::apply_visitor(outputParameterVisitor, input2GateModule))),
@@ -93,50 +101,29 @@ void LSTM<InputDataType, OutputDataType>::Forward(
       boost::apply_visitor(outputParameterVisitor, output2GateModule))),
       output2GateModule);
 
-  output = boost::apply_visitor(outputParameterVisitor, input2GateModule) +
+  // The stacked gate pre-activations are (in this order) the input gate, the
+  // hidden state, the forget gate and the output gate.  The nonlinearities are
+  // applied in place.
+  arma::mat& gates = gateActivation[forwardStep];
+  gates = boost::apply_visitor(outputParameterVisitor, input2GateModule) +
       boost::apply_visitor(outputParameterVisitor, output2GateModule);
 
-  boost::apply_visitor(ForwardVisitor(std::move(output.submat(
-      0, 0, 1 * outSize - 1, 0)), std::move(boost::apply_visitor(
-      outputParameterVisitor, inputGateModule))), inputGateModule);
-
-  boost::apply_visitor(ForwardVisitor(std::move(output.submat(
-      1 * outSize, 0, 2 * outSize - 1, 0)), std::move(boost::apply_visitor(
-      outputParameterVisitor, hiddenStateModule))), hiddenStateModule);
-
-  boost::apply_visitor(ForwardVisitor(std::move(output.submat(
-      2 * outSize, 0, 3 * outSize - 1, 0)), std::move(boost::apply_visitor(
-      outputParameterVisitor, forgetGateModule))), forgetGateModule);
-
-  boost::apply_visitor(ForwardVisitor(std::move(output.submat(
-      3 * outSize, 0, 4 * outSize - 1, 0)), std::move(boost::apply_visitor(
-      outputParameterVisitor, outputGateModule))), outputGateModule);
+  gates.rows(0, outSize - 1) = 1.0 / (1.0 + arma::exp(
+      -gates.rows(0, outSize - 1)));
+  gates.rows(outSize, 2 * outSize - 1) = arma::tanh(
+      gates.rows(outSize, 2 * outSize - 1));
+  gates.rows(2 * outSize, 4 * outSize - 1) = 1.0 / (1.0 + arma::exp(
+      -gates.rows(2 * outSize, 4 * outSize - 1)));
 
-  arma::mat cell = prevCell;
+  // Input gate * hidden state + forget gate * cell.
+  prevCell = gates.rows(0, outSize - 1) % gates.rows(outSize, 2 * outSize - 1)
+      + gates.rows(2 * outSize, 3 * outSize - 1) % prevCell;
 
-  // Input gate * hidden state.
-  arma::mat cmul1 = boost::apply_visitor(outputParameterVisitor,
-      inputGateModule) % boost::apply_visitor(outputParameterVisitor,
-      hiddenStateModule);
+  cellActivation[forwardStep] = arma::tanh(prevCell);
 
-  // Forget gate * cell.
-  arma::mat cmul2 = boost::apply_visitor(outputParameterVisitor,
-      forgetGateModule) % cell;
+  output = gates.rows(3 * outSize, 4 * outSize - 1) %
+      cellActivation[forwardStep];
 
-  arma::mat nextCell = cmul1 + cmul2;
-
-  boost::apply_visitor(ForwardVisitor(std::move(nextCell), std::move(
-    boost::apply_visitor(outputParameterVisitor, cellModule))), cellModule);
-
-  boost::apply_visitor(ForwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, cellModule)), std::move(boost::apply_visitor(
-      outputParameterVisitor, cellActivationModule))), cellActivationModule);
-
-  output = boost::apply_visitor(outputParameterVisitor,
-      cellActivationModule) % boost::apply_visitor(outputParameterVisitor,
-      outputGateModule);
-
-  prevCell = nextCell;
   prevOutput = output;
 
   forwardStep++;
@@ -158,65 +145,41 @@ void LSTM<InputDataType, OutputDataType>::Backward(
     gy += boost::apply_visitor(deltaVisitor, output2GateModule);
   }
 
-  arma::mat g1 = boost::apply_visitor(outputParameterVisitor,
-      cellActivationModule) % gy;
-
-  arma::mat g2 = boost::apply_visitor(outputParameterVisitor,
-      outputGateModule) % gy;
-
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, cellActivationModule)), std::move(g2),
-      std::move(boost::apply_visitor(deltaVisitor, cellActivationModule))),
-      cellActivationModule);
+  const size_t step = rho - backwardStep - 1;
+  const arma::mat& gates = gateActivation[step];
+  const arma::mat& cell = cellActivation[step];
 
-  cellActivationError = boost::apply_visitor(deltaVisitor,
-      cellActivationModule);
+  // Error of the cell state, through the cell activation and from the cell
+  // state of the next time step.
+  cellActivationError = gy % gates.rows(3 * outSize, 4 * outSize - 1) %
+      (1.0 - arma::square(cell));
 
   if (backwardStep > 0)
   {
     cellActivationError += forgetGateError;
   }
 
-  arma::mat g4 = boost::apply_visitor(outputParameterVisitor,
-      inputGateModule) % cellActivationError;
+  // Errors of the gate pre-activations, in the same order as the stacked gates.
+  prevError.set_size(4 * outSize, gy.n_cols);
 
-  arma::mat g5 = boost::apply_visitor(outputParameterVisitor,
-      hiddenStateModule) % cellActivationError;
+  prevError.rows(0, outSize - 1) = cellActivationError %
+      gates.rows(outSize, 2 * outSize - 1) % gates.rows(0, outSize - 1) %
+      (1.0 - gates.rows(0, outSize - 1));
 
-  forgetGateError = boost::apply_visitor(outputParameterVisitor,
-      forgetGateModule) % cellActivationError;
+  prevError.rows(outSize, 2 * outSize - 1) = cellActivationError %
+      gates.rows(0, outSize - 1) %
+      (1.0 - arma::square(gates.rows(outSize, 2 * outSize - 1)));
 
-  arma::mat g7 = cellParameter[cellParameter.size() -
-      backwardStep - 1] % cellActivationError;
+  prevError.rows(2 * outSize, 3 * outSize - 1) = cellActivationError %
+      cellParameter[step] % gates.rows(2 * outSize, 3 * outSize - 1) %
+      (1.0 - gates.rows(2 * outSize, 3 * outSize - 1));
 
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, inputGateModule)), std::move(g5),
-      std::move(boost::apply_visitor(deltaVisitor, inputGateModule))),
-      inputGateModule);
-
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, hiddenStateModule)), std::move(g4),
-      std::move(boost::apply_visitor(deltaVisitor, hiddenStateModule))),
-      hiddenStateModule);
+  prevError.rows(3 * outSize, 4 * outSize - 1) = gy % cell %
+      gates.rows(3 * outSize, 4 * outSize - 1) %
+      (1.0 - gates.rows(3 * outSize, 4 * outSize - 1));
 
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, forgetGateModule)), std::move(g7),
-      std::move(boost::apply_visitor(deltaVisitor, forgetGateModule))),
-      forgetGateModule);
-
-  boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
-      outputParameterVisitor, outputGateModule)), std::move(g1),
-      std::move(boost::apply_visitor(deltaVisitor, outputGateModule))),
-      outputGateModule);
-
-  prevError.submat(0, 0, 1 * outSize - 1, 0) = boost::apply_visitor(
-      deltaVisitor, inputGateModule);
-  prevError.submat(1 * outSize, 0, 2 * outSize - 1, 0) = boost::apply_visitor(
-      deltaVisitor, hiddenStateModule);
-  prevError.submat(2 * outSize, 0, 3 * outSize - 1, 0) = boost::apply_visitor(
-      deltaVisitor, forgetGateModule);
-  prevError.submat(3 * outSize, 0, 4 * outSize - 1, 0) = boost::apply_visitor(
-      deltaVisitor, outputGateModule);
+  forgetGateError = gates.rows(2 * outSize, 3 * outSize - 1) %
+      cellActivationError;
 
   boost::apply_visitor(BackwardVisitor(std::move(boost::apply_visitor(
       outputParameterVisitor, input2GateModule)), std::move(prevError),
@@ -232,7 +195,6 @@ void LSTM<InputDataType, OutputDataType>::Backward(
   if (backwardStep == rho)
   {
     backwardStep = 0;
-    cellParameter.clear();
   }
 
   g = boost::apply_visitor(deltaVisitor, input2GateModule);
@@ -249,14 +211,13 @@ void LSTM<InputDataType, OutputDataType>::Gradient(
       input2GateModule);
 
   boost::apply_visitor(GradientVisitor(
-      std::move(outParameter[outParameter.size() - gradientStep - 1]),
+      std::move(outParameter[rho - gradientStep - 1]),
       std::move(prevError)), output2GateModule);
 
   gradientStep++;
   if (gradientStep == rho)
   {
     gradientStep = 0;
-    outParameter.clear();
   }
 }
 
@@ -29,7 +29,8 @@ template<typename eT>
 double MeanSquaredError<InputDataType, OutputDataType>::Forward(
     const arma::Mat<eT>&& input, const arma::Mat<eT>&& target)
 {
-  return arma::mean(arma::mean(arma::square(input - target)));
+  // The mean over the dimensions, summed over the points (columns).
+  return arma::accu(arma::square(input - target)) / input.n_rows;
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -98,10 +98,19 @@ void Recurrent<InputDataType, OutputDataType>::Forward(
 
   output = boost::apply_visitor(outputParameterVisitor, transferModule);
 
-  // Save the feedback output parameter when training the module.
+  // Save the feedback output parameter when training the module.  The
+  // buffers are preallocated and reused for every sequence.
   if (!deterministic)
   {
-    feedbackOutputParameter.push_back(output);
+    // A new sequence starts, so the backward pass over the last sequence is
+    // finished, even if it was truncated.
+    if (forwardStep == 0)
+      gradientStep = 0;
+
+    if (feedbackOutputParameter.size() != rho)
+      feedbackOutputParameter.resize(rho);
+
+    feedbackOutputParameter[forwardStep] = output;
   }
 
   forwardStep++;
@@ -175,9 +184,8 @@ void Recurrent<InputDataType, OutputDataType>::Gradient(
         boost::apply_visitor(deltaVisitor, mergeModule))), inputModule);
 
     boost::apply_visitor(GradientVisitor(std::move(
-        feedbackOutputParameter[feedbackOutputParameter.size() - 2 -
-        gradientStep]), std::move(boost::apply_visitor(deltaVisitor,
-        mergeModule))), feedbackModule);
+        feedbackOutputParameter[rho - 2 - gradientStep]), std::move(
+        boost::apply_visitor(deltaVisitor, mergeModule))), feedbackModule);
   }
   else
   {
@@ -193,7 +201,6 @@ void Recurrent<InputDataType, OutputDataType>::Gradient(
   if (gradientStep == rho)
   {
     gradientStep = 0;
-    feedbackOutputParameter.clear();
   }
 }
 
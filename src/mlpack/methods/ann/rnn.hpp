@@ -188,6 +188,14 @@ class RNN
   //! Return the number of separable functions (the number of predictor points).
   size_t NumFunctions() const { return numFunctions; }
 
+  //! Get the number of steps to backpropagate through time (truncated BPTT).
+  size_t BPTTSteps() const { return bpttSteps; }
+  //! Modify the number of steps to backpropagate through time (truncated
+  //! BPTT).  The gradient is computed only over the last bpttSteps steps of
+  //! each sequence.  A value of 0 is treated as 1, and values larger than rho
+  //! are treated as rho (full BPTT); the stored value is not changed.
+  size_t& BPTTSteps() { return bpttSteps; }
+
   //! Return the initial point for the optimization.
   const arma::mat& Parameters() const { return parameter; }
   //! Modify the initial point for the optimization.
@@ -216,8 +224,10 @@ class RNN
   /**
    * Iterate through all layer modules and update the the gradient using the
    * layer defined optimizer.
+   *
+   * @param input Input of the current time step.
    */
-  void Gradient();
+  void Gradient(arma::mat&& input);
 
   /*
    * Predict the response of the given input sequence.
@@ -246,6 +256,9 @@ class RNN
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
 
+  //! Number of steps the gradient is computed over (truncated BPTT).
+  size_t bpttSteps;
+
   //! Instantiated outputlayer used to evaluate the network.
   OutputLayerType outputLayer;
 
@@ -286,17 +299,17 @@ class RNN
   //! The current error for the backward pass.
   arma::mat error;
 
-  //! THe current input of the forward/backward pass.
-  arma::mat currentInput;
-
   //! Locally-stored delta visitor.
   DeltaVisitor deltaVisitor;
 
   //! Locally-stored output parameter visitor.
   OutputParameterVisitor outputParameterVisitor;
 
-  //! List of all module parameters for the backward pass (BBTT).
-  std::vector<arma::mat> moduleOutputParameter;
+  //! Module outputs for the backward pass (BPTT).  This is a ring of
+  //! bpttSteps buffers: the outputs of time step t are stored in buffer
+  //! t % bpttSteps, so that after the forward pass the buffers hold the last
+  //! bpttSteps steps.  The buffers are reused between sequences.
+  std::vector<std::vector<arma::mat> > moduleOutputParameter;
 
   //! Locally-stored weight size visitor.
   WeightSizeVisitor weightSizeVisitor;
@@ -314,6 +327,16 @@ class RNN
 } // namespace ann
 } // namespace mlpack
 
+//! Set the serialization version of the RNN class.  The template signature
+//! and type contain commas, so they are given to the macro through macros.
+#define MLPACK_RNN_SIGNATURE \
+    template<typename OutputLayerType, typename InitializationRuleType>
+#define MLPACK_RNN_TYPE \
+    mlpack::ann::RNN<OutputLayerType, InitializationRuleType>
+BOOST_TEMPLATE_CLASS_VERSION(MLPACK_RNN_SIGNATURE, MLPACK_RNN_TYPE, 1);
+#undef MLPACK_RNN_SIGNATURE
+#undef MLPACK_RNN_TYPE
+
 // Include implementation.
 #include "rnn_impl.hpp"
 
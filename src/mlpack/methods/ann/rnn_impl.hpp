@@ -35,6 +35,7 @@ RNN<OutputLayerType, InitializationRuleType>::RNN(
     OutputLayerType outputLayer,
     InitializationRuleType initializeRule) :
     rho(rho),
+    bpttSteps(rho),
     outputLayer(outputLayer),
     initializeRule(initializeRule),
     inputSize(0),
@@ -55,6 +56,7 @@ RNN<OutputLayerType, InitializationRuleType>::RNN(
     OutputLayerType outputLayer,
     InitializationRuleType initializeRule) :
     rho(rho),
+    bpttSteps(rho),
     outputLayer(outputLayer),
     initializeRule(initializeRule),
     inputSize(0),
@@ -178,9 +180,9 @@ void RNN<OutputLayerType, InitializationRuleType>::SinglePredict(
 {
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
-    currentInput = predictors.rows(seqNum * inputSize,
-        (seqNum + 1) * inputSize - 1);
-    Forward(std::move(currentInput));
+    // Alias the input of this time step instead of copying it.
+    Forward(arma::mat(const_cast<double*>(predictors.colptr(0)) +
+        seqNum * inputSize, inputSize, 1, false, true));
 
     results.rows(seqNum * outputSize, (seqNum + 1) * outputSize - 1) =
         boost::apply_visitor(outputParameterVisitor, network.back());
@@ -216,20 +218,29 @@ double RNN<OutputLayerType, InitializationRuleType>::Evaluate(
 
   double performance = 0;
 
+  // Only the module outputs of the last steps are needed for the (truncated)
+  // backward pass.  See BPTTSteps() for the clamping of the number of steps.
+  const size_t steps = std::max(std::min(bpttSteps, rho), (size_t) 1);
+  if (!deterministic && moduleOutputParameter.size() != steps)
+    moduleOutputParameter.resize(steps);
+
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
-    currentInput = input.rows(seqNum * inputSize, (seqNum + 1) * inputSize - 1);
-    arma::mat currentTarget = target.rows(seqNum * targetSize,
-        (seqNum + 1) * targetSize - 1);
+    // Alias the input and target of this time step instead of copying them.
+    arma::mat currentInput(input.memptr() + seqNum * inputSize, inputSize, 1,
+        false, true);
+    arma::mat currentTarget(target.memptr() + seqNum * targetSize, targetSize,
+        1, false, true);
 
     Forward(std::move(currentInput));
 
-    if (!deterministic)
+    if (!deterministic && seqNum >= rho - steps)
     {
+      size_t index = 0;
       for (size_t l = 0; l < network.size(); ++l)
       {
-        boost::apply_visitor(SaveOutputParameterVisitor(
-            std::move(moduleOutputParameter)), network[l]);
+        boost::apply_visitor(SaveOutputParameterVisitor(std::move(
+            moduleOutputParameter[seqNum % steps]), index), network[l]);
       }
     }
 
@@ -271,24 +282,28 @@ void RNN<OutputLayerType, InitializationRuleType>::Gradient(
       parameter.n_cols);
   ResetGradients(currentGradient);
 
-  arma::mat input = arma::mat(predictors.colptr(i), predictors.n_rows,
-      1, false, true);
-  arma::mat target = arma::mat(responses.colptr(i), responses.n_rows,
-      1, false, true);
-
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  // Backpropagate through the last steps of the sequence only (truncated
+  // BPTT).  This must match the number of steps stored by Evaluate().
+  const size_t steps = std::max(std::min(bpttSteps, rho), (size_t) 1);
+  for (size_t seqNum = 0; seqNum < steps; ++seqNum)
   {
     currentGradient.zeros();
 
-    arma::mat currentTarget = target.rows((rho - seqNum - 1) * targetSize,
-        (rho - seqNum) * targetSize - 1);
-    currentInput = input.rows((rho - seqNum - 1) * inputSize,
-        (rho - seqNum) * inputSize - 1);
+    // Alias the input and target of this time step instead of copying them.
+    const size_t step = rho - seqNum - 1;
+    arma::mat currentInput(predictors.colptr(i) + step * inputSize, inputSize,
+        1, false, true);
+    arma::mat currentTarget(responses.colptr(i) + step * targetSize,
+        targetSize, 1, false, true);
 
+    std::vector<arma::mat>& stepOutputParameter =
+        moduleOutputParameter[step % steps];
+    size_t index = stepOutputParameter.size();
     for (size_t l = 0; l < network.size(); ++l)
     {
       boost::apply_visitor(LoadOutputParameterVisitor(
-          std::move(moduleOutputParameter)), network[network.size() - 1 - l]);
+          std::move(stepOutputParameter), index),
+          network[network.size() - 1 - l]);
     }
 
     if (single && seqNum > 0)
@@ -303,7 +318,7 @@ void RNN<OutputLayerType, InitializationRuleType>::Gradient(
     }
 
     Backward();
-    Gradient();
+    Gradient(std::move(currentInput));
     gradient += currentGradient;
   }
 }
@@ -388,9 +403,9 @@ void RNN<OutputLayerType, InitializationRuleType>::Backward()
 }
 
 template<typename OutputLayerType, typename InitializationRuleType>
-void RNN<OutputLayerType, InitializationRuleType>::Gradient()
+void RNN<OutputLayerType, InitializationRuleType>::Gradient(arma::mat&& input)
 {
-  boost::apply_visitor(GradientVisitor(std::move(currentInput), std::move(
+  boost::apply_visitor(GradientVisitor(std::move(input), std::move(
       boost::apply_visitor(deltaVisitor, network[1]))), network.front());
 
   for (size_t i = 1; i < network.size() - 1; ++i)
@@ -405,7 +420,7 @@ void RNN<OutputLayerType, InitializationRuleType>::Gradient()
 template<typename OutputLayerType, typename InitializationRuleType>
 template<typename Archive>
 void RNN<OutputLayerType, InitializationRuleType>::Serialize(
-    Archive& ar, const unsigned int /* version */)
+    Archive& ar, const unsigned int version)
 {
   ar & data::CreateNVP(parameter, "parameter");
   ar & data::CreateNVP(rho, "rho");
@@ -413,7 +428,20 @@ void RNN<OutputLayerType, InitializationRuleType>::Serialize(
   ar & data::CreateNVP(inputSize, "inputSize");
   ar & data::CreateNVP(outputSize, "outputSize");
   ar & data::CreateNVP(targetSize, "targetSize");
-  ar & data::CreateNVP(currentInput, "currentInput");
+
+  // Backward compatibility: older versions of RNN stored the last input
+  // instead of the number of BPTT steps, and always backpropagated through all
+  // rho steps.
+  if (version == 0)
+  {
+    arma::mat currentInput;
+    ar & data::CreateNVP(currentInput, "currentInput");
+    bpttSteps = rho;
+  }
+  else
+  {
+    ar & data::CreateNVP(bpttSteps, "bpttSteps");
+  }
 
   // If we are loading, we need to initialize the weights.
   if (Archive::is_loading::value)
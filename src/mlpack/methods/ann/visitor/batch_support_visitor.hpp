@@ -0,0 +1,125 @@
+/**
+ * @file batch_support_visitor.hpp
+ *
+ * This file provides a way to check whether a layer can process a batch of
+ * points (one point per column) at once, and automatically directs the check
+ * to the right layer type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_BATCH_SUPPORT_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_BATCH_SUPPORT_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * 'value' is true if the layer treats every column of its input as a separate
+ * point in Forward(), Backward() and Gradient(), so that the forward and
+ * backward pass over a batch of points gives the sum of the gradients of the
+ * points.  This is false by default; layers that hold a state between calls
+ * or that interpret their input as an image (such as the convolution and
+ * pooling layers) must not be given a batch.
+ */
+template<typename LayerType>
+struct IsBatchLayer
+{
+  static const bool value = false;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<Add<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename ActivationFunction,
+         typename InputDataType,
+         typename OutputDataType>
+struct IsBatchLayer<BaseLayer<ActivationFunction, InputDataType,
+    OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<Dropout<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<HardTanH<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<LeakyReLU<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<Linear<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<LinearNoBias<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<LogSoftMax<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<MeanSquaredError<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<MultiplyConstant<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+template<typename InputDataType, typename OutputDataType>
+struct IsBatchLayer<NegativeLogLikelihood<InputDataType, OutputDataType>>
+{
+  static const bool value = true;
+};
+
+/**
+ * BatchSupportVisitor returns true if the given module can process a batch of
+ * points at once (see IsBatchLayer).
+ */
+class BatchSupportVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Return true if the module can process a batch of points.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_support_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file batch_support_visitor_impl.hpp
+ *
+ * Implementation of the check whether a layer can process a batch of points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_BATCH_SUPPORT_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_BATCH_SUPPORT_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_support_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! BatchSupportVisitor visitor class.
+template<typename LayerType>
+inline bool BatchSupportVisitor::operator()(LayerType* /* layer */) const
+{
+  return IsBatchLayer<LayerType>::value;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -32,6 +32,18 @@ class LoadOutputParameterVisitor : public boost::static_visitor<void>
   //! Restore the output parameter given a parameter set.
   LoadOutputParameterVisitor(std::vector<arma::mat>&& parameter);
 
+  /**
+   * Restore the output parameter given a parameter set, reading the elements
+   * in front of the given position in reverse order (like the stack-based
+   * constructor does) without removing them from the parameter set.  The
+   * position is moved to the first restored element.
+   *
+   * @param parameter The parameter set.
+   * @param index Position after the last element to restore.
+   */
+  LoadOutputParameterVisitor(std::vector<arma::mat>&& parameter,
+                             size_t& index);
+
   //! Restore the output parameter.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
@@ -40,6 +52,12 @@ class LoadOutputParameterVisitor : public boost::static_visitor<void>
   //! The parameter set.
   std::vector<arma::mat>&& parameter;
 
+  //! The position to read from, or NULL if the parameters are popped.
+  size_t* index;
+
+  //! Restore the given output parameter.
+  void Load(arma::mat& output) const;
+
   //! Restore the output parameter for a module which doesn't implement the
   //! Model() function.
   template<typename T>
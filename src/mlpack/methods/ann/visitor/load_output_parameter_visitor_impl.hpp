@@ -20,11 +20,34 @@ namespace ann {
 
 //! LoadOutputParameterVisitor visitor class.
 inline LoadOutputParameterVisitor::LoadOutputParameterVisitor(
-    std::vector<arma::mat>&& parameter) : parameter(std::move(parameter))
+    std::vector<arma::mat>&& parameter) :
+    parameter(std::move(parameter)),
+    index(NULL)
 {
   /* Nothing to do here. */
 }
 
+inline LoadOutputParameterVisitor::LoadOutputParameterVisitor(
+    std::vector<arma::mat>&& parameter, size_t& index) :
+    parameter(std::move(parameter)),
+    index(&index)
+{
+  /* Nothing to do here. */
+}
+
+inline void LoadOutputParameterVisitor::Load(arma::mat& output) const
+{
+  if (index == NULL)
+  {
+    output = parameter.back();
+    parameter.pop_back();
+  }
+  else
+  {
+    output = parameter[--(*index)];
+  }
+}
+
 template<typename LayerType>
 inline void LoadOutputParameterVisitor::operator()(LayerType* layer) const
 {
@@ -36,8 +59,7 @@ inline typename std::enable_if<
     !HasModelCheck<T, std::vector<LayerTypes>&(T::*)()>::value, void>::type
 LoadOutputParameterVisitor::OutputParameter(T* layer) const
 {
-  layer->OutputParameter() = parameter.back();
-  parameter.pop_back();
+  Load(layer->OutputParameter());
 }
 
 template<typename T>
@@ -47,12 +69,19 @@ LoadOutputParameterVisitor::OutputParameter(T* layer) const
 {
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    boost::apply_visitor(LoadOutputParameterVisitor(std::move(parameter)),
-        layer->Model()[layer->Model().size() - i - 1]);
+    if (index == NULL)
+    {
+      boost::apply_visitor(LoadOutputParameterVisitor(std::move(parameter)),
+          layer->Model()[layer->Model().size() - i - 1]);
+    }
+    else
+    {
+      boost::apply_visitor(LoadOutputParameterVisitor(std::move(parameter),
+          *index), layer->Model()[layer->Model().size() - i - 1]);
+    }
   }
 
-  layer->OutputParameter() = parameter.back();
-  parameter.pop_back();
+  Load(layer->OutputParameter());
 }
 
 } // namespace ann
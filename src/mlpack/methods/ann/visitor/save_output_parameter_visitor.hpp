@@ -31,6 +31,18 @@ class SaveOutputParameterVisitor : public boost::static_visitor<void>
   //! Save the output parameter into the given parameter set.
   SaveOutputParameterVisitor(std::vector<arma::mat>&& parameter);
 
+  /**
+   * Save the output parameter into the given parameter set, starting at the
+   * given position.  Existing elements are overwritten, so their memory is
+   * reused; the parameter set is only extended if it is too small.  The
+   * position is advanced past the saved elements.
+   *
+   * @param parameter The parameter set.
+   * @param index Position of the first element to overwrite.
+   */
+  SaveOutputParameterVisitor(std::vector<arma::mat>&& parameter,
+                             size_t& index);
+
   //! Save the output parameter.
   template<typename LayerType>
   void operator()(LayerType* layer) const;
@@ -39,6 +51,12 @@ class SaveOutputParameterVisitor : public boost::static_visitor<void>
   //! The parameter set.
   std::vector<arma::mat>&& parameter;
 
+  //! The position to write to, or NULL if the parameters are appended.
+  size_t* index;
+
+  //! Save the given output parameter.
+  void Save(const arma::mat& output) const;
+
   //! Save the output parameter for a module which doesn't implement the
   //! Model() function.
   template<typename T>
@@ -20,11 +20,38 @@ namespace ann {
 
 //! SaveOutputParameterVisitor visitor class.
 inline SaveOutputParameterVisitor::SaveOutputParameterVisitor(
-    std::vector<arma::mat>&& parameter) : parameter(std::move(parameter))
+    std::vector<arma::mat>&& parameter) :
+    parameter(std::move(parameter)),
+    index(NULL)
 {
   /* Nothing to do here. */
 }
 
+inline SaveOutputParameterVisitor::SaveOutputParameterVisitor(
+    std::vector<arma::mat>&& parameter, size_t& index) :
+    parameter(std::move(parameter)),
+    index(&index)
+{
+  /* Nothing to do here. */
+}
+
+inline void SaveOutputParameterVisitor::Save(const arma::mat& output) const
+{
+  if (index == NULL || *index == parameter.size())
+  {
+    parameter.push_back(output);
+  }
+  else
+  {
+    // The matrix usually has the same size as the last time this position was
+    // written, so this doesn't allocate.
+    parameter[*index] = output;
+  }
+
+  if (index != NULL)
+    ++(*index);
+}
+
 template<typename LayerType>
 inline void SaveOutputParameterVisitor::operator()(LayerType* layer) const
 {
@@ -36,7 +63,7 @@ inline typename std::enable_if<
     !HasModelCheck<T, std::vector<LayerTypes>&(T::*)()>::value, void>::type
 SaveOutputParameterVisitor::OutputParameter(T* layer) const
 {
-  parameter.push_back(layer->OutputParameter());
+  Save(layer->OutputParameter());
 }
 
 template<typename T>
@@ -44,12 +71,20 @@ inline typename std::enable_if<
     HasModelCheck<T, std::vector<LayerTypes>&(T::*)()>::value, void>::type
 SaveOutputParameterVisitor::OutputParameter(T* layer) const
 {
-  parameter.push_back(layer->OutputParameter());
+  Save(layer->OutputParameter());
 
   for (size_t i = 0; i < layer->Model().size(); ++i)
   {
-    boost::apply_visitor(SaveOutputParameterVisitor(std::move(parameter)),
-        layer->Model()[i]);
+    if (index == NULL)
+    {
+      boost::apply_visitor(SaveOutputParameterVisitor(std::move(parameter)),
+          layer->Model()[i]);
+    }
+    else
+    {
+      boost::apply_visitor(SaveOutputParameterVisitor(std::move(parameter),
+          *index), layer->Model()[i]);
+    }
   }
 }
 
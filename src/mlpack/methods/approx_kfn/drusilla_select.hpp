@@ -83,6 +83,9 @@ class DrusillaSelect
    * the k'th row in that column will refer to the k'th candidate neighbor or
    * distance for that query point.
    *
+   * The query points are processed in parallel blocks; the distances between
+   * a block and all the candidates are computed with one matrix product.
+   *
    * @param querySet Set of query points to search.
    * @param k Number of furthest neighbors to search for.
    * @param neighbors Matrix to store resulting neighbors in.
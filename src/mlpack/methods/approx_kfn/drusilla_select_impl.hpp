@@ -16,9 +16,7 @@
 #include "drusilla_select.hpp"
 
 #include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -178,23 +176,59 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
-      tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
-
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // The squared norms of the candidates, so that the distances between a block
+  // of query points and all the candidates can be computed with one matrix
+  // product.
+  arma::vec candidateNorms(candidateSet.n_cols);
+  for (size_t i = 0; i < candidateSet.n_cols; ++i)
+    candidateNorms[i] = std::pow(arma::norm(candidateSet.col(i)), 2.0);
+
+  // Blocks of query points are independent, so they are searched in parallel.
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables.
+  const size_t blockSize = 256;
+  const size_t numBlocks = (querySet.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (intmax_t b = 0; b < (intmax_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
 
-  rules.GetResults(neighbors, distances);
+    // Each column holds the squared distances between one query point and all
+    // the candidates.
+    arma::mat blockDistances(candidateSet.t() * querySet.cols(begin, end - 1));
+    blockDistances *= -2.0;
+    blockDistances.each_col() += candidateNorms;
 
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+    std::vector<size_t> order(candidateSet.n_cols);
+    for (size_t q = begin; q < end; ++q)
+    {
+      // The squared norm of the query point is left out of its distances,
+      // since it doesn't change their order.  Find the k furthest candidates.
+      const double* queryDistances = blockDistances.colptr(q - begin);
+      for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+      std::partial_sort(order.begin(), order.begin() + k, order.end(),
+          [queryDistances](const size_t c1, const size_t c2)
+          {
+            if (queryDistances[c1] != queryDistances[c2])
+              return queryDistances[c1] > queryDistances[c2];
+            return c1 < c2;
+          });
+
+      // Map the neighbors back to their original indices in the reference set,
+      // computing the distances to them directly.
+      for (size_t j = 0; j < k; ++j)
+      {
+        neighbors(j, q) = candidateIndices[order[j]];
+        distances(j, q) = metric::EuclideanDistance::Evaluate(querySet.col(q),
+            candidateSet.col(order[j]));
+      }
+    }
+  }
 }
 
 //! Serialize the model.
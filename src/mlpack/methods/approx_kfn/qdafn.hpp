@@ -73,6 +73,11 @@ class QDAFN
    * can contain just one point, that is okay.)  The results will be stored in
    * the given neighbors and distances matrices, in the same format as the
    * mlpack NeighborSearch and LSHSearch classes.
+   *
+   * All query points are projected onto the lines with one matrix product, and
+   * the query points are then searched in parallel.  Since the candidates of
+   * each table are visited in order, the distances to the visited candidates
+   * of a table are computed with one product against its candidate set.
    */
   void Search(const MatType& querySet,
               const size_t k,
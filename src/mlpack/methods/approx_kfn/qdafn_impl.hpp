@@ -104,54 +104,48 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
-  // Search for each point.
-  for (size_t q = 0; q < querySet.n_cols; ++q)
+  // Project all the query points onto all the lines at once.
+  const arma::mat queryProjections(lines.t() * querySet);
+
+  // The squared norms of the candidates, so that the distances to the
+  // candidates can be computed from dot products.
+  arma::mat candidateNorms(m, l);
+  for (size_t i = 0; i < l; ++i)
+    for (size_t j = 0; j < m; ++j)
+      candidateNorms(j, i) = std::pow(arma::norm(candidateSet[i].col(j)), 2.0);
+
+  // Search for each point.  The query points are independent, so they are
+  // searched in parallel.  Visual Studio only implements OpenMP 2.0, which
+  // doesn't support unsigned loop variables.
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (intmax_t q = 0; q < (intmax_t) querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
     // The size_t represents the index of the table, and the double represents
     // the value of l_i * S_i - l_i * query (see line 6 of Algorithm 1).
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
-    {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
-      queue.push(std::make_pair(val, i));
-    }
+      queue.push(std::make_pair(sValues(0, i) - queryProjections(i, q), i));
 
     // To track where we are in each S table, we keep the next index to look at
-    // in each table (they start at 0).
+    // in each table (they start at 0).  The order in which the elements are
+    // visited depends only on the projections, so we find all m of them before
+    // computing any distance.
     arma::Col<size_t> tableLocations = arma::zeros<arma::Col<size_t>>(l);
-
-    // Now that the queue is initialized, iterate over m elements.
-    std::vector<std::pair<double, size_t>> v(k, std::make_pair(-1.0,
-        size_t(-1)));
-    std::priority_queue<std::pair<double, size_t>>
-        resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
+    std::vector<size_t> visited(m);
     for (size_t i = 0; i < m; ++i)
     {
-      std::pair<size_t, double> p = queue.top();
+      std::pair<double, size_t> p = queue.top();
       queue.pop();
 
-      // Get index of reference point to look at.
-      const size_t tableIndex = tableLocations[p.second];
-
-      // Calculate distance from query point.
-      const double dist = mlpack::metric::EuclideanDistance::Evaluate(
-          querySet.col(q), candidateSet[p.second].col(tableIndex));
-
-      // Is this neighbor good enough to insert into the results?
-      if (dist > resultsQueue.top().first)
-      {
-        resultsQueue.pop();
-        resultsQueue.push(std::make_pair(dist, sIndices(tableIndex, p.second)));
-      }
+      visited[i] = p.second;
+      const size_t tableIndex = tableLocations[p.second]++;
 
       // Now (line 14) get the next element and insert into the queue.  Do this
       // by adjusting the previous value.  Don't insert anything if we are at
       // the end of the search, though.
       if (i < m - 1)
       {
-        tableLocations[p.second]++;
         const double val = p.first - sValues(tableIndex, p.second) +
             sValues(tableIndex + 1, p.second);
 
@@ -159,12 +153,58 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       }
     }
 
-    // Extract the results.
+    // The elements visited in each table are the first ones of its candidate
+    // set, so the distances to all of them are computed with one product per
+    // table.
+    const double queryNorm = std::pow(arma::norm(querySet.col(q)), 2.0);
+    std::vector<arma::rowvec> tableDistances(l);
+    for (size_t i = 0; i < l; ++i)
+    {
+      if (tableLocations[i] == 0)
+        continue;
+
+      tableDistances[i] = arma::mat(querySet.col(q).t() *
+          candidateSet[i].cols(0, tableLocations[i] - 1));
+      for (size_t j = 0; j < tableLocations[i]; ++j)
+      {
+        tableDistances[i][j] = std::sqrt(std::max(queryNorm +
+            candidateNorms(j, i) - 2.0 * tableDistances[i][j], 0.0));
+      }
+    }
+
+    // Now consider the elements in the order they were visited.  The results
+    // store the table and the index in the table of each element.
+    std::vector<std::pair<double, size_t>> v(k, std::make_pair(-1.0,
+        size_t(-1)));
+    std::priority_queue<std::pair<double, size_t>,
+        std::vector<std::pair<double, size_t>>,
+        std::greater<std::pair<double, size_t>>>
+        resultsQueue(std::greater<std::pair<double, size_t>>(), std::move(v));
+    tableLocations.zeros();
+    for (size_t i = 0; i < m; ++i)
+    {
+      const size_t table = visited[i];
+      const size_t tableIndex = tableLocations[table]++;
+      const double dist = tableDistances[table][tableIndex];
+
+      // Is this neighbor good enough to insert into the results?
+      if (dist > resultsQueue.top().first)
+      {
+        resultsQueue.pop();
+        resultsQueue.push(std::make_pair(dist, tableIndex * l + table));
+      }
+    }
+
+    // Extract the results, computing the distances to the neighbors directly.
     for (size_t j = 1; j <= k; ++j)
     {
-      neighbors(k - j, q) = resultsQueue.top().second;
-      distances(k - j, q) = resultsQueue.top().first;
+      const size_t table = resultsQueue.top().second % l;
+      const size_t tableIndex = resultsQueue.top().second / l;
       resultsQueue.pop();
+
+      neighbors(k - j, q) = sIndices(tableIndex, table);
+      distances(k - j, q) = metric::EuclideanDistance::Evaluate(
+          querySet.col(q), candidateSet[table].col(tableIndex));
     }
   }
 }
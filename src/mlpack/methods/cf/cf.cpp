@@ -18,6 +18,11 @@
 namespace mlpack {
 namespace cf {
 
+// Number of users whose recommendations are computed together.  Each block of
+// users costs one matrix product of W with the block's averaged item factors,
+// and blocks are distributed across threads.
+static const size_t recommendationBlockSize = 256;
+
 // Default CF constructor.
 CF::CF(const size_t numUsersForSimilarity,
        const size_t rank) :
@@ -84,53 +89,81 @@ void CF::GetRecommendations(const size_t numRecs,
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the averages matrix.
   recommendations.set_size(numRecs, users.n_elem);
-  arma::mat values(numRecs, users.n_elem);
 
-  for (size_t i = 0; i < users.n_elem; i++)
-  {
-    // First, calculate average of neighborhood values.
-    arma::vec averages;
-    averages.zeros(cleanedData.n_rows);
+  // Users for which not enough unrated items were found.  Log isn't
+  // thread-safe, so the warnings are issued after the parallel loop.
+  std::vector<char> incomplete(users.n_elem, 0);
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
-      averages += w * h.col(neighborhood(j, i));
-    averages /= neighborhood.n_rows;
-
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-    // Look through the averages column corresponding to the current user.
-    for (size_t j = 0; j < averages.n_rows; ++j)
+  // Only read from the ratings while in the parallel region.
+  const arma::sp_mat& ratings = cleanedData;
+
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables.
+  const size_t numBlocks = (users.n_elem + recommendationBlockSize - 1) /
+      recommendationBlockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (intmax_t block = 0; block < (intmax_t) numBlocks; ++block)
+  {
+    const size_t begin = block * recommendationBlockSize;
+    const size_t end = std::min(begin + recommendationBlockSize,
+        (size_t) users.n_elem);
+
+    // The estimated ratings are linear in H, so the average of the neighbors'
+    // ratings is W times the average of their columns of H.  That makes the
+    // averages for the whole block a single matrix product.
+    arma::mat averageH(h.n_rows, end - begin, arma::fill::zeros);
+    for (size_t i = begin; i < end; ++i)
     {
-      // Ensure that the user hasn't already rated the item.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
+      for (size_t j = 0; j < neighborhood.n_rows; ++j)
+        averageH.col(i - begin) += h.col(neighborhood(j, i));
+    }
+    averageH /= neighborhood.n_rows;
 
+    const arma::mat averages = w * averageH;
 
-      // Is the estimated value better than the worst candidate?
-      if (averages[i] > pqueue.top().first)
+    std::vector<Candidate> candidates;
+    candidates.reserve(averages.n_rows);
+    for (size_t i = begin; i < end; ++i)
+    {
+      // Collect every item the user hasn't rated.  The nonzero entries of the
+      // user's column are visited in increasing row order, so this is a merge.
+      candidates.clear();
+      arma::sp_mat::const_col_iterator it = ratings.begin_col(users(i));
+      const arma::sp_mat::const_col_iterator itEnd =
+          ratings.end_col(users(i));
+      for (size_t j = 0; j < averages.n_rows; ++j)
       {
-        Candidate c = std::make_pair(averages[j], j);
-        pqueue.pop();
-        pqueue.push(c);
+        if (it != itEnd && it.row() == j)
+        {
+          ++it;
+          continue; // The user already rated the item.
+        }
+
+        candidates.push_back(std::make_pair(averages(j, i - begin), j));
       }
-    }
 
-    for (size_t p = 1; p <= numRecs; p++)
-    {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
+      // Select the best numRecs candidates, in descending order of value.
+      const size_t numFound = std::min(numRecs, candidates.size());
+      std::partial_sort(candidates.begin(), candidates.begin() + numFound,
+          candidates.end(), CandidateCmp());
+
+      for (size_t p = 0; p < numFound; ++p)
+        recommendations(p, i) = candidates[p].second;
+
+      // If we were not able to come up with enough recommendations, fill the
+      // rest with an invalid item number.
+      for (size_t p = numFound; p < numRecs; ++p)
+        recommendations(p, i) = cleanedData.n_rows;
+      if (numFound < numRecs)
+        incomplete[i] = 1;
     }
+  }
 
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (incomplete[i])
       Log::Warn << "Could not provide " << numRecs << " recommendations "
           << "for user " << users(i) << " (not enough un-rated items)!"
           << std::endl;
@@ -169,13 +202,14 @@ double CF::Predict(const size_t user, const size_t item) const
 
   a.Search(query, numUsersForSimilarity, neighborhood, resultingDistances);
 
-  double rating = 0; // We'll take the average of neighborhood values.
-
+  // We'll take the average of neighborhood values, which is the rating given by
+  // the average of the neighbors' columns of H.
+  arma::vec averageH(h.n_rows, arma::fill::zeros);
   for (size_t j = 0; j < neighborhood.n_rows; ++j)
-    rating += arma::as_scalar(w.row(item) * h.col(neighborhood(j, 0)));
-  rating /= neighborhood.n_rows;
+    averageH += h.col(neighborhood(j, 0));
+  averageH /= neighborhood.n_rows;
 
-  return rating;
+  return arma::dot(w.row(item), averageH);
 }
 
 // Predict the rating for a group of user/item combinations.
@@ -186,14 +220,6 @@ void CF::Predict(const arma::Mat<size_t>& combinations,
   arma::mat l = arma::chol(w.t() * w);
   arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
 
-  // Now, we must determine those query indices we need to find the nearest
-  // neighbors for.  This is easiest if we just sort the combinations matrix.
-  arma::Mat<size_t> sortedCombinations(combinations.n_rows,
-                                       combinations.n_cols);
-  arma::uvec ordering = arma::sort_index(combinations.row(0).t());
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    sortedCombinations.col(i) = combinations.col(ordering[i]);
-
   // Now, we have to get the list of unique users we will be searching for.
   arma::Col<size_t> users = arma::unique(combinations.row(0).t());
 
@@ -209,26 +235,30 @@ void CF::Predict(const arma::Mat<size_t>& combinations,
 
   a.Search(queries, numUsersForSimilarity, neighborhood, distances);
 
+  // The prediction is the average of the neighbors' ratings, which is the
+  // rating given by the average of their columns of H; compute that once per
+  // user.  Visual Studio only implements OpenMP 2.0, which doesn't support
+  // unsigned loop variables.
+  arma::mat averageH(h.n_rows, users.n_elem, arma::fill::zeros);
+  #pragma omp parallel for schedule(static)
+  for (intmax_t i = 0; i < (intmax_t) users.n_elem; ++i)
+  {
+    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+      averageH.col(i) += h.col(neighborhood(j, i));
+    averageH.col(i) /= neighborhood.n_rows;
+  }
+
   // Now that we have the neighborhoods we need, calculate the predictions.
   predictions.set_size(combinations.n_cols);
 
-  size_t user = 0; // Cumulative user count, because we are doing it in order.
-  for (size_t i = 0; i < sortedCombinations.n_cols; ++i)
+  #pragma omp parallel for schedule(static)
+  for (intmax_t i = 0; i < (intmax_t) combinations.n_cols; ++i)
   {
-    // Could this be made faster by calculating dot products for multiple items
-    // at once?
-    double rating = 0.0;
-
     // Map the combination's user to the user ID used for kNN.
-    while (users[user] < sortedCombinations(0, i))
-      ++user;
-
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
-      rating += arma::as_scalar(w.row(sortedCombinations(1, i)) *
-          h.col(neighborhood(j, user)));
-    rating /= neighborhood.n_rows;
+    const size_t user = std::lower_bound(users.begin(), users.end(),
+        combinations(0, i)) - users.begin();
 
-    predictions(ordering[i]) = rating;
+    predictions(i) = arma::dot(w.row(combinations(1, i)), averageH.col(user));
   }
 }
 
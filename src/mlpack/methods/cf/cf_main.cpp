@@ -57,6 +57,8 @@ PROGRAM_INFO("Collaborating Filtering", "This program performs collaborative "
     "'BatchSVD' -- SVD batch learning\n"
     "'SVDIncompleteIncremental' -- SVD incomplete incremental learning\n"
     "'SVDCompleteIncremental' -- SVD complete incremental learning\n"
+    "'WeightedALS' -- Regularized alternating least squares over the observed "
+    "ratings only, solving for users and items in parallel\n"
     "\n"
     "A trained model may be saved to a file with the --output_model_file (-M) "
     "parameter.");
@@ -217,6 +219,12 @@ void AssembleFactorizerType(const std::string& algorithm,
           SVDCompleteIncrementalLearning<arma::sp_mat>> FactorizerType;
       PerformAction(FactorizerType(mit), dataset, rank);
     }
+    else if (algorithm == "WeightedALS")
+    {
+      typedef AMF<MaxIterationTermination, RandomAcolInitialization<>,
+          WeightedALSUpdate> FactorizerType;
+      PerformAction(FactorizerType(mit), dataset, rank);
+    }
     else if (algorithm == "RegSVD")
     {
       Log::Fatal << "--iteration_only_termination not supported with 'RegSVD' "
@@ -238,6 +246,8 @@ void AssembleFactorizerType(const std::string& algorithm,
           rank);
     else if (algorithm == "SVDCompleteIncremental")
       PerformAction(SparseSVDCompleteIncrementalFactorizer(srt), dataset, rank);
+    else if (algorithm == "WeightedALS")
+      PerformAction(WeightedALSFactorizer(srt), dataset, rank);
     else if (algorithm == "RegSVD")
       PerformAction(RegularizedSVD<>(maxIterations), dataset, rank);
   }
@@ -298,10 +308,11 @@ int main(int argc, char** argv)
         algo != "BatchSVD" &&
         algo != "SVDIncompleteIncremental" &&
         algo != "SVDCompleteIncremental" &&
-        algo != "RegSVD")
+        algo != "RegSVD" &&
+        algo != "WeightedALS")
       Log::Fatal << "Invalid decomposition algorithm.  Choices are 'NMF', "
           << "'BatchSVD', 'SVDIncompleteIncremental', 'SVDCompleteIncremental',"
-          << " and 'RegSVD'." << endl;
+          << " 'RegSVD', and 'WeightedALS'." << endl;
 
     // Issue a warning if the user provided a minimum residue but it will be
     // ignored.
@@ -15,6 +15,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
+#include <mlpack/methods/emst/union_find.hpp>
 #include "random_point_selection.hpp"
 #include <boost/dynamic_bitset.hpp>
 
@@ -42,6 +43,17 @@ namespace dbscan {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * By default, the neighborhoods of all points are found with a single range
+ * search before clustering, so memory usage grows with the total number of
+ * neighbors.  If a nonzero batch size is given, the range searches are instead
+ * done for one batch of points at a time (the points of a batch are split
+ * between OpenMP threads, unless RangeSearch::SupportsConcurrentSearch() is
+ * false), and the core points are joined into clusters with a union-find
+ * structure as each batch is processed; only the neighborhoods of the current
+ * batch are held in memory.  In that mode each border point is assigned to the
+ * cluster of one of its core neighbors, and the point selection policy is not
+ * used.
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -58,11 +70,14 @@ class DBSCAN
    * @param minPoints Minimum number of points for each cluster.
    * @param rangeSearch Optional instantiated RangeSearch object.
    * @param pointSelector OptionL instantiated PointSelectionPolicy object.
+   * @param batchSize Number of points to run range searches for at once; 0
+   *     means all points are searched before clustering.
    */
   DBSCAN(const double epsilon,
          const size_t minPoints,
          RangeSearchType rangeSearch = RangeSearchType(),
-         PointSelectionPolicy pointSelector = PointSelectionPolicy());
+         PointSelectionPolicy pointSelector = PointSelectionPolicy(),
+         const size_t batchSize = 0);
 
   /**
    * Performs DBSCAN clustering on the data, returning number of clusters
@@ -104,6 +119,11 @@ class DBSCAN
                  arma::Row<size_t>& assignments,
                  arma::mat& centroids);
 
+  //! Get the batch size for range searches (0 means all points at once).
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size for range searches (0 means all points at once).
+  size_t& BatchSize() { return batchSize; }
+
  private:
   //! Maximum distance between two points to be part of same cluster.
   double epsilon;
@@ -118,6 +138,22 @@ class DBSCAN
   //! Instantiated point selection policy.
   PointSelectionPolicy pointSelector;
 
+  //! Number of points to run range searches for at once (0 means all).
+  size_t batchSize;
+
+  /**
+   * Cluster the data by running range searches for one batch of points at a
+   * time and joining neighboring core points with a union-find structure.
+   * Noise points are given the assignment SIZE_MAX.
+   *
+   * @tparam MatType Type of matrix (arma::mat or arma::sp_mat).
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments.
+   * @return The number of clusters.
+   */
+  template<typename MatType>
+  size_t BatchCluster(const MatType& data, arma::Row<size_t>& assignments);
+
   /**
    * This function processes the point at index. It  marks the point as visited,
    * checks if the given point is core or non-core.  If it is a core point, it
@@ -14,6 +14,10 @@
 
 #include "dbscan.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace dbscan {
 
@@ -25,11 +29,13 @@ DBSCAN<RangeSearchType, PointSelectionPolicy>::DBSCAN(
     const double epsilon,
     const size_t minPoints,
     RangeSearchType rangeSearch,
-    PointSelectionPolicy pointSelector) :
+    PointSelectionPolicy pointSelector,
+    const size_t batchSize) :
     epsilon(epsilon),
     minPoints(minPoints),
     rangeSearch(rangeSearch),
-    pointSelector(pointSelector)
+    pointSelector(pointSelector),
+    batchSize(batchSize)
 {
   // Nothing to do.
 }
@@ -98,6 +104,9 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     const MatType& data,
     arma::Row<size_t>& assignments)
 {
+  if (batchSize > 0)
+    return BatchCluster(data, assignments);
+
   assignments.set_size(data.n_cols);
   assignments.fill(SIZE_MAX);
 
@@ -129,6 +138,114 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
   return currentCluster;
 }
 
+/**
+ * Performs DBSCAN clustering one batch of range searches at a time.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+template<typename MatType>
+size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
+    const MatType& data,
+    arma::Row<size_t>& assignments)
+{
+  // Until the clusters are labeled, the assignment of a border point holds the
+  // index of the core point it was attached to.
+  assignments.set_size(data.n_cols);
+  assignments.fill(SIZE_MAX);
+
+  Log::Debug << "Building range search model." << std::endl;
+  rangeSearch.Train(data);
+
+  std::vector<bool> core(data.n_cols, false);
+  emst::UnionFind components(data.n_cols);
+  std::vector<std::vector<size_t>> neighbors;
+  for (size_t batchStart = 0; batchStart < data.n_cols;
+       batchStart += batchSize)
+  {
+    const size_t batchEnd = std::min(batchStart + batchSize,
+        (size_t) data.n_cols);
+    const size_t count = batchEnd - batchStart;
+    Log::Debug << "Range search for points " << batchStart << " to "
+        << batchEnd - 1 << "." << std::endl;
+
+    // Split the batch between the threads, if the range search object can be
+    // searched by several threads at once.  The distances aren't needed, so
+    // they are discarded as soon as each search is done.
+    size_t numChunks = 1;
+#ifdef HAS_OPENMP
+    if (rangeSearch.SupportsConcurrentSearch())
+      numChunks = std::min((size_t) omp_get_max_threads(), count);
+#endif
+
+    neighbors.clear();
+    neighbors.resize(count);
+
+    // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+    // loop variables.
+    #pragma omp parallel for schedule(dynamic)
+    for (intmax_t c = 0; c < (intmax_t) numChunks; ++c)
+    {
+      const size_t begin = batchStart + c * count / numChunks;
+      const size_t end = batchStart + (c + 1) * count / numChunks;
+      if (begin == end)
+        continue;
+
+      const MatType queries(data.cols(begin, end - 1));
+      std::vector<std::vector<size_t>> chunkNeighbors;
+      std::vector<std::vector<double>> chunkDistances;
+      rangeSearch.Search(queries, math::Range(0.0, epsilon), chunkNeighbors,
+          chunkDistances);
+
+      for (size_t i = 0; i < chunkNeighbors.size(); ++i)
+        neighbors[begin - batchStart + i].swap(chunkNeighbors[i]);
+    }
+
+    // Each neighborhood includes the point itself.
+    for (size_t i = 0; i < count; ++i)
+      core[batchStart + i] = (neighbors[i].size() >= minPoints);
+
+    // Since neighborhoods are symmetric, each pair of neighbors is handled when
+    // the later of the two points is searched for; by then we know whether
+    // both are core points.
+    for (size_t i = 0; i < count; ++i)
+    {
+      const size_t point = batchStart + i;
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+      {
+        const size_t neighbor = neighbors[i][j];
+        if (neighbor >= batchEnd)
+          continue;
+
+        if (core[point] && core[neighbor])
+          components.Union(point, neighbor);
+        else if (core[point] && assignments[neighbor] == SIZE_MAX)
+          assignments[neighbor] = point;
+        else if (core[neighbor] && assignments[point] == SIZE_MAX)
+          assignments[point] = neighbor;
+      }
+    }
+  }
+
+  // Number the clusters in order of their first core point, then label every
+  // point.  Noise points have no core neighbor and keep SIZE_MAX.
+  std::vector<size_t> labels(data.n_cols, SIZE_MAX);
+  size_t numClusters = 0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (core[i] && labels[components.Find(i)] == SIZE_MAX)
+      labels[components.Find(i)] = numClusters++;
+  }
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (core[i])
+      assignments[i] = labels[components.Find(i)];
+    else if (assignments[i] != SIZE_MAX)
+      assignments[i] = labels[components.Find(assignments[i])];
+  }
+
+  return numClusters;
+}
+
 /**
  * This function processes the point at index. It marks the point as visited,
  * checks if the given point is core or non-core. If it is a core point, it
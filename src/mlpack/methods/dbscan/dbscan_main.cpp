@@ -44,6 +44,10 @@ PROGRAM_INFO("DBSCAN clustering",
     "default dual-tree search), and --naive will force brute-force range "
     "search."
     "\n\n"
+    "If --batch_size is set, the range searches are done for that many points "
+    "at a time, in parallel, and clusters are built incrementally; this bounds "
+    "the memory used to store neighborhoods."
+    "\n\n"
     "An example usage to run DBSCAN on the dataset in input.csv with a radius "
     "of 0.5 and a minimum cluster size of 5 is given below:"
     "\n\n"
@@ -65,6 +69,8 @@ PARAM_FLAG("single_mode", "If set, single-tree range search (not dual-tree) "
     "will be used.", "S");
 PARAM_FLAG("naive", "If set, brute-force range search (not tree-based) "
     "will be used.", "N");
+PARAM_INT_IN("batch_size", "If nonzero, run range searches for this many "
+    "points at a time instead of for all points at once.", "b", 0);
 
 // Actually run the clustering, and process the output.
 template<typename RangeSearchType>
@@ -79,8 +85,10 @@ void RunDBSCAN(RangeSearchType rs = RangeSearchType())
 
   const double epsilon = CLI::GetParam<double>("epsilon");
   const size_t minSize = (size_t) CLI::GetParam<int>("min_size");
+  const size_t batchSize = (size_t) CLI::GetParam<int>("batch_size");
 
-  DBSCAN<RangeSearchType> d(epsilon, minSize, rs);
+  DBSCAN<RangeSearchType> d(epsilon, minSize, rs, RandomPointSelection(),
+      batchSize);
 
   // If possible, avoid the overhead of calculating centroids.
   arma::Row<size_t> assignments;
@@ -113,6 +121,10 @@ int main(int argc, char** argv)
   if (CLI::HasParam("single_mode") && CLI::HasParam("naive"))
     Log::Warn << "--single_mode ignored because --naive is specified." << endl;
 
+  if (CLI::GetParam<int>("batch_size") < 0)
+    Log::Fatal << "Invalid batch size (" << CLI::GetParam<int>("batch_size")
+        << "); must be nonnegative!" << endl;
+
   // Fire off naive search if needed.
   if (CLI::HasParam("naive"))
   {
@@ -113,22 +113,28 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
                                  const size_t minLeafSize,
                                  const std::string unprunedTreeOutput)
 {
+  typedef typename MatType::elem_type ElemType;
+  typedef typename DTree<MatType, TagType>::StatType StatType;
+
   // Initialize the tree.
   DTree<MatType, TagType> dtree(dataset);
 
-  // Prepare to grow the tree...
-  arma::Col<size_t> oldFromNew(dataset.n_cols);
-  for (size_t i = 0; i < oldFromNew.n_elem; i++)
-    oldFromNew[i] = i;
-
-  // Save the dataset since it would be modified while growing the tree.
-  MatType newDataset(dataset);
+  // Prepare to grow the tree...  The tree is grown on the indices of the
+  // points, so the dataset is neither copied nor modified.
+  arma::Col<size_t> points(dataset.n_cols);
+  for (size_t i = 0; i < points.n_elem; i++)
+    points[i] = i;
 
   // Growing the tree
   double oldAlpha = 0.0;
-  double alpha = dtree.Grow(newDataset, oldFromNew, useVolumeReg, maxLeafSize,
+  double alpha = dtree.GrowOnPoints(dataset, points, useVolumeReg, maxLeafSize,
       minLeafSize);
 
+  // The optimal tree is a pruned version of this tree, so keep a copy of it
+  // instead of growing it again later.
+  DTree<MatType, TagType>* dtreeOpt = new DTree<MatType, TagType>(dtree);
+  const double fullAlpha = alpha;
+
   Log::Info << dtree.SubtreeLeaves() << " leaf nodes in the tree using full "
       << "dataset; minimum alpha: " << alpha << "." << std::endl;
 
@@ -178,7 +184,6 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   Log::Info << prunedSequence.size() << " trees in the sequence; maximum alpha:"
       << " " << oldAlpha << "." << std::endl;
 
-  MatType cvData(dataset);
   const size_t testSize = dataset.n_cols / folds;
 
   arma::vec regularizationConstants(prunedSequence.size());
@@ -190,46 +195,47 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   // implementation.
 #ifdef _WIN32
   #pragma omp parallel for default(none) \
-      shared(cvData, prunedSequence, regularizationConstants)
+      shared(dataset, prunedSequence, regularizationConstants)
   for (intmax_t fold = 0; fold < (intmax_t) folds; fold++)
 #else
   #pragma omp parallel for default(none) \
-      shared(cvData, prunedSequence, regularizationConstants)
+      shared(dataset, prunedSequence, regularizationConstants)
   for (size_t fold = 0; fold < folds; fold++)
 #endif
   {
-    // Break up data into train and test sets.
+    // Break up data into train and test sets.  The test set is the range of
+    // points [start, end) and the training set is given by the indices of all
+    // the other points, so neither is copied.
     const size_t start = fold * testSize;
     const size_t end = std::min((size_t) (fold + 1)
-                                * testSize, (size_t) cvData.n_cols);
-
-    MatType test = cvData.cols(start, end - 1);
-    MatType train(cvData.n_rows, cvData.n_cols - test.n_cols);
-
-    if (start == 0 && end < cvData.n_cols)
-    {
-      train.cols(0, train.n_cols - 1) = cvData.cols(end, cvData.n_cols - 1);
-    }
-    else if (start > 0 && end == cvData.n_cols)
-    {
-      train.cols(0, train.n_cols - 1) = cvData.cols(0, start - 1);
-    }
-    else
+                                * testSize, (size_t) dataset.n_cols);
+
+    arma::Col<size_t> cvPoints(dataset.n_cols - (end - start));
+    for (size_t i = 0; i < start; ++i)
+      cvPoints[i] = i;
+    for (size_t i = end; i < dataset.n_cols; ++i)
+      cvPoints[i - (end - start)] = i;
+
+    // Find the bounding box of the training set.
+    StatType cvMaxVals(dataset.n_rows);
+    StatType cvMinVals(dataset.n_rows);
+    cvMaxVals.fill(-std::numeric_limits<ElemType>::max());
+    cvMinVals.fill(std::numeric_limits<ElemType>::max());
+    for (size_t i = 0; i < cvPoints.n_elem; ++i)
     {
-      train.cols(0, start - 1) = cvData.cols(0, start - 1);
-      train.cols(start, train.n_cols - 1) = cvData.cols(end, cvData.n_cols - 1);
+      for (size_t d = 0; d < dataset.n_rows; ++d)
+      {
+        const ElemType value = dataset(d, cvPoints[i]);
+        cvMaxVals[d] = std::max(cvMaxVals[d], value);
+        cvMinVals[d] = std::min(cvMinVals[d], value);
+      }
     }
 
     // Initialize the tree.
-    DTree<MatType, TagType> cvDTree(train);
-
-    // Getting ready to grow the tree...
-    arma::Col<size_t> cvOldFromNew(train.n_cols);
-    for (size_t i = 0; i < cvOldFromNew.n_elem; i++)
-      cvOldFromNew[i] = i;
+    DTree<MatType, TagType> cvDTree(cvMaxVals, cvMinVals, cvPoints.n_elem);
 
     // Grow the tree.
-    cvDTree.Grow(train, cvOldFromNew, useVolumeReg, maxLeafSize,
+    cvDTree.GrowOnPoints(dataset, cvPoints, useVolumeReg, maxLeafSize,
         minLeafSize);
 
     // Sequentially prune with all the values of available alphas and adding
@@ -242,32 +248,32 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
     {
       // Compute test values for this state of the tree.
       double cvVal = 0.0;
-      for (size_t j = 0; j < test.n_cols; j++)
+      for (size_t j = start; j < end; j++)
       {
-        arma::vec testPoint = test.unsafe_col(j);
+        typename MatType::vec_type testPoint = dataset.unsafe_col(j);
         cvVal += cvDTree.ComputeValue(testPoint);
       }
 
       // Update the cv regularization constant.
-      cvRegularizationConstants[i] += 2.0 * cvVal / (double) cvData.n_cols;
+      cvRegularizationConstants[i] += 2.0 * cvVal / (double) dataset.n_cols;
 
       // Determine the new alpha value and prune accordingly.
       double cvOldAlpha = 0.5 * (prunedSequence[i + 1].first
                                  + prunedSequence[i + 2].first);
-      cvDTree.PruneAndUpdate(cvOldAlpha, train.n_cols, useVolumeReg);
+      cvDTree.PruneAndUpdate(cvOldAlpha, cvPoints.n_elem, useVolumeReg);
     }
 
     // Compute test values for this state of the tree.
     double cvVal = 0.0;
-    for (size_t i = 0; i < test.n_cols; ++i)
+    for (size_t i = start; i < end; ++i)
     {
-      typename MatType::vec_type testPoint = test.unsafe_col(i);
+      typename MatType::vec_type testPoint = dataset.unsafe_col(i);
       cvVal += cvDTree.ComputeValue(testPoint);
     }
 
     if (prunedSequence.size() > 2)
       cvRegularizationConstants[prunedSequence.size() - 2] += 2.0 * cvVal
-        / (double) cvData.n_cols;
+        / (double) dataset.n_cols;
 
     #pragma omp critical (DTreeCVUpdate)
     regularizationConstants += cvRegularizationConstants;
@@ -293,29 +299,13 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
 
   Log::Info << "Optimal alpha: " << optimalAlpha << "." << std::endl;
 
-  // Initialize the tree.
-  DTree<MatType, TagType>* dtreeOpt = new DTree<MatType, TagType>(dataset);
-
-  // Getting ready to grow the tree...
-  for (size_t i = 0; i < oldFromNew.n_elem; i++)
-    oldFromNew[i] = i;
-
-  // Save the dataset since it would be modified while growing the tree.
-  newDataset = dataset;
-
-  // Grow the tree.
+  // Prune the copy of the full tree with optimal alpha.
   oldAlpha = -DBL_MAX;
-  alpha = dtreeOpt->Grow(newDataset,
-                         oldFromNew,
-                         useVolumeReg,
-                         maxLeafSize,
-                         minLeafSize);
-
-  // Prune with optimal alpha.
+  alpha = fullAlpha;
   while ((oldAlpha < optimalAlpha) && (dtreeOpt->SubtreeLeaves() > 1))
   {
     oldAlpha = alpha;
-    alpha = dtreeOpt->PruneAndUpdate(oldAlpha, newDataset.n_cols, useVolumeReg);
+    alpha = dtreeOpt->PruneAndUpdate(oldAlpha, dataset.n_cols, useVolumeReg);
 
     // Some sanity checks.
     Log::Assert((alpha < std::numeric_limits<double>::max()) ||
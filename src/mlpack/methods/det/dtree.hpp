@@ -162,6 +162,32 @@ class DTree
               const size_t maxLeafSize = 10,
               const size_t minLeafSize = 5);
 
+  /**
+   * Greedily expand the tree on the given points of the dataset, without
+   * modifying or copying the dataset.  Instead, the indices of the points are
+   * reordered so that the points of each node are contiguous, in the same way
+   * that Grow() reorders the dataset.  The tree must be a root with as many
+   * points as there are indices.
+   *
+   * For dense matrices, each dimension of the points is sorted once and the
+   * sorted order is split along with the points, so no node sorts its points
+   * again when it looks for a split.  Large sibling subtrees are grown in
+   * parallel with OpenMP tasks.  Sparse data are copied and split in place on
+   * one thread instead.
+   *
+   * @param data Dataset containing the points.
+   * @param points Indices of the points to build the tree on; reordered during
+   *     tree growth.
+   * @param useVolReg If true, volume regularization is used.
+   * @param maxLeafSize Maximum size of a leaf.
+   * @param minLeafSize Minimum size of a leaf.
+   */
+  double GrowOnPoints(const MatType& data,
+                      arma::Col<size_t>& points,
+                      const bool useVolReg = false,
+                      const size_t maxLeafSize = 10,
+                      const size_t minLeafSize = 5);
+
   /**
    * Perform alpha pruning on a tree.  Returns the new value of alpha.
    *
@@ -329,6 +355,20 @@ class DTree
                  double& rightError,
                  const size_t minLeafSize = 5) const;
 
+  /**
+   * Find the dimension to split on, taking the candidate splits of each
+   * dimension from the given sorted values of the points of the node (one
+   * column per dimension), or from the data if there are no sorted values.
+   */
+  bool FindSplit(const MatType& data,
+                 const arma::Mat<ElemType>& sortedValues,
+                 const size_t totalPoints,
+                 size_t& splitDim,
+                 ElemType& splitValue,
+                 double& leftError,
+                 double& rightError,
+                 const size_t minLeafSize) const;
+
   /**
    * Split the data, returning the number of points left of the split.
    */
@@ -337,6 +377,78 @@ class DTree
                    const ElemType splitValue,
                    arma::Col<size_t>& oldFromNew) const;
 
+  /**
+   * Split the indices of the points of the node in the same way SplitData()
+   * splits the data, returning the index of the first point right of the
+   * split.
+   */
+  size_t SplitPoints(const MatType& data,
+                     const size_t splitDim,
+                     const ElemType splitValue,
+                     arma::Col<size_t>& points) const;
+
+  /**
+   * Stably partition the sorted values and indices of every dimension of the
+   * node between the children, given the split indices of the points.
+   */
+  void SplitSortedPoints(const size_t splitIndex,
+                         const arma::Col<size_t>& points,
+                         arma::Mat<ElemType>& sortedValues,
+                         arma::Mat<size_t>& sortedPoints,
+                         std::vector<char>& goesLeft) const;
+
+  /**
+   * Grow the subtree of this node by splitting the data in place.  This is used
+   * for sparse data, and the children are grown one after the other.
+   */
+  double GrowNode(MatType& data,
+                  arma::Col<size_t>& oldFromNew,
+                  const bool useVolReg,
+                  const size_t maxLeafSize,
+                  const size_t minLeafSize);
+
+  /**
+   * Grow the subtree of this node from the sorted values and indices of its
+   * points in each dimension.
+   */
+  double GrowNode(const MatType& data,
+                  arma::Col<size_t>& points,
+                  arma::Mat<ElemType>& sortedValues,
+                  arma::Mat<size_t>& sortedPoints,
+                  std::vector<char>& goesLeft,
+                  const bool useVolReg,
+                  const size_t maxLeafSize,
+                  const size_t minLeafSize);
+
+  /**
+   * Compute the log of the volume of the node and its ratio of the points.
+   */
+  void InitializeNode(const size_t totalPoints);
+
+  /**
+   * Create the children of the node for the given split.
+   */
+  void CreateChildren(const size_t dim,
+                      const ElemType value,
+                      const size_t splitIndex,
+                      const double leftError,
+                      const double rightError);
+
+  /**
+   * Whether the children of the node are large enough to be grown in parallel.
+   */
+  bool ForkChildren() const;
+
+  /**
+   * Once the children (if any) are grown, compute the error of the subtree
+   * leaves and alpha for the node, and return the minimum g_k(t) of the
+   * subtree.
+   */
+  double UpdateAlpha(const double leftG,
+                     const double rightG,
+                     const size_t totalPoints,
+                     const bool useVolReg);
+
 };
 
 } // namespace det
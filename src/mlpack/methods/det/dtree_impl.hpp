@@ -15,11 +15,40 @@
 #include <stack>
 #include <vector>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 using namespace mlpack;
 using namespace det;
 
 namespace details
 {
+  /**
+   * This one scans the already sorted values of a dimension and puts all splits
+   * in a vector, that can easily be iterated afterwards.
+   */
+  template <typename ElemType>
+  void ExtractSortedSplits(std::vector<std::pair<ElemType, size_t>>& splitVec,
+                           const ElemType* sortedVals,
+                           const size_t n_elem,
+                           const size_t minLeafSize)
+  {
+    typedef std::pair<ElemType, size_t> SplitItem;
+
+    for (size_t i = minLeafSize - 1; i < n_elem - minLeafSize; ++i)
+    {
+      // This makes sense for real continuous data. This kinda corrupts the
+      // data and estimation if the data is ordinal. Potentially we can fix
+      // that by taking into account ordinality later in the min/max update,
+      // but then we can end-up with a zero-volumed dimension. No good.
+      const ElemType split = (sortedVals[i] + sortedVals[i + 1]) / 2.0;
+
+      if (split != sortedVals[i])
+        splitVec.push_back(SplitItem(split, i + 1));
+    }
+  }
+
   /**
    * This one sorts and scand the given per-dimension extract and puts all splits
    * in a vector, that can easily be iterated afterwards. General implementation.
@@ -66,23 +95,12 @@ namespace details
                      const size_t end,
                      const size_t minLeafSize)
   {
-    typedef std::pair<ElemType, size_t> SplitItem;
-    arma::vec dimVec = data(dim, arma::span(start, end - 1)).t();
+    arma::Col<ElemType> dimVec = data(dim, arma::span(start, end - 1)).t();
 
     // We sort these, in-place (it's a copy of the data, anyways).
     std::sort(dimVec.begin(), dimVec.end());
 
-    for (size_t i = minLeafSize - 1; i < dimVec.n_elem - minLeafSize; ++i)
-    {
-      // This makes sense for real continuous data. This kinda corrupts the
-      // data and estimation if the data is ordinal. Potentially we can fix
-      // that by taking into account ordinality later in the min/max update,
-      // but then we can end-up with a zero-volumed dimension. No good.
-      const ElemType split = (dimVec[i] + dimVec[i + 1]) / 2.0;
-
-      if (split != dimVec[i])
-        splitVec.push_back(SplitItem(split, i + 1));
-    }
+    ExtractSortedSplits(splitVec, dimVec.memptr(), dimVec.n_elem, minLeafSize);
   }
 
   // This the custom, sparse optimized implementation of the same routine.
@@ -145,6 +163,57 @@ namespace details
       lastVal = newVal;
     }
   }
+
+  /**
+   * Copy the given columns of a dense matrix into a new matrix.
+   */
+  template <typename ElemType>
+  void ExtractColumns(const arma::Mat<ElemType>& data,
+                      const arma::Col<size_t>& points,
+                      arma::Mat<ElemType>& subset)
+  {
+    subset.set_size(data.n_rows, points.n_elem);
+    for (size_t i = 0; i < points.n_elem; ++i)
+      subset.col(i) = data.col(points[i]);
+  }
+
+  /**
+   * Copy the given columns of a sparse matrix into a new matrix.  Inserting
+   * the columns one at a time would move all the nonzeros inserted before each
+   * of them, so the nonzeros are gathered and inserted all at once.
+   */
+  template <typename ElemType>
+  void ExtractColumns(const arma::SpMat<ElemType>& data,
+                      const arma::Col<size_t>& points,
+                      arma::SpMat<ElemType>& subset)
+  {
+    typedef typename arma::SpMat<ElemType>::const_iterator IteratorType;
+
+    size_t nonZeros = 0;
+    for (size_t i = 0; i < points.n_elem; ++i)
+    {
+      for (IteratorType it = data.begin_col(points[i]);
+           it != data.end_col(points[i]); ++it)
+        ++nonZeros;
+    }
+
+    arma::umat locations(2, nonZeros);
+    arma::Col<ElemType> values(nonZeros);
+    size_t k = 0;
+    for (size_t i = 0; i < points.n_elem; ++i)
+    {
+      for (IteratorType it = data.begin_col(points[i]);
+           it != data.end_col(points[i]); ++it, ++k)
+      {
+        locations(0, k) = it.row();
+        locations(1, k) = i;
+        values[k] = *it;
+      }
+    }
+
+    subset = arma::SpMat<ElemType>(locations, values, data.n_rows,
+        points.n_elem);
+  }
 };
 
 template <typename MatType, typename TagType>
@@ -432,6 +501,23 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
                                         double& leftError,
                                         double& rightError,
                                         const size_t minLeafSize) const
+{
+  return FindSplit(data, arma::Mat<ElemType>(), data.n_cols, splitDim,
+      splitValue, leftError, rightError, minLeafSize);
+}
+
+// If sorted values of the points of the node are given, the splits are taken
+// from them instead of sorting each dimension of the node.  The errors are
+// normalized by the given total number of points of the tree.
+template <typename MatType, typename TagType>
+bool DTree<MatType, TagType>::FindSplit(const MatType& data,
+                                        const arma::Mat<ElemType>& sortedValues,
+                                        const size_t totalPoints,
+                                        size_t& splitDim,
+                                        ElemType& splitValue,
+                                        double& leftError,
+                                        double& rightError,
+                                        const size_t minLeafSize) const
 {
   typedef std::pair<ElemType, size_t>   SplitItem;
 
@@ -479,7 +565,12 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
     // This one has custom implementation for dense and sparse matrices.
 
     std::vector<SplitItem> splitVec;
-    details::ExtractSplits<ElemType>(splitVec, data, dim, start, end, minLeafSize);
+    if (sortedValues.n_elem > 0)
+      details::ExtractSortedSplits<ElemType>(splitVec,
+          sortedValues.colptr(dim) + start, points, minLeafSize);
+    else
+      details::ExtractSplits<ElemType>(splitVec, data, dim, start, end,
+          minLeafSize);
 
     // Iterate on all the splits for this dimension
     for (typename std::vector<SplitItem>::iterator i = splitVec.begin();
@@ -519,7 +610,7 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
     }
 
     const double actualMinDimError = std::log(minDimError)
-      - 2 * std::log((double) data.n_cols)
+      - 2 * std::log((double) totalPoints)
       - volumeWithoutDim;
 
 #pragma omp critical (DTreeFindUpdate)
@@ -530,9 +621,9 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
       minError = actualMinDimError;
       splitDim = dim;
       splitValue = dimSplitValue;
-      leftError = std::log(dimLeftError) - 2 * std::log((double) data.n_cols)
+      leftError = std::log(dimLeftError) - 2 * std::log((double) totalPoints)
         - volumeWithoutDim;
-      rightError = std::log(dimRightError) - 2 * std::log((double) data.n_cols)
+      rightError = std::log(dimRightError) - 2 * std::log((double) totalPoints)
         - volumeWithoutDim;
       splitFound = true;
     } // end if better split found in this dimension.
@@ -575,6 +666,80 @@ size_t DTree<MatType, TagType>::SplitData(MatType& data,
   return left;
 }
 
+// This performs the same swaps as SplitData(), but on the indices of the points
+// instead of the columns of the data.
+template <typename MatType, typename TagType>
+size_t DTree<MatType, TagType>::SplitPoints(const MatType& data,
+                                            const size_t splitDim,
+                                            const ElemType splitValue,
+                                            arma::Col<size_t>& points) const
+{
+  size_t left = start;
+  size_t right = end - 1;
+  for (;;)
+  {
+    while (data(splitDim, points[left]) <= splitValue)
+      ++left;
+    while (data(splitDim, points[right]) > splitValue)
+      --right;
+
+    if (left > right)
+      break;
+
+    const size_t tmp = points[left];
+    points[left] = points[right];
+    points[right] = tmp;
+  }
+
+  // This now refers to the first index of the "right" side.
+  return left;
+}
+
+template <typename MatType, typename TagType>
+void DTree<MatType, TagType>::SplitSortedPoints(
+    const size_t splitIndex,
+    const arma::Col<size_t>& points,
+    arma::Mat<ElemType>& sortedValues,
+    arma::Mat<size_t>& sortedPoints,
+    std::vector<char>& goesLeft) const
+{
+  // Mark which side each point of the node went to.  Nodes being grown at the
+  // same time hold different points, so they never write the same flag.
+  for (size_t i = start; i < end; ++i)
+    goesLeft[points[i]] = (i < splitIndex);
+
+  // Stably partition each dimension, so that the points of both children are
+  // still sorted.
+  std::vector<ElemType> rightValues;
+  std::vector<size_t> rightPoints;
+  for (size_t dim = 0; dim < sortedValues.n_cols; ++dim)
+  {
+    ElemType* values = sortedValues.colptr(dim);
+    size_t* indices = sortedPoints.colptr(dim);
+
+    rightValues.clear();
+    rightPoints.clear();
+    size_t next = start;
+    for (size_t i = start; i < end; ++i)
+    {
+      if (goesLeft[indices[i]])
+      {
+        values[next] = values[i];
+        indices[next] = indices[i];
+        ++next;
+      }
+      else
+      {
+        rightValues.push_back(values[i]);
+        rightPoints.push_back(indices[i]);
+      }
+    }
+
+    std::copy(rightValues.begin(), rightValues.end(), values + next);
+    std::copy(rightPoints.begin(), rightPoints.end(), indices + next);
+  }
+}
+
 // Greedily expand the tree
 template <typename MatType, typename TagType>
 double DTree<MatType, TagType>::Grow(MatType& data,
@@ -586,23 +751,117 @@ double DTree<MatType, TagType>::Grow(MatType& data,
   Log::Assert(data.n_rows == maxVals.n_elem);
   Log::Assert(data.n_rows == minVals.n_elem);
 
-  double leftG, rightG;
+  double alpha;
+  if (arma::is_SpMat<MatType>::value)
+  {
+    // Sorted copies of sparse dimensions would be dense, so sparse data is
+    // split in place, on one thread.
+    alpha = GrowNode(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+  }
+  else
+  {
+    arma::Col<size_t> points(data.n_cols);
+    for (size_t i = 0; i < points.n_elem; ++i)
+      points[i] = i;
 
-  // Compute points ratio.
-  ratio = (double) (end - start) / (double) oldFromNew.n_elem;
+    alpha = GrowOnPoints(data, points, useVolReg, maxLeafSize, minLeafSize);
 
-  // Compute the log of the volume of the node.
-  logVolume = 0;
-  for (size_t i = 0; i < maxVals.n_elem; ++i)
-    if (maxVals[i] - minVals[i] > 0.0)
-      logVolume += std::log(maxVals[i] - minVals[i]);
+    // Reorder the data in the same way it would have been reordered by
+    // splitting it in place.
+    MatType newData(data.n_rows, data.n_cols);
+    arma::Col<size_t> newOldFromNew(oldFromNew.n_elem);
+    for (size_t i = 0; i < points.n_elem; ++i)
+    {
+      newData.col(i) = data.col(points[i]);
+      newOldFromNew[i] = oldFromNew[points[i]];
+    }
+
+    data = std::move(newData);
+    oldFromNew = std::move(newOldFromNew);
+  }
+
+  return alpha;
+}
+
+template <typename MatType, typename TagType>
+double DTree<MatType, TagType>::GrowOnPoints(const MatType& data,
+                                             arma::Col<size_t>& points,
+                                             const bool useVolReg,
+                                             const size_t maxLeafSize,
+                                             const size_t minLeafSize)
+{
+  Log::Assert(data.n_rows == maxVals.n_elem);
+  Log::Assert(data.n_rows == minVals.n_elem);
+  Log::Assert(start == 0 && end == points.n_elem);
+
+  double alpha;
+  if (arma::is_SpMat<MatType>::value)
+  {
+    // Sorted copies of sparse dimensions would be dense, so the points are
+    // copied and split in place instead, on one thread.
+    MatType subset;
+    details::ExtractColumns(data, points, subset);
+
+    arma::Col<size_t> oldFromNew(points);
+    alpha = GrowNode(subset, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+
+    points = std::move(oldFromNew);
+    return alpha;
+  }
+
+  // Sort each dimension of the points once.  Each column holds the values of
+  // one dimension in sorted order, and the indices of the corresponding points.
+  arma::Mat<ElemType> sortedValues(points.n_elem, data.n_rows);
+  arma::Mat<size_t> sortedPoints(points.n_elem, data.n_rows);
+
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables.
+  #pragma omp parallel for
+  for (intmax_t dim = 0; dim < (intmax_t) data.n_rows; ++dim)
+  {
+    arma::Col<ElemType> values(points.n_elem);
+    for (size_t i = 0; i < points.n_elem; ++i)
+      values[i] = data(dim, points[i]);
+
+    const arma::uvec order = arma::sort_index(values);
+    for (size_t i = 0; i < points.n_elem; ++i)
+    {
+      sortedValues(i, dim) = values[order[i]];
+      sortedPoints(i, dim) = points[order[i]];
+    }
+  }
+
+  // The subtrees are grown as tasks, so we need a team of threads to execute
+  // them; growth starts on only one of them.
+  std::vector<char> goesLeft(data.n_cols);
+  #pragma omp parallel
+  {
+    #pragma omp single
+    alpha = GrowNode(data, points, sortedValues, sortedPoints, goesLeft,
+        useVolReg, maxLeafSize, minLeafSize);
+  }
+
+  return alpha;
+}
+
+template <typename MatType, typename TagType>
+double DTree<MatType, TagType>::GrowNode(MatType& data,
+                                         arma::Col<size_t>& oldFromNew,
+                                         const bool useVolReg,
+                                         const size_t maxLeafSize,
+                                         const size_t minLeafSize)
+{
+  InitializeNode(oldFromNew.n_elem);
+
+  double leftG = 0.0;
+  double rightG = 0.0;
 
   // Check if node is large enough to split.
   if ((size_t) (end - start) > maxLeafSize)
   {
     // Find the split.
     size_t dim;
-    double splitValueTmp;
+    ElemType splitValueTmp;
     double leftError, rightError;
     if (FindSplit(data, dim, splitValueTmp, leftError, rightError, minLeafSize))
     {
@@ -610,121 +869,223 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       // contiguously (to increase efficiency during the training).
       const size_t splitIndex = SplitData(data, dim, splitValueTmp, oldFromNew);
 
-      // Make max and min vals for the children.
-      StatType maxValsL(maxVals);
-      StatType maxValsR(maxVals);
-      StatType minValsL(minVals);
-      StatType minValsR(minVals);
+      CreateChildren(dim, splitValueTmp, splitIndex, leftError, rightError);
 
-      maxValsL[dim] = splitValueTmp;
-      minValsR[dim] = splitValueTmp;
-
-      // Store split dim and split val in the node.
-      splitValue = splitValueTmp;
-      splitDim = dim;
+      // Recursively grow the children.  Splitting a sparse matrix in place
+      // changes the storage of the whole matrix, so the children can't be
+      // grown at the same time.
+      leftG = left->GrowNode(data, oldFromNew, useVolReg, maxLeafSize,
+          minLeafSize);
+      rightG = right->GrowNode(data, oldFromNew, useVolReg, maxLeafSize,
+          minLeafSize);
+    }
+  }
+  else
+  {
+    // We can make this a leaf node.
+    Log::Assert((size_t) (end - start) >= minLeafSize);
+  }
 
-      // Recursively grow the children.
-      left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
-      right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
+  return UpdateAlpha(leftG, rightG, data.n_cols, useVolReg);
+}
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+template <typename MatType, typename TagType>
+double DTree<MatType, TagType>::GrowNode(const MatType& data,
+                                         arma::Col<size_t>& points,
+                                         arma::Mat<ElemType>& sortedValues,
+                                         arma::Mat<size_t>& sortedPoints,
+                                         std::vector<char>& goesLeft,
+                                         const bool useVolReg,
+                                         const size_t maxLeafSize,
+                                         const size_t minLeafSize)
+{
+  InitializeNode(points.n_elem);
 
-      // Store values of R(T~) and |T~|.
-      subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
+  double leftG = 0.0;
+  double rightG = 0.0;
 
-      // Find the log negative error of the subtree leaves.  This is kind of an
-      // odd one because we don't want to represent the error in non-log-space,
-      // but we have to calculate log(E_l + E_r).  So we multiply E_l and E_r by
-      // V_t (remember E_l has an inverse relationship to the volume of the
-      // nodes) and then subtract log(V_t) at the end of the whole expression.
-      // As a result we do leave log-space, but the largest quantity we
-      // represent is on the order of (V_t / V_i) where V_i is the smallest leaf
-      // node below this node, which depends heavily on the depth of the tree.
-      subtreeLeavesLogNegError = std::log(
-          std::exp(logVolume + left->SubtreeLeavesLogNegError()) +
-          std::exp(logVolume + right->SubtreeLeavesLogNegError()))
-          - logVolume;
-    }
-    else
+  // Check if node is large enough to split.
+  if ((size_t) (end - start) > maxLeafSize)
+  {
+    // Find the split.
+    size_t dim;
+    ElemType splitValueTmp;
+    double leftError, rightError;
+    if (FindSplit(data, sortedValues, points.n_elem, dim, splitValueTmp,
+        leftError, rightError, minLeafSize))
     {
-      // No split found so make a leaf out of it.
-      subtreeLeaves = 1;
-      subtreeLeavesLogNegError = logNegError;
+      // Reorder the points so that the points of each child are contiguous,
+      // and keep each dimension of each child sorted.
+      const size_t splitIndex = SplitPoints(data, dim, splitValueTmp, points);
+      SplitSortedPoints(splitIndex, points, sortedValues, sortedPoints,
+          goesLeft);
+
+      CreateChildren(dim, splitValueTmp, splitIndex, leftError, rightError);
+
+      // Recursively grow the children.  They hold disjoint ranges of the
+      // points and the sorted values, so they can be grown at the same time.
+      if (ForkChildren())
+      {
+        #pragma omp task default(shared)
+        rightG = right->GrowNode(data, points, sortedValues, sortedPoints,
+            goesLeft, useVolReg, maxLeafSize, minLeafSize);
+
+        leftG = left->GrowNode(data, points, sortedValues, sortedPoints,
+            goesLeft, useVolReg, maxLeafSize, minLeafSize);
+
+        #pragma omp taskwait
+      }
+      else
+      {
+        leftG = left->GrowNode(data, points, sortedValues, sortedPoints,
+            goesLeft, useVolReg, maxLeafSize, minLeafSize);
+        rightG = right->GrowNode(data, points, sortedValues, sortedPoints,
+            goesLeft, useVolReg, maxLeafSize, minLeafSize);
+      }
     }
   }
   else
   {
     // We can make this a leaf node.
     Log::Assert((size_t) (end - start) >= minLeafSize);
-    subtreeLeaves = 1;
-    subtreeLeavesLogNegError = logNegError;
   }
 
-  // If this is a leaf, do not compute g_k(t); otherwise compute, store, and
-  // propagate min(g_k(t_L), g_k(t_R), g_k(t)), unless t_L and/or t_R are
-  // leaves.
-  if (subtreeLeaves == 1)
+  return UpdateAlpha(leftG, rightG, points.n_elem, useVolReg);
+}
+
+template <typename MatType, typename TagType>
+void DTree<MatType, TagType>::InitializeNode(const size_t totalPoints)
+{
+  // Compute points ratio.
+  ratio = (double) (end - start) / (double) totalPoints;
+
+  // Compute the log of the volume of the node.
+  logVolume = 0;
+  for (size_t i = 0; i < maxVals.n_elem; ++i)
+    if (maxVals[i] - minVals[i] > 0.0)
+      logVolume += std::log(maxVals[i] - minVals[i]);
+}
+
+template <typename MatType, typename TagType>
+void DTree<MatType, TagType>::CreateChildren(const size_t dim,
+                                             const ElemType value,
+                                             const size_t splitIndex,
+                                             const double leftError,
+                                             const double rightError)
+{
+  // Make max and min vals for the children.
+  StatType maxValsL(maxVals);
+  StatType maxValsR(maxVals);
+  StatType minValsL(minVals);
+  StatType minValsR(minVals);
+
+  maxValsL[dim] = value;
+  minValsR[dim] = value;
+
+  // Store split dim and split val in the node.
+  splitValue = value;
+  splitDim = dim;
+
+  left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
+  right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
+}
+
+template <typename MatType, typename TagType>
+bool DTree<MatType, TagType>::ForkChildren() const
+{
+  // Below this many points, a subtree is too cheap to grow to be worth a task.
+  const size_t minForkSize = 1000;
+
+  bool fork = (left->End() - left->Start() >= minForkSize) &&
+      (right->End() - right->Start() >= minForkSize);
+#ifdef HAS_OPENMP
+  fork = fork && (omp_get_num_threads() > 1);
+#else
+  fork = false;
+#endif
+
+  return fork;
+}
+
+template <typename MatType, typename TagType>
+double DTree<MatType, TagType>::UpdateAlpha(const double leftG,
+                                            const double rightG,
+                                            const size_t totalPoints,
+                                            const bool useVolReg)
+{
+  // If this is a leaf, do not compute g_k(t).
+  if (left == NULL)
   {
+    subtreeLeaves = 1;
+    subtreeLeavesLogNegError = logNegError;
+
     return std::numeric_limits<double>::max();
   }
-  else
-  {
-    const double range = maxVals[splitDim] - minVals[splitDim];
-    const double leftRatio = (splitValue - minVals[splitDim]) / range;
-    const double rightRatio = (maxVals[splitDim] - splitValue) / range;
 
-    const size_t leftPow = std::pow((double) (left->End() - left->Start()), 2);
-    const size_t rightPow = std::pow((double) (right->End() - right->Start()),
-        2);
-    const size_t thisPow = std::pow((double) (end - start), 2);
+  // Store values of R(T~) and |T~|.
+  subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
+
+  // Find the log negative error of the subtree leaves.  This is kind of an odd
+  // one because we don't want to represent the error in non-log-space, but we
+  // have to calculate log(E_l + E_r).  So we multiply E_l and E_r by V_t
+  // (remember E_l has an inverse relationship to the volume of the nodes) and
+  // then subtract log(V_t) at the end of the whole expression.  As a result we
+  // do leave log-space, but the largest quantity we represent is on the order
+  // of (V_t / V_i) where V_i is the smallest leaf node below this node, which
+  // depends heavily on the depth of the tree.
+  subtreeLeavesLogNegError = std::log(
+      std::exp(logVolume + left->SubtreeLeavesLogNegError()) +
+      std::exp(logVolume + right->SubtreeLeavesLogNegError()))
+      - logVolume;
 
-    double tmpAlphaSum = leftPow / leftRatio + rightPow / rightRatio - thisPow;
+  // Compute, store, and propagate min(g_k(t_L), g_k(t_R), g_k(t)), unless t_L
+  // and/or t_R are leaves.
+  const double range = maxVals[splitDim] - minVals[splitDim];
+  const double leftRatio = (splitValue - minVals[splitDim]) / range;
+  const double rightRatio = (maxVals[splitDim] - splitValue) / range;
 
-    if (left->SubtreeLeaves() > 1)
-    {
-      const double exponent = 2 * std::log((double) data.n_cols) + logVolume +
-          left->AlphaUpper();
+  const size_t leftPow = std::pow((double) (left->End() - left->Start()), 2);
+  const size_t rightPow = std::pow((double) (right->End() - right->Start()), 2);
+  const size_t thisPow = std::pow((double) (end - start), 2);
 
-      // Whether or not this will overflow is highly dependent on the depth of
-      // the tree.
-      tmpAlphaSum += std::exp(exponent);
-    }
+  double tmpAlphaSum = leftPow / leftRatio + rightPow / rightRatio - thisPow;
 
-    if (right->SubtreeLeaves() > 1)
-    {
-      const double exponent = 2 * std::log((double) data.n_cols)
-        + logVolume
-        + right->AlphaUpper();
+  if (left->SubtreeLeaves() > 1)
+  {
+    const double exponent = 2 * std::log((double) totalPoints) + logVolume +
+        left->AlphaUpper();
 
-      tmpAlphaSum += std::exp(exponent);
-    }
+    // Whether or not this will overflow is highly dependent on the depth of
+    // the tree.
+    tmpAlphaSum += std::exp(exponent);
+  }
 
-    alphaUpper = std::log(tmpAlphaSum) - 2 * std::log((double) data.n_cols)
-      - logVolume;
+  if (right->SubtreeLeaves() > 1)
+  {
+    const double exponent = 2 * std::log((double) totalPoints)
+      + logVolume
+      + right->AlphaUpper();
 
-    double gT;
-    if (useVolReg)
-    {
-      // This is wrong for now!
-      gT = alphaUpper;// / (subtreeLeavesVTInv - vTInv);
-    }
-    else
-    {
-      gT = alphaUpper - std::log((double) (subtreeLeaves - 1));
-    }
+    tmpAlphaSum += std::exp(exponent);
+  }
+
+  alphaUpper = std::log(tmpAlphaSum) - 2 * std::log((double) totalPoints)
+    - logVolume;
 
-    return std::min(gT, std::min(leftG, rightG));
+  double gT;
+  if (useVolReg)
+  {
+    // This is wrong for now!
+    gT = alphaUpper;// / (subtreeLeavesVTInv - vTInv);
+  }
+  else
+  {
+    gT = alphaUpper - std::log((double) (subtreeLeaves - 1));
   }
 
-  // We need to compute (c_t^2) * r_t for all subtree leaves; this is equal to
-  // n_t ^ 2 / r_t * n ^ 2 = -error.  Therefore the value we need is actually
-  // -1.0 * subtreeLeavesError.
+  return std::min(gT, std::min(leftG, rightG));
 }
 
-
 template <typename MatType, typename TagType>
 double DTree<MatType, TagType>::PruneAndUpdate(const double oldAlpha,
                                                const size_t points,
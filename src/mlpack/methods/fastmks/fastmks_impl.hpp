@@ -352,6 +352,8 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
 
     Log::Info << rules.BaseCases() << " base cases." << std::endl;
     Log::Info << rules.Scores() << " scores." << std::endl;
+    Log::Info << rules.CacheHits() << " cached kernel evaluations reused."
+        << std::endl;
 
     rules.GetResults(indices, kernels);
 
@@ -409,6 +411,8 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
 
   Log::Info << rules.BaseCases() << " base cases." << std::endl;
   Log::Info << rules.Scores() << " scores." << std::endl;
+  Log::Info << rules.CacheHits() << " cached kernel evaluations reused."
+      << std::endl;
 
   rules.GetResults(indices, kernels);
 
@@ -489,6 +493,8 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
 
     Log::Info << rules.BaseCases() << " base cases." << std::endl;
     Log::Info << rules.Scores() << " scores." << std::endl;
+    Log::Info << rules.CacheHits() << " cached kernel evaluations reused."
+        << std::endl;
 
     rules.GetResults(indices, kernels);
 
@@ -26,6 +26,15 @@ namespace fastmks {
  * performing exact max-kernel search. For each point in the query dataset, it
  * keeps track of the k best candidates in the reference dataset.
  *
+ * The same pair of points is often evaluated several times during a traversal,
+ * because cover tree nodes share points with their parents and children.  So
+ * the kernel values that BaseCase() computes for the current query point (the
+ * point of the current query node, for a cover tree) are kept in a small
+ * open-addressing table keyed by the reference index; a pair found in the
+ * table is not evaluated again.  The table is emptied when the query point
+ * changes, and when all the slots a reference point may occupy are taken, the
+ * first of them is overwritten.
+ *
  * @tparam KernelType Type of kernel to run FastMKS with.
  * @tparam TreeType Type of tree to run FastMKS with; it must satisfy the
  *     TreeType policy API.
@@ -119,6 +128,12 @@ class FastMKSRules
   //! Modify the number of times Score() was called.
   size_t& Scores() { return scores; }
 
+  //! Get the number of times BaseCase() reused a cached kernel value instead of
+  //! evaluating the kernel.
+  size_t CacheHits() const { return cacheHits; }
+  //! Modify the number of times BaseCase() reused a cached kernel value.
+  size_t& CacheHits() { return cacheHits; }
+
   typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
 
   const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
@@ -169,6 +184,49 @@ class FastMKSRules
   //! The last kernel evaluation resulting from BaseCase().
   double lastKernel;
 
+  //! An entry of the kernel cache.
+  struct CacheEntry
+  {
+    //! The reference index.
+    size_t referenceIndex;
+    //! The generation of the cache the entry was stored in; entries of other
+    //! generations are empty.
+    size_t generation;
+    //! The kernel value between the cached query point and the reference
+    //! point.
+    double kernel;
+  };
+
+  //! The number of slots of the kernel cache (a power of two).
+  static const size_t cacheSize = 256;
+  //! The number of slots a reference point may occupy in the kernel cache.
+  static const size_t cacheProbes = 4;
+
+  //! The query point whose kernel values are cached.
+  size_t cacheQueryIndex;
+  //! The generation of the kernel cache; it changes with the query point.
+  size_t cacheGeneration;
+  //! Cached kernel evaluations of the query point, with open addressing and
+  //! linear probing.
+  std::vector<CacheEntry> kernelCache;
+
+  //! Get the first slot of the kernel cache for the given reference point.
+  size_t CacheSlot(const size_t referenceIndex) const;
+
+  /**
+   * Look for the kernel value between the cached query point and the given
+   * reference point in the cache.
+   *
+   * @param referenceIndex Index of the reference point.
+   * @param kernelEval Set to the cached kernel value, if it is found.
+   * @return Whether the kernel value was found.
+   */
+  bool LookupKernel(const size_t referenceIndex, double& kernelEval) const;
+
+  //! Store the kernel value between the cached query point and the given
+  //! reference point in the cache.
+  void StoreKernel(const size_t referenceIndex, const double kernelEval);
+
   //! Calculate the bound for a given query node.
   double CalculateBound(TreeType& queryNode) const;
 
@@ -187,6 +245,8 @@ class FastMKSRules
   size_t baseCases;
   //! For benchmarking.
   size_t scores;
+  //! For benchmarking.
+  size_t cacheHits;
 
   TraversalInfoType traversalInfo;
 };
@@ -31,20 +31,38 @@ FastMKSRules<KernelType, TreeType>::FastMKSRules(
     lastQueryIndex(-1),
     lastReferenceIndex(-1),
     lastKernel(0.0),
+    cacheQueryIndex(-1),
+    cacheGeneration(0),
     baseCases(0),
-    scores(0)
+    scores(0),
+    cacheHits(0)
 {
-  // Precompute each self-kernel.
-  queryKernels.set_size(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    queryKernels[i] = sqrt(kernel.Evaluate(querySet.col(i),
-                                           querySet.col(i)));
-
+  // Precompute each self-kernel.  If the query set is the reference set, the
+  // self-kernels are only computed once.
   referenceKernels.set_size(referenceSet.n_cols);
   for (size_t i = 0; i < referenceSet.n_cols; ++i)
     referenceKernels[i] = sqrt(kernel.Evaluate(referenceSet.col(i),
                                                referenceSet.col(i)));
 
+  if (&querySet == &referenceSet)
+  {
+    queryKernels = referenceKernels;
+  }
+  else
+  {
+    queryKernels.set_size(querySet.n_cols);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      queryKernels[i] = sqrt(kernel.Evaluate(querySet.col(i),
+                                             querySet.col(i)));
+  }
+
+  // Start with an empty kernel cache.
+  CacheEntry empty;
+  empty.referenceIndex = size_t(-1);
+  empty.generation = cacheGeneration;
+  empty.kernel = 0.0;
+  kernelCache.assign(cacheSize, empty);
+
   // Set to invalid memory, so that the first node combination does not try to
   // dereference null pointers.
   traversalInfo.LastQueryNode() = (TreeType*) this;
@@ -98,16 +116,40 @@ double FastMKSRules<KernelType, TreeType>::BaseCase(
   {
     if ((queryIndex == lastQueryIndex) &&
         (referenceIndex == lastReferenceIndex))
+    {
+      ++cacheHits;
       return lastKernel;
+    }
 
     // Store new values.
     lastQueryIndex = queryIndex;
     lastReferenceIndex = referenceIndex;
   }
 
+  // The cache only holds the kernel values of one query point, so empty it if
+  // this is another one.
+  if (queryIndex != cacheQueryIndex)
+  {
+    cacheQueryIndex = queryIndex;
+    ++cacheGeneration;
+  }
+
+  // If this pair was already evaluated, its result has already been inserted,
+  // so there is nothing more to do.
+  double kernelEval;
+  if (LookupKernel(referenceIndex, kernelEval))
+  {
+    ++cacheHits;
+    if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
+      lastKernel = kernelEval;
+
+    return kernelEval;
+  }
+
   ++baseCases;
-  double kernelEval = kernel.Evaluate(querySet.col(queryIndex),
-                                      referenceSet.col(referenceIndex));
+  kernelEval = kernel.Evaluate(querySet.col(queryIndex),
+                               referenceSet.col(referenceIndex));
+  StoreKernel(referenceIndex, kernelEval);
 
   // Update the last kernel value, if we need to.
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
@@ -538,6 +580,56 @@ inline void FastMKSRules<KernelType, TreeType>::InsertNeighbor(
   }
 }
 
+template<typename KernelType, typename TreeType>
+inline size_t FastMKSRules<KernelType, TreeType>::CacheSlot(
+    const size_t referenceIndex) const
+{
+  // Points that are close in a tree often have close indices, so spread them
+  // over the slots (multiplicative hashing).
+  return ((referenceIndex * 2654435761u) >> 8) & (cacheSize - 1);
+}
+
+template<typename KernelType, typename TreeType>
+inline bool FastMKSRules<KernelType, TreeType>::LookupKernel(
+    const size_t referenceIndex,
+    double& kernelEval) const
+{
+  const size_t slot = CacheSlot(referenceIndex);
+  for (size_t i = 0; i < cacheProbes; ++i)
+  {
+    const CacheEntry& entry = kernelCache[(slot + i) & (cacheSize - 1)];
+    if (entry.generation == cacheGeneration &&
+        entry.referenceIndex == referenceIndex)
+    {
+      kernelEval = entry.kernel;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+template<typename KernelType, typename TreeType>
+inline void FastMKSRules<KernelType, TreeType>::StoreKernel(
+    const size_t referenceIndex,
+    const double kernelEval)
+{
+  // Take the first free slot; if there is none, overwrite the first slot.
+  const size_t slot = CacheSlot(referenceIndex);
+  size_t i = 0;
+  while (i < cacheProbes &&
+         kernelCache[(slot + i) & (cacheSize - 1)].generation ==
+         cacheGeneration)
+    ++i;
+  if (i == cacheProbes)
+    i = 0;
+
+  CacheEntry& entry = kernelCache[(slot + i) & (cacheSize - 1)];
+  entry.referenceIndex = referenceIndex;
+  entry.generation = cacheGeneration;
+  entry.kernel = kernelEval;
+}
+
 } // namespace fastmks
 } // namespace mlpack
 
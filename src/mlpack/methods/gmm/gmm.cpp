@@ -13,6 +13,10 @@
  */
 #include "gmm.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace gmm {
 
@@ -76,6 +80,25 @@ double GMM::Probability(const arma::vec& observation,
   return weights[component] * dists[component].Probability(observation);
 }
 
+/**
+ * Compute the probability of each of the given observations.
+ */
+void GMM::Probability(const arma::mat& observations,
+                      arma::vec& probabilities) const
+{
+  LogProbability(observations, probabilities);
+  probabilities = arma::exp(probabilities);
+}
+
+/**
+ * Compute the log probability of each of the given observations.
+ */
+void GMM::LogProbability(const arma::mat& observations,
+                         arma::vec& logProbabilities) const
+{
+  LogProbability(observations, dists, weights, logProbabilities);
+}
+
 /**
  * Return a randomly generated observation according to the probability
  * distribution defined by this object.
@@ -108,23 +131,38 @@ arma::vec GMM::Random() const
 void GMM::Classify(const arma::mat& observations,
                    arma::Row<size_t>& labels) const
 {
-  // This is not the best way to do this!
-
   // We should not have to fill this with values, because each one should be
   // overwritten.
   labels.set_size(observations.n_cols);
-  for (size_t i = 0; i < observations.n_cols; ++i)
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables.
+  #pragma omp parallel for schedule(dynamic)
+  for (intmax_t b = 0; b < (intmax_t) numBlocks; ++b)
   {
-    // Find maximum probability component.
-    double probability = 0;
-    for (size_t j = 0; j < gaussians; ++j)
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize,
+        (size_t) observations.n_cols);
+    const arma::mat block(const_cast<double*>(observations.colptr(begin)),
+        observations.n_rows, end - begin, false, true);
+
+    arma::mat componentLogProbabilities;
+    ComponentLogProbabilities(block, dists, weights,
+        componentLogProbabilities);
+
+    // Find the maximum probability component; ties go to the last component.
+    for (size_t i = 0; i < block.n_cols; ++i)
     {
-      double newProb = Probability(observations.unsafe_col(i), j);
-      if (newProb >= probability)
+      size_t label = 0;
+      for (size_t j = 1; j < gaussians; ++j)
       {
-        probability = newProb;
-        labels[i] = j;
+        if (componentLogProbabilities(j, i) >=
+            componentLogProbabilities(label, i))
+          label = j;
       }
+
+      labels[begin + i] = label;
     }
   }
 }
@@ -137,20 +175,75 @@ double GMM::LogLikelihood(
     const std::vector<distribution::GaussianDistribution>& distsL,
     const arma::vec& weightsL) const
 {
-  double loglikelihood = 0;
-  arma::vec phis;
-  arma::mat likelihoods(gaussians, data.n_cols);
+  arma::vec logProbabilities;
+  LogProbability(data, distsL, weightsL, logProbabilities);
 
-  for (size_t i = 0; i < gaussians; i++)
+  // Now sum over every point.
+  return arma::accu(logProbabilities);
+}
+
+/**
+ * Compute the log probability of each of the given observations under the
+ * given mixture.
+ */
+void GMM::LogProbability(
+    const arma::mat& observations,
+    const std::vector<distribution::GaussianDistribution>& distsL,
+    const arma::vec& weightsL,
+    arma::vec& logProbabilities) const
+{
+  logProbabilities.set_size(observations.n_cols);
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables.
+  #pragma omp parallel for schedule(dynamic)
+  for (intmax_t b = 0; b < (intmax_t) numBlocks; ++b)
   {
-    distsL[i].Probability(data, phis);
-    likelihoods.row(i) = weightsL(i) * trans(phis);
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize,
+        (size_t) observations.n_cols);
+    const arma::mat block(const_cast<double*>(observations.colptr(begin)),
+        observations.n_rows, end - begin, false, true);
+
+    arma::mat componentLogProbabilities;
+    ComponentLogProbabilities(block, distsL, weightsL,
+        componentLogProbabilities);
+
+    // Sum the weighted densities of the components with the log-sum-exp
+    // trick: shift each column by its maximum before exponentiating, so that
+    // the largest term is exp(0) = 1.  If every term is -inf (or the maximum is
+    // otherwise not finite), the column is not shifted.
+    arma::rowvec shifts = arma::max(componentLogProbabilities, 0);
+    for (size_t i = 0; i < shifts.n_elem; ++i)
+      if (!std::isfinite(shifts[i]))
+        shifts[i] = 0.0;
+
+    componentLogProbabilities.each_row() -= shifts;
+    logProbabilities.subvec(begin, end - 1) = arma::trans(shifts +
+        arma::log(arma::sum(arma::exp(componentLogProbabilities), 0)));
   }
+}
 
-  // Now sum over every point.
-  for (size_t j = 0; j < data.n_cols; j++)
-    loglikelihood += log(accu(likelihoods.col(j)));
-  return loglikelihood;
+/**
+ * Compute the weighted log density of every component for every observation in
+ * the given block.
+ */
+void GMM::ComponentLogProbabilities(
+    const arma::mat& block,
+    const std::vector<distribution::GaussianDistribution>& distsL,
+    const arma::vec& weightsL,
+    arma::mat& componentLogProbabilities)
+{
+  componentLogProbabilities.set_size(distsL.size(), block.n_cols);
+
+  arma::vec logProbabilities;
+  for (size_t k = 0; k < distsL.size(); ++k)
+  {
+    distsL[k].LogProbability(block, logProbabilities);
+    componentLogProbabilities.row(k) = std::log(weightsL[k]) +
+        arma::trans(logProbabilities);
+  }
 }
 
 } // namespace gmm
@@ -18,6 +18,8 @@
 
 // This is the default fitting method class.
 #include "em_fit.hpp"
+// This is the default fitting method class for block readers.
+#include "online_em_fit.hpp"
 
 namespace mlpack {
 namespace gmm /** Gaussian Mixture Models. */ {
@@ -52,7 +54,9 @@ namespace gmm /** Gaussian Mixture Models. */ {
  *
  * For a sample implementation, see the EMFit class; this class uses the EM
  * algorithm to train a GMM, and is the default fitting type for the Train()
- * method.
+ * method.  Data too large for memory can be given to Train() as a block reader
+ * (see block_reader.hpp); then the OnlineEMFit class, which fits the GMM on one
+ * mini-batch at a time, is the default fitting type.
  *
  * The GMM, once trained, can be used to generate random points from the
  * distribution and estimate the probability of points being from the
@@ -175,6 +179,31 @@ class GMM
   double Probability(const arma::vec& observation,
                      const size_t component) const;
 
+  /**
+   * Compute the probability of each of the given observations under this
+   * distribution.  This is much faster than calling Probability() on each
+   * observation; see LogProbability().
+   *
+   * @param observations List of observations.
+   * @param probabilities Output probability of each observation.
+   */
+  void Probability(const arma::mat& observations,
+                   arma::vec& probabilities) const;
+
+  /**
+   * Compute the log probability of each of the given observations under this
+   * distribution.  The observations are handled in blocks, in parallel if
+   * OpenMP is available; for each block, the log densities of all components
+   * are computed with one triangular solve per component, and they are
+   * combined with the log-sum-exp trick, so the result is accurate even when
+   * every component density underflows.
+   *
+   * @param observations List of observations.
+   * @param logProbabilities Output log probability of each observation.
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::vec& logProbabilities) const;
+
   /**
    * Return a randomly generated observation according to the probability
    * distribution defined by this object.
@@ -242,6 +271,43 @@ class GMM
                const bool useExistingModel = false,
                FittingType fitter = FittingType());
 
+  /**
+   * Estimate the probability distribution from the observations given by a
+   * block reader (see block_reader.hpp), using the given algorithm in the
+   * FittingType class to fit the data.  The FittingType class must provide the
+   * method
+   *
+   * @code
+   * template<typename BlockReaderType>
+   * void Estimate(BlockReaderType& reader,
+   *               std::vector<distribution::GaussianDistribution>& dists,
+   *               arma::vec& weights,
+   *               const bool useExistingModel);
+   * @endcode
+   *
+   * and the default, OnlineEMFit<>, holds only one block of observations in
+   * memory at a time, so this can fit datasets that are larger than memory.
+   * After fitting, the log-likelihood of the observations is computed with one
+   * more pass over the reader.
+   *
+   * Optionally, the existing model can be used as an initial model for the
+   * estimation by setting 'useExistingModel' to true; with OnlineEMFit, this
+   * updates the model with the new observations.
+   *
+   * @tparam BlockReaderType Type of the block reader.
+   * @tparam FittingType The type of fitting method which should be used.
+   * @param reader Block reader giving the observations.
+   * @param useExistingModel If true, the existing model is used as an initial
+   *     model for the estimation.
+   * @return The log-likelihood of the fit.
+   */
+  template<typename BlockReaderType, typename FittingType = OnlineEMFit<>>
+  double Train(BlockReaderType& reader,
+               const bool useExistingModel = false,
+               FittingType fitter = FittingType(),
+               const typename std::enable_if<
+                   !arma::is_arma_type<BlockReaderType>::value>::type* = 0);
+
   /**
    * Classify the given observations as being from an individual component in
    * this GMM.  The resultant classifications are stored in the 'labels' object,
@@ -255,6 +321,10 @@ class GMM
    * double priorWeight = gmm.Weights()[2];
    * @endcode
    *
+   * The component with the greatest weighted log density is chosen for each
+   * observation; the densities are computed in blocks of observations, in
+   * parallel if OpenMP is available.
+   *
    * @param observations List of observations to classify.
    * @param labels Object which will be filled with labels.
    */
@@ -281,6 +351,40 @@ class GMM
       const arma::mat& dataPoints,
       const std::vector<distribution::GaussianDistribution>& distsL,
       const arma::vec& weights) const;
+
+  /**
+   * Compute the log probability of each of the given observations under the
+   * given mixture; see the public LogProbability().
+   *
+   * @param observations List of observations.
+   * @param distsL Components of the mixture.
+   * @param weightsL Weights of the mixture.
+   * @param logProbabilities Output log probability of each observation.
+   */
+  void LogProbability(
+      const arma::mat& observations,
+      const std::vector<distribution::GaussianDistribution>& distsL,
+      const arma::vec& weightsL,
+      arma::vec& logProbabilities) const;
+
+  /**
+   * Compute the weighted log density log(w_k) + log p_k(x_i) of every
+   * component k (row k) for every observation x_i (column i) of the given
+   * block.
+   *
+   * @param block Block of observations.
+   * @param distsL Components of the mixture.
+   * @param weightsL Weights of the mixture.
+   * @param componentLogProbabilities Output weighted log densities.
+   */
+  static void ComponentLogProbabilities(
+      const arma::mat& block,
+      const std::vector<distribution::GaussianDistribution>& distsL,
+      const arma::vec& weightsL,
+      arma::mat& componentLogProbabilities);
+
+  //! The number of observations in each block that is evaluated by a thread.
+  static const size_t blockSize = 1024;
 };
 
 } // namespace gmm
@@ -185,6 +185,35 @@ double GMM::Train(const arma::mat& observations,
   return bestLikelihood;
 }
 
+/**
+ * Fit the GMM to the observations given by a block reader.
+ */
+template<typename BlockReaderType, typename FittingType>
+double GMM::Train(BlockReaderType& reader,
+                  const bool useExistingModel,
+                  FittingType fitter,
+                  const typename std::enable_if<
+                      !arma::is_arma_type<BlockReaderType>::value>::type*)
+{
+  fitter.Estimate(reader, dists, weights, useExistingModel);
+
+  // Calculate the log-likelihood of the trained model, one block at a time.
+  double logLikelihood = 0.0;
+  arma::mat block;
+  arma::vec logProbabilities;
+  reader.Reset();
+  while (reader.NextBlock(block))
+  {
+    LogProbability(block, dists, weights, logProbabilities);
+    logLikelihood += arma::accu(logProbabilities);
+  }
+  reader.Reset();
+
+  Log::Info << "GMM::Train(): log-likelihood of trained GMM is "
+      << logLikelihood << "." << std::endl;
+  return logLikelihood;
+}
+
 /**
  * Serialize the object.
  */
@@ -0,0 +1,218 @@
+/**
+ * @file online_em_fit.hpp
+ *
+ * Utility class to fit a GMM with online (stochastic) EM on mini-batches, so
+ * that the data never has to be held in memory at once.  Used by GMM::Train().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_ONLINE_EM_FIT_HPP
+#define MLPACK_METHODS_GMM_ONLINE_EM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/block_reader.hpp>
+#include <mlpack/core/dists/gaussian_distribution.hpp>
+
+// The initial clustering is done by batch EM on the first mini-batch.
+#include "em_fit.hpp"
+// Default step size schedule.
+#include "polynomial_step_size.hpp"
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * This class fits a GMM with the online EM algorithm of Cappé and Moulines:
+ *
+ * @code
+ * @article{cappe2009online,
+ *   title={On-line expectation-maximization algorithm for latent data models},
+ *   author={Capp{\'e}, O. and Moulines, E.},
+ *   journal={Journal of the Royal Statistical Society: Series B (Statistical
+ *       Methodology)},
+ *   volume={71},
+ *   number={3},
+ *   pages={593--613},
+ *   year={2009}
+ * }
+ * @endcode
+ *
+ * The model is summarized by its sufficient statistics: for each component k,
+ * the expected fraction of points s0_k, the expected sum s1_k of those points,
+ * and the expected sum of their outer products s2_k, all normalized by the
+ * number of points.  The data are read in mini-batches (the blocks of a block
+ * reader, such as data::BinaryBlockReader or data::CSVBlockReader; see
+ * block_reader.hpp).  For each mini-batch, the responsibilities of the
+ * components are computed with the current model (E step), the statistics are
+ * moved towards those of the mini-batch by the current step size eta_t,
+ *
+ *   s <- (1 - eta_t) s + eta_t s(mini-batch),
+ *
+ * and the model is recomputed from the statistics (M step): w_k is
+ * proportional to s0_k, mu_k = s1_k / s0_k and Sigma_k = s2_k / s0_k -
+ * mu_k mu_k^T.  Only one mini-batch and the statistics are ever in memory.
+ *
+ * The data are passed over until the average log-likelihood of the points
+ * (evaluated on each mini-batch just before it is used for an update) changes
+ * by less than the tolerance between two passes, or until the maximum number of
+ * passes is reached.  A single pass is enough for data that arrive once.
+ *
+ * If no initial model is given, the InitialClusteringType clusterer is run on
+ * the first mini-batch, in the same way as EMFit, so the first mini-batch must
+ * have at least as many points as there are components.  To update an existing
+ * model with new data, pass useInitialModel = true; the statistics then start
+ * from the model, and the step size schedule controls how much the new data
+ * can move it.
+ *
+ * @tparam InitialClusteringType Clusterer for the initial model; see EMFit.
+ * @tparam CovarianceConstraintPolicy Constraint applied to every covariance.
+ * @tparam StepSizeType Step size schedule; it must provide a method
+ *     'double StepSize(const size_t t) const' (see PolynomialStepSize).
+ */
+template<typename InitialClusteringType = kmeans::KMeans<>,
+         typename CovarianceConstraintPolicy = PositiveDefiniteConstraint,
+         typename StepSizeType = PolynomialStepSize>
+class OnlineEMFit
+{
+ public:
+  /**
+   * Construct the OnlineEMFit object.  Setting the maximum number of passes to
+   * 0 means that the data will be passed over until convergence (with the
+   * given tolerance).
+   *
+   * @param maxPasses Maximum number of passes over the data.
+   * @param tolerance Tolerance on the change in average log-likelihood per
+   *     point between two passes.
+   * @param batchSize Number of points in each mini-batch, when the data are
+   *     given as a matrix.  Block readers use their own block size.
+   * @param stepSize Step size schedule.
+   * @param clusterer Object which will perform the initial clustering.
+   * @param constraint Object which applies constraints to the covariances.
+   */
+  OnlineEMFit(const size_t maxPasses = 10,
+              const double tolerance = 1e-5,
+              const size_t batchSize = 1000,
+              StepSizeType stepSize = StepSizeType(),
+              InitialClusteringType clusterer = InitialClusteringType(),
+              CovarianceConstraintPolicy constraint =
+                  CovarianceConstraintPolicy());
+
+  /**
+   * Fit the mini-batches given by the block reader to a Gaussian mixture model.
+   * The size of the vectors (indicating the number of components) must already
+   * be set.  Optionally, if useInitialModel is set to true, then the given
+   * model is used as the initial model, instead of using the
+   * InitialClusteringType::Cluster() option on the first mini-batch.  The
+   * reader is rewound before and after fitting.
+   *
+   * @param reader Block reader giving the observations.
+   * @param dists Vector of distributions to train.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used for the initial
+   *      clustering.
+   */
+  template<typename BlockReaderType>
+  void Estimate(BlockReaderType& reader,
+                std::vector<distribution::GaussianDistribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false,
+                const typename std::enable_if<
+                    !arma::is_arma_type<BlockReaderType>::value>::type* = 0);
+
+  /**
+   * Fit the observations to a Gaussian mixture model, using mini-batches of
+   * BatchSize() consecutive points.  This allows OnlineEMFit to be used with
+   * GMM::Train() on a matrix.
+   *
+   * @param observations List of observations to train on.
+   * @param dists Vector of distributions to train.
+   * @param weights Vector to store a priori weights in.
+   * @param useInitialModel If true, the given model is used for the initial
+   *      clustering.
+   */
+  void Estimate(const arma::mat& observations,
+                std::vector<distribution::GaussianDistribution>& dists,
+                arma::vec& weights,
+                const bool useInitialModel = false);
+
+  //! Get the step size schedule.
+  const StepSizeType& StepSize() const { return stepSize; }
+  //! Modify the step size schedule.
+  StepSizeType& StepSize() { return stepSize; }
+
+  //! Get the clusterer.
+  const InitialClusteringType& Clusterer() const { return clusterer; }
+  //! Modify the clusterer.
+  InitialClusteringType& Clusterer() { return clusterer; }
+
+  //! Get the covariance constraint policy class.
+  const CovarianceConstraintPolicy& Constraint() const { return constraint; }
+  //! Modify the covariance constraint policy class.
+  CovarianceConstraintPolicy& Constraint() { return constraint; }
+
+  //! Get the maximum number of passes over the data.
+  size_t MaxPasses() const { return maxPasses; }
+  //! Modify the maximum number of passes over the data.
+  size_t& MaxPasses() { return maxPasses; }
+
+  //! Get the tolerance for convergence.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance for convergence.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of points in each mini-batch taken from a matrix.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each mini-batch taken from a matrix.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Serialize the fitter.
+  template<typename Archive>
+  void Serialize(Archive& ar, const unsigned int version);
+
+ private:
+  /**
+   * Perform one online EM update with the given mini-batch and step size.
+   * Returns the log-likelihood of the mini-batch under the model before the
+   * update.
+   *
+   * @param batch Mini-batch of observations.
+   * @param eta Step size of the update.
+   * @param dists Vector of distributions to update.
+   * @param weights Vector of a priori weights to update.
+   * @param s0 Expected fraction of points from each component.
+   * @param s1 Expected (normalized) sum of the points from each component.
+   * @param s2 Expected (normalized) sum of the outer products of the points
+   *     from each component.
+   */
+  double Update(const arma::mat& batch,
+                const double eta,
+                std::vector<distribution::GaussianDistribution>& dists,
+                arma::vec& weights,
+                arma::vec& s0,
+                arma::mat& s1,
+                arma::cube& s2);
+
+  //! Maximum number of passes over the data.
+  size_t maxPasses;
+  //! Tolerance for convergence.
+  double tolerance;
+  //! Number of points in each mini-batch taken from a matrix.
+  size_t batchSize;
+  //! The step size schedule.
+  StepSizeType stepSize;
+  //! Object which will perform the clustering.
+  InitialClusteringType clusterer;
+  //! Object which applies constraints to the covariance matrix.
+  CovarianceConstraintPolicy constraint;
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+// Include implementation.
+#include "online_em_fit_impl.hpp"
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * @file online_em_fit_impl.hpp
+ *
+ * Implementation of online EM for fitting GMMs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_ONLINE_EM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_ONLINE_EM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "online_em_fit.hpp"
+
+namespace mlpack {
+namespace gmm {
+
+//! Constructor.
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename StepSizeType>
+OnlineEMFit<InitialClusteringType, CovarianceConstraintPolicy, StepSizeType>::
+OnlineEMFit(const size_t maxPasses,
+            const double tolerance,
+            const size_t batchSize,
+            StepSizeType stepSize,
+            InitialClusteringType clusterer,
+            CovarianceConstraintPolicy constraint) :
+    maxPasses(maxPasses),
+    tolerance(tolerance),
+    batchSize(batchSize),
+    stepSize(stepSize),
+    clusterer(clusterer),
+    constraint(constraint)
+{ /* Nothing to do. */ }
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename StepSizeType>
+template<typename BlockReaderType>
+void OnlineEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    StepSizeType>::Estimate(
+    BlockReaderType& reader,
+    std::vector<distribution::GaussianDistribution>& dists,
+    arma::vec& weights,
+    const bool useInitialModel,
+    const typename std::enable_if<
+        !arma::is_arma_type<BlockReaderType>::value>::type*)
+{
+  if (reader.Cols() == 0)
+    throw std::invalid_argument("OnlineEMFit::Estimate(): no observations "
+        "given");
+
+  arma::mat batch;
+  reader.Reset();
+
+  // Only perform initial clustering if the user wanted it.  EMFit with a
+  // maximum of one iteration performs only its initial clustering.
+  if (!useInitialModel)
+  {
+    reader.NextBlock(batch);
+    EMFit<InitialClusteringType, CovarianceConstraintPolicy> initialFit(1,
+        tolerance, clusterer, constraint);
+    initialFit.Estimate(batch, dists, weights);
+  }
+
+  // The statistics start from the initial model.
+  const size_t dimensionality = reader.Rows();
+  arma::vec s0(weights);
+  arma::mat s1(dimensionality, dists.size());
+  arma::cube s2(dimensionality, dimensionality, dists.size());
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    s1.col(i) = weights[i] * dists[i].Mean();
+    s2.slice(i) = weights[i] * (dists[i].Covariance() +
+        dists[i].Mean() * arma::trans(dists[i].Mean()));
+  }
+
+  double lOld = -DBL_MAX;
+  size_t t = 0;
+  for (size_t pass = 1; maxPasses == 0 || pass <= maxPasses; ++pass)
+  {
+    reader.Reset();
+    double l = 0.0;
+    while (reader.NextBlock(batch))
+    {
+      l += Update(batch, stepSize.StepSize(t), dists, weights, s0, s1, s2);
+      ++t;
+    }
+    l /= reader.Cols();
+
+    Log::Info << "OnlineEMFit::Estimate(): pass " << pass << ", average "
+        << "log-likelihood " << l << "." << std::endl;
+
+    if (std::abs(l - lOld) <= tolerance)
+      break;
+    lOld = l;
+  }
+
+  reader.Reset();
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename StepSizeType>
+void OnlineEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    StepSizeType>::Estimate(
+    const arma::mat& observations,
+    std::vector<distribution::GaussianDistribution>& dists,
+    arma::vec& weights,
+    const bool useInitialModel)
+{
+  data::MatrixBlockReader reader(observations, batchSize);
+  Estimate(reader, dists, weights, useInitialModel);
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename StepSizeType>
+double OnlineEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    StepSizeType>::Update(
+    const arma::mat& batch,
+    const double eta,
+    std::vector<distribution::GaussianDistribution>& dists,
+    arma::vec& weights,
+    arma::vec& s0,
+    arma::mat& s1,
+    arma::cube& s2)
+{
+  // Calculate the log of the weighted density of each Gaussian for each point
+  // of the mini-batch.
+  arma::mat condProb(dists.size(), batch.n_cols);
+  arma::vec logProbabilities;
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    dists[i].LogProbability(batch, logProbabilities);
+    condProb.row(i) = std::log(weights[i]) + arma::trans(logProbabilities);
+  }
+
+  // Normalize column-wise with the log-sum-exp trick, so that points far from
+  // every Gaussian still get responsibilities.
+  arma::rowvec shifts = arma::max(condProb, 0);
+  for (size_t j = 0; j < shifts.n_elem; ++j)
+    if (!std::isfinite(shifts[j]))
+      shifts[j] = 0.0;
+
+  condProb.each_row() -= shifts;
+  condProb = arma::exp(condProb);
+  const arma::rowvec probSums = arma::sum(condProb, 0);
+  const double logLikelihood = arma::accu(shifts + arma::log(probSums));
+
+  for (size_t j = 0; j < condProb.n_cols; ++j)
+  {
+    // Avoid dividing by zero; if the probability for everything is 0, we
+    // don't want to make it NaN.
+    if (probSums[j] != 0.0)
+      condProb.col(j) /= probSums[j];
+  }
+
+  // Move the statistics towards those of the mini-batch, then recompute the
+  // model from them.
+  const double scale = eta / batch.n_cols;
+  s0 = (1.0 - eta) * s0 + scale * arma::sum(condProb, 1);
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    s1.col(i) = (1.0 - eta) * s1.col(i) +
+        scale * (batch * arma::trans(condProb.row(i)));
+
+    arma::mat weighted = batch;
+    weighted.each_row() %= condProb.row(i);
+    s2.slice(i) = (1.0 - eta) * s2.slice(i) +
+        scale * (weighted * arma::trans(batch));
+
+    // Don't update if there's no probability of the Gaussian having points.
+    if (s0[i] == 0.0)
+      continue;
+
+    dists[i].Mean() = s1.col(i) / s0[i];
+    arma::mat covariance = s2.slice(i) / s0[i] -
+        dists[i].Mean() * arma::trans(dists[i].Mean());
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+    dists[i].Covariance(std::move(covariance));
+  }
+
+  weights = s0 / arma::accu(s0);
+
+  return logLikelihood;
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename StepSizeType>
+template<typename Archive>
+void OnlineEMFit<InitialClusteringType, CovarianceConstraintPolicy,
+    StepSizeType>::Serialize(Archive& ar, const unsigned int /* version */)
+{
+  using data::CreateNVP;
+
+  ar & CreateNVP(maxPasses, "maxPasses");
+  ar & CreateNVP(tolerance, "tolerance");
+  ar & CreateNVP(batchSize, "batchSize");
+  ar & CreateNVP(stepSize, "stepSize");
+  ar & CreateNVP(clusterer, "clusterer");
+  ar & CreateNVP(constraint, "constraint");
+}
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
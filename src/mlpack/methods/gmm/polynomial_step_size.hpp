@@ -0,0 +1,79 @@
+/**
+ * @file polynomial_step_size.hpp
+ *
+ * A polynomially decaying step size schedule for stochastic approximation, used
+ * by OnlineEMFit.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_POLYNOMIAL_STEP_SIZE_HPP
+#define MLPACK_METHODS_GMM_POLYNOMIAL_STEP_SIZE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * The step size schedule eta_t = (t + offset)^(-exponent), for steps
+ * t = 0, 1, 2, ....  Stochastic approximation converges for exponents in
+ * (0.5, 1]; an exponent of 1 with an offset of 1 gives eta_t = 1 / (t + 1),
+ * which weights every mini-batch equally, while smaller exponents forget old
+ * mini-batches faster.  An exponent of 0 gives a constant step size of 1.  The
+ * offset should be at least 1, so that no step is larger than 1.
+ *
+ * Any class that provides the same StepSize() method can be used as a step
+ * size schedule for OnlineEMFit.
+ */
+class PolynomialStepSize
+{
+ public:
+  /**
+   * Create the schedule with the given parameters.
+   *
+   * @param exponent Exponent of the decay.
+   * @param offset Offset added to the step index.
+   */
+  PolynomialStepSize(const double exponent = 0.6, const double offset = 2.0) :
+      exponent(exponent),
+      offset(offset)
+  { /* Nothing to do. */ }
+
+  //! Get the step size for step t (starting at 0).
+  double StepSize(const size_t t) const
+  {
+    return std::pow(t + offset, -exponent);
+  }
+
+  //! Get the exponent of the decay.
+  double Exponent() const { return exponent; }
+  //! Modify the exponent of the decay.
+  double& Exponent() { return exponent; }
+
+  //! Get the offset added to the step index.
+  double Offset() const { return offset; }
+  //! Modify the offset added to the step index.
+  double& Offset() { return offset; }
+
+  //! Serialize the schedule.
+  template<typename Archive>
+  void Serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & data::CreateNVP(exponent, "exponent");
+    ar & data::CreateNVP(offset, "offset");
+  }
+
+ private:
+  //! The exponent of the decay.
+  double exponent;
+  //! The offset added to the step index.
+  double offset;
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,9 @@
 #include "sample_initialization.hpp"
 #include "max_variance_new_cluster.hpp"
 #include "naive_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
+
+#include <mlpack/core/data/block_reader.hpp>
 
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
@@ -62,8 +65,11 @@ namespace kmeans /** K-Means clustering. */ {
  *     const size_t iteration)'.
  * @tparam LloydStepType Implementation of single Lloyd step to use.
  *
+ * Data that does not fit in memory can be clustered with mini-batch k-means by
+ * giving Cluster() a block reader (see block_reader.hpp) instead of a matrix.
+ *
  * @see RandomPartition, SampleInitialization, RefinedStart, AllowEmptyClusters,
- *      MaxVarianceNewCluster, NaiveKMeans, ElkanKMeans
+ *      MaxVarianceNewCluster, NaiveKMeans, ElkanKMeans, MiniBatchKMeans
  */
 template<typename MetricType = metric::EuclideanDistance,
          typename InitialPartitionPolicy = SampleInitialization,
@@ -155,6 +161,38 @@ class KMeans
                const bool initialAssignmentGuess = false,
                const bool initialCentroidGuess = false);
 
+  /**
+   * Perform k-means clustering on the points given by a block reader (see
+   * block_reader.hpp), returning the centroids of each cluster in the centroids
+   * matrix.  Only one block is held in memory at a time, so the dataset may be
+   * larger than memory.  This always uses mini-batch k-means (see
+   * MiniBatchKMeans), whatever the LloydStepType: each block is one mini-batch,
+   * and counts as one iteration towards the maximum number of iterations.  The
+   * reader is rewound as many times as necessary, until the drift of the
+   * centroids converges or the maximum number of iterations is reached.
+   * Centroids that no point is ever assigned to are not moved, and the
+   * EmptyClusterPolicy is not used.
+   *
+   * Unless initialGuess is true, the initial centroids are found by the
+   * InitialPartitionPolicy on the first block.
+   *
+   * @tparam BlockReaderType Type of the block reader.
+   * @param reader Block reader giving the points to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which centroids are stored.
+   * @param initialGuess If true, then it is assumed that centroids contains the
+   *      initial cluster centroids.
+   */
+  template<typename BlockReaderType>
+  void Cluster(BlockReaderType& reader,
+               const size_t clusters,
+               arma::mat& centroids,
+               const bool initialGuess = false,
+               const typename std::enable_if<
+                   !arma::is_arma_type<BlockReaderType>::value &&
+                   !arma::is_arma_sparse_type<BlockReaderType>::value
+               >::type* = 0);
+
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Set the maximum number of iterations.
@@ -336,6 +336,109 @@ Cluster(const MatType& data,
   }
 }
 
+/**
+ * Perform mini-batch k-means clustering on the points given by a block reader,
+ * returning the centroids of each cluster.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+template<typename BlockReaderType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(BlockReaderType& reader,
+        const size_t clusters,
+        arma::mat& centroids,
+        const bool initialGuess,
+        const typename std::enable_if<
+            !arma::is_arma_type<BlockReaderType>::value &&
+            !arma::is_arma_sparse_type<BlockReaderType>::value>::type*)
+{
+  if (reader.Cols() == 0)
+    Log::Fatal << "KMeans::Cluster(): no points given." << std::endl;
+
+  arma::mat block;
+  reader.Reset();
+
+  if (initialGuess)
+  {
+    if (centroids.n_cols != clusters)
+      Log::Fatal << "KMeans::Cluster(): wrong number of initial cluster "
+        << "centroids (" << centroids.n_cols << ", should be " << clusters
+        << ")!" << std::endl;
+
+    if (centroids.n_rows != reader.Rows())
+      Log::Fatal << "KMeans::Cluster(): initial cluster centroids have wrong "
+        << " dimensionality (" << centroids.n_rows << ", should be "
+        << reader.Rows() << ")!" << std::endl;
+  }
+  else
+  {
+    // Use the partitioner on the first block to find the initial centroids.
+    reader.NextBlock(block);
+    arma::Row<size_t> assignments;
+    bool gotAssignments = GetInitialAssignmentsOrCentroids(partitioner, block,
+        clusters, assignments, centroids);
+    if (gotAssignments)
+    {
+      // The partitioner gives assignments, so we need to calculate centroids
+      // from those assignments.
+      arma::Row<size_t> counts;
+      counts.zeros(clusters);
+      centroids.zeros(block.n_rows, clusters);
+      for (size_t i = 0; i < block.n_cols; ++i)
+      {
+        centroids.col(assignments[i]) += block.col(i);
+        counts[assignments[i]]++;
+      }
+
+      for (size_t i = 0; i < clusters; ++i)
+        if (counts[i] != 0)
+          centroids.col(i) /= counts[i];
+    }
+  }
+
+  // The blocks are given to the step directly, so it never uses its dataset.
+  // A maximum of 0 iterations means there is no limit.
+  MiniBatchKMeans<MetricType, arma::mat> miniBatchStep(block, metric);
+  size_t iteration = 0;
+  while (!miniBatchStep.Converged() &&
+         (maxIterations == 0 || iteration != maxIterations))
+  {
+    reader.Reset();
+    while (!miniBatchStep.Converged() &&
+           (maxIterations == 0 || iteration != maxIterations) &&
+           reader.NextBlock(block))
+    {
+      miniBatchStep.Update(block, centroids);
+
+      iteration++;
+      Log::Info << "KMeans::Cluster(): iteration " << iteration << ", mean "
+          << "drift " << miniBatchStep.WindowDrift() << ".\n";
+    }
+  }
+  reader.Reset();
+
+  if (maxIterations == 0 || iteration != maxIterations)
+  {
+    Log::Info << "KMeans::Cluster(): converged after " << iteration
+        << " iterations." << std::endl;
+  }
+  else
+  {
+    Log::Info << "KMeans::Cluster(): terminated after limit of " << iteration
+        << " iterations." << std::endl;
+  }
+  Log::Info << miniBatchStep.DistanceCalculations() << " distance "
+      << "calculations." << std::endl;
+}
+
 template<typename MetricType,
          typename InitialPartitionPolicy,
          typename EmptyClusterPolicy,
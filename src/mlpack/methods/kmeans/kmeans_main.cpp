@@ -20,6 +20,7 @@
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
+#include "mini_batch_kmeans.hpp"
 
 using namespace mlpack;
 using namespace mlpack::kmeans;
@@ -46,8 +47,11 @@ PROGRAM_INFO("K-Means Clustering", "This program performs K-Means clustering "
     " approach can be used ('naive').  Other options include the Pelleg-Moore "
     "tree-based algorithm ('pelleg-moore'), Elkan's triangle-inequality based "
     "algorithm ('elkan'), Hamerly's modification to Elkan's algorithm "
-    "('hamerly'), the dual-tree k-means algorithm ('dualtree'), and the "
-    "dual-tree k-means algorithm using the cover tree ('dualtree-covertree')."
+    "('hamerly'), the dual-tree k-means algorithm ('dualtree'), the "
+    "dual-tree k-means algorithm using the cover tree ('dualtree-covertree'), "
+    "and Sculley's mini-batch k-means ('minibatch'), which updates the "
+    "centroids with a random sample of 1000 points in each iteration and stops "
+    "when the mean movement of the centroids over 10 iterations is below 1e-4."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the --allow_empty_clusters (-e) option.  When this option is specified "
@@ -98,8 +102,8 @@ PARAM_DOUBLE_IN("percentage", "Percentage of dataset to use for each refined "
     "start sampling (use when --refined_start is specified).", "p", 0.02);
 
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
-    "'dualtree-covertree').", "a", "naive");
+    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', "
+    "'dualtree-covertree', or 'minibatch').", "a", "naive");
 
 // Given the type of initial partition policy, figure out the empty cluster
 // policy and run k-means.
@@ -186,12 +190,15 @@ void FindLloydStepType(const InitialPartitionPolicy& ipp)
   else if (algorithm == "dualtree-covertree")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
         CoverTreeDualTreeKMeans>(ipp);
+  else if (algorithm == "minibatch")
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
+        MiniBatchKMeans>(ipp);
   else if (algorithm == "naive")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans>(ipp);
   else
     Log::Fatal << "Unknown algorithm: '" << algorithm << "'.  Supported options"
-        << " are 'naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', and "
-        << "'dualtree-covertree'." << endl;
+        << " are 'naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', "
+        << "'dualtree-covertree', and 'minibatch'." << endl;
 }
 
 // Given the template parameters, sanitize/load input and run k-means.
@@ -0,0 +1,172 @@
+/**
+ * @file mini_batch_kmeans.hpp
+ *
+ * A mini-batch step for k-means clustering, which updates the centroids with a
+ * small random sample of the points in each iteration instead of all of them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include <deque>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * An implementation of mini-batch k-means, as described in
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, D.},
+ *   booktitle={Proceedings of the 19th International Conference on World Wide
+ *       Web},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * Each call to Iterate() draws a mini-batch of BatchSize() points uniformly at
+ * random (with replacement) from the dataset, assigns each point of the
+ * mini-batch to its nearest centroid, and then moves each centroid towards the
+ * points assigned to it.  Every centroid has its own learning rate 1 / v, where
+ * v is the number of points that have ever been assigned to it, so each
+ * centroid is the running mean of all the points it has been given.  With
+ * these rates the updates of one mini-batch can be applied to each centroid at
+ * once, and the assignments are computed in parallel with OpenMP.
+ *
+ * The mini-batches are drawn from the object's own math::RandomStream, which
+ * is seeded with math::RandomStreamSeed() when the object is constructed.  So
+ * the mini-batches are reproducible after math::RandomSeed() is called with
+ * the same seed before construction, and sampling them does not draw from the
+ * global random number generator.
+ *
+ * Because each iteration only sees a sample, the centroids keep moving a
+ * little, and the movement of a single iteration is a noisy measure of
+ * convergence.  So Iterate() returns the mean movement (drift) of the
+ * centroids over the last Window() iterations, and it returns 0 (which stops
+ * KMeans) once that mean is below Tolerance().  The counts returned by
+ * Iterate() are the total number of points assigned to each centroid so far.
+ *
+ * Mini-batches may also be given directly to Update(); this is how
+ * KMeans::Cluster() clusters data given by a block reader, one block at a
+ * time, without the dataset ever being held in memory.
+ *
+ * When used with KMeans, AllowEmptyClusters avoids the passes over the whole
+ * dataset that MaxVarianceNewCluster makes for a centroid that has never been
+ * assigned a point.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset (only used by Iterate()).
+   * @param metric Instantiated metric.
+   * @param batchSize Number of points in each mini-batch sampled by Iterate().
+   * @param window Number of iterations the centroid drift is averaged over.
+   * @param tolerance Mean centroid drift below which the centroids are
+   *     considered converged.
+   */
+  MiniBatchKMeans(const MatType& dataset,
+                  MetricType& metric,
+                  const size_t batchSize = 1000,
+                  const size_t window = 10,
+                  const double tolerance = 1e-4);
+
+  /**
+   * Run a single iteration of mini-batch k-means, updating the given centroids
+   * into the newCentroids matrix.  Centroids that no point was ever assigned to
+   * are not moved.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Total number of points assigned to each cluster so far.
+   * @return Mean centroid drift over the window, or 0 if converged.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  /**
+   * Update the given centroids in place with the given mini-batch, and record
+   * the drift of the centroids.
+   *
+   * @param batch Mini-batch of points.
+   * @param centroids Centroids to update.
+   * @return Drift of the centroids caused by this mini-batch.
+   */
+  double Update(const arma::mat& batch, arma::mat& centroids);
+
+  //! Get the mean drift of the centroids over the window.
+  double WindowDrift() const;
+
+  //! Returns true once the window is full and its mean drift is below the
+  //! tolerance.
+  bool Converged() const;
+
+  //! Get the total number of points assigned to each cluster so far.
+  const arma::Col<size_t>& Counts() const { return totalCounts; }
+
+  //! Get the number of points in each sampled mini-batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each sampled mini-batch.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the number of iterations the drift is averaged over.
+  size_t Window() const { return window; }
+  //! Modify the number of iterations the drift is averaged over.
+  size_t& Window() { return window; }
+
+  //! Get the tolerance on the mean drift.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance on the mean drift.
+  double& Tolerance() { return tolerance; }
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of points in each sampled mini-batch.
+  size_t batchSize;
+  //! Number of iterations the drift is averaged over.
+  size_t window;
+  //! Tolerance on the mean drift.
+  double tolerance;
+
+  //! The random stream the mini-batches are sampled with.
+  math::RandomStream stream;
+
+  //! Total number of points assigned to each cluster.
+  arma::Col<size_t> totalCounts;
+  //! Drift of the centroids in the last iterations.
+  std::deque<double> drifts;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file mini_batch_kmeans_impl.hpp
+ *
+ * Implementation of the mini-batch step for k-means clustering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric,
+                                                      const size_t batchSize,
+                                                      const size_t window,
+                                                      const double tolerance) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(batchSize),
+    window(window),
+    tolerance(tolerance),
+    stream(math::RandomStreamSeed()),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // Sample the mini-batch; if it would be as large as the dataset, just use the
+  // whole dataset.
+  const size_t size = std::min(batchSize, (size_t) dataset.n_cols);
+  arma::mat batch(dataset.n_rows, size);
+  if (size == dataset.n_cols)
+  {
+    for (size_t i = 0; i < size; ++i)
+      batch.col(i) = arma::vec(dataset.col(i));
+  }
+  else
+  {
+    for (size_t i = 0; i < size; ++i)
+      batch.col(i) = arma::vec(dataset.col(stream.RandInt(dataset.n_cols)));
+  }
+
+  newCentroids = centroids;
+  Update(batch, newCentroids);
+  counts = totalCounts;
+
+  return Converged() ? 0.0 : WindowDrift();
+}
+
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Update(const arma::mat& batch,
+                                                    arma::mat& centroids)
+{
+  if (totalCounts.n_elem != centroids.n_cols)
+    totalCounts.zeros(centroids.n_cols);
+
+  // Find the closest centroid to each point of the mini-batch, with the
+  // centroids as they were before the mini-batch.  Visual Studio only
+  // implements OpenMP 2.0, which doesn't support unsigned loop variables.
+  arma::Col<size_t> assignments(batch.n_cols);
+  #pragma omp parallel for
+  for (intmax_t i = 0; i < (intmax_t) batch.n_cols; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(batch.col(i), centroids.col(j));
+
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    assignments[i] = closestCluster;
+  }
+  distanceCalculations += centroids.n_cols * batch.n_cols;
+
+  arma::mat sums(centroids.n_rows, centroids.n_cols, arma::fill::zeros);
+  arma::Col<size_t> batchCounts(centroids.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < batch.n_cols; ++i)
+  {
+    Log::Assert(assignments[i] != centroids.n_cols);
+    sums.col(assignments[i]) += batch.col(i);
+    batchCounts[assignments[i]]++;
+  }
+
+  // Taking each point in turn with learning rate 1 / v for its centroid keeps
+  // the centroid at the mean of all the points ever assigned to it, so all of
+  // the points of the mini-batch can be applied at once.
+  double cNorm = 0.0;
+  for (size_t j = 0; j < centroids.n_cols; ++j)
+  {
+    if (batchCounts[j] == 0)
+      continue;
+
+    totalCounts[j] += batchCounts[j];
+    const arma::vec oldCentroid = centroids.col(j);
+    centroids.col(j) += (sums.col(j) - batchCounts[j] * oldCentroid) /
+        totalCounts[j];
+
+    cNorm += std::pow(metric.Evaluate(oldCentroid, centroids.col(j)), 2.0);
+    ++distanceCalculations;
+  }
+
+  const double drift = std::sqrt(cNorm);
+  drifts.push_back(drift);
+  while (drifts.size() > std::max(window, (size_t) 1))
+    drifts.pop_front();
+
+  return drift;
+}
+
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::WindowDrift() const
+{
+  if (drifts.empty())
+    return std::numeric_limits<double>::infinity();
+
+  double drift = 0.0;
+  for (size_t i = 0; i < drifts.size(); ++i)
+    drift += drifts[i];
+
+  return drift / drifts.size();
+}
+
+template<typename MetricType, typename MatType>
+bool MiniBatchKMeans<MetricType, MatType>::Converged() const
+{
+  return (drifts.size() >= std::max(window, (size_t) 1)) &&
+      (WindowDrift() < tolerance);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/optimizers/lbfgs/lbfgs.hpp>
+#include <mlpack/core/optimizers/parallel_separable/parallel_separable_function.hpp>
 
 #include "logistic_regression_function.hpp"
 
@@ -148,6 +149,26 @@ class LogisticRegression
   void Train(OptimizerType<LogisticRegressionFunction<MatType>,
                            OptimizerTypeArgs...>& optimizer);
 
+  /**
+   * Train the LogisticRegression model with the given instantiated optimizer,
+   * whose error function is wrapped in a ParallelSeparableFunction, so that the
+   * objective and gradient are evaluated in parallel over blocks of the
+   * training points.  The initial point is handled as in the overload above.
+   *
+   * @param optimizer Instantiated optimizer with instantiated parallel error
+   *     function.
+   * @tparam OptimizerTypeArgs Optimizer arguments to customize the behavior of
+   *     the optimizer.
+   */
+  template<
+      template<typename,
+               typename...> class OptimizerType = mlpack::optimization::L_BFGS,
+      typename... OptimizerTypeArgs
+  >
+  void Train(OptimizerType<optimization::ParallelSeparableFunction<
+                               LogisticRegressionFunction<MatType>>,
+                           OptimizerTypeArgs...>& optimizer);
+
   //! Return the parameters (the b vector).
   const arma::vec& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
@@ -252,6 +273,13 @@ class LogisticRegression
   arma::vec parameters;
   //! L2-regularization penalty parameter.
   double lambda;
+
+  /**
+   * Train the model with the given instantiated optimizer, starting from the
+   * initial point of its function.
+   */
+  template<typename OptimizerType>
+  void TrainOptimizer(OptimizerType& optimizer);
 };
 
 } // namespace regression
@@ -170,6 +170,68 @@ void LogisticRegressionFunction<MatType>::Gradient(
       * (responses[i] - sigmoid) + regularization;
 }
 
+/**
+ * Evaluate the logistic regression objective function over a batch of points.
+ * This is the sum of Evaluate(parameters, i) over the batch.
+ */
+template<typename MatType>
+double LogisticRegressionFunction<MatType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize) const
+{
+  // The regularization term of each point is divided by the number of points.
+  const double regularization = lambda *
+      (batchSize / (2.0 * predictors.n_cols)) *
+      arma::dot(parameters.col(0).subvec(1, parameters.n_elem - 1),
+                parameters.col(0).subvec(1, parameters.n_elem - 1));
+
+  // Calculate the sigmoids of all points in the batch at once.
+  const size_t end = begin + batchSize - 1;
+  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+      parameters.col(0).subvec(1, parameters.n_elem - 1).t() *
+      predictors.cols(begin, end))));
+
+  double result = 0.0;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    if (responses[begin + i] == 1)
+      result += log(sigmoids[i]);
+    else
+      result += log(1.0 - sigmoids[i]);
+  }
+
+  return -result + regularization;
+}
+
+/**
+ * Evaluate the gradient of the logistic regression objective function over a
+ * batch of points.  This is the sum of Gradient(parameters, i, gradient) over
+ * the batch.
+ */
+template<typename MatType>
+void LogisticRegressionFunction<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize,
+    arma::mat& gradient) const
+{
+  // The regularization term of each point is divided by the number of points.
+  const double scale = lambda * batchSize / predictors.n_cols;
+
+  const size_t end = begin + batchSize - 1;
+  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-parameters(0, 0) -
+      parameters.col(0).subvec(1, parameters.n_elem - 1).t() *
+      predictors.cols(begin, end)));
+  const arma::rowvec errors = responses.subvec(begin, end) - sigmoids;
+
+  gradient.set_size(parameters.n_elem);
+  gradient[0] = -arma::accu(errors);
+  gradient.col(0).subvec(1, parameters.n_elem - 1) = -predictors.cols(begin,
+      end) * errors.t() + scale * parameters.col(0).subvec(1,
+      parameters.n_elem - 1);
+}
+
 } // namespace regression
 } // namespace mlpack
 
@@ -90,6 +90,24 @@ template<template<typename, typename... > class OptimizerType,
 void LogisticRegression<MatType>::Train(
     OptimizerType<LogisticRegressionFunction<MatType>,
                   OptimizerTypeArgs...>& optimizer)
+{
+  TrainOptimizer(optimizer);
+}
+
+template<typename MatType>
+template<template<typename, typename... > class OptimizerType,
+         typename... OptimizerTypeArgs>
+void LogisticRegression<MatType>::Train(
+    OptimizerType<optimization::ParallelSeparableFunction<
+                      LogisticRegressionFunction<MatType>>,
+                  OptimizerTypeArgs...>& optimizer)
+{
+  TrainOptimizer(optimizer);
+}
+
+template<typename MatType>
+template<typename OptimizerType>
+void LogisticRegression<MatType>::TrainOptimizer(OptimizerType& optimizer)
 {
   // Everything is good.  Just train the model.
   parameters = optimizer.Function().GetInitialPoint();
@@ -15,6 +15,7 @@
 
 #include <mlpack/core/optimizers/sgd/sgd.hpp>
 #include <mlpack/core/optimizers/minibatch_sgd/minibatch_sgd.hpp>
+#include <mlpack/core/optimizers/parallel_separable/parallel_separable_function.hpp>
 
 using namespace std;
 using namespace mlpack;
@@ -243,7 +244,12 @@ int main(int argc, char** argv)
     }
     else if (optimizerType == "lbfgs")
     {
-      L_BFGS<LogisticRegressionFunction<>> lbfgsOpt(lrf);
+      // The objective and gradient are evaluated in parallel over blocks of
+      // the training points.
+      typedef ParallelSeparableFunction<LogisticRegressionFunction<>>
+          ParallelFunctionType;
+      ParallelFunctionType plrf(lrf);
+      L_BFGS<ParallelFunctionType> lbfgsOpt(plrf);
       lbfgsOpt.MaxIterations() = maxIterations;
       lbfgsOpt.MinGradientNorm() = tolerance;
       Log::Info << "Training model with L-BFGS optimizer." << endl;
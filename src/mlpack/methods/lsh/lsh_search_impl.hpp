@@ -268,8 +268,10 @@ void LSHSearch<SortPolicy>::Train(const arma::mat& referenceSet,
     // For L2 metric, 2-stable distributions are used, and the normal Z ~ N(0,
     // 1) is a 2-stable distribution.
 
-    // Build numTables random tables arranged in a cube.
-    projections.randn(referenceSet.n_rows, numProj, numTables);
+    // Build numTables random tables arranged in a cube.  The cube can be large,
+    // so it is filled in parallel from a stream seeded by the global generator.
+    projections.set_size(referenceSet.n_rows, numProj, numTables);
+    math::RandomStream(math::RandomStreamSeed()).Randn(projections);
   }
   else if (projection.n_slices == numTables) // Take user-defined tables.
   {
@@ -27,6 +27,11 @@ namespace meanshift /** Mean shift clustering. */ {
  * apply mean shift algorithm until maximum iterations or convergence.  Then
  * remove duplicate centroids.
  *
+ * All the seeds are shifted together: each iteration runs a single dual-tree
+ * range search for the current centroids of the seeds that are still moving,
+ * the new centroids are computed in parallel with OpenMP, and seeds that have
+ * converged (or have no neighbors) are dropped from later iterations.
+ *
  * A simple example of how to run mean shift clustering is shown below.
  *
  * @code
@@ -150,6 +155,18 @@ class MeanShift
                     const std::vector<double>&, /*unused*/
                     arma::colvec& centroid);
 
+  /**
+   * Remove duplicate centroids: each converged centroid, in order, is kept
+   * only if no kept centroid is closer than the radius.  The distances to the
+   * kept centroids are found with nearest neighbor searches on a kd-tree, which
+   * is rebuilt only after several centroids have been kept since it was last
+   * built.
+   *
+   * @param converged Converged centroids, in order of their seeds.
+   * @param centroids Matrix to store the kept centroids in.
+   */
+  void RemoveDuplicates(const arma::mat& converged, arma::mat& centroids);
+
   /**
    * If distance of two centroids is less than radius, one will be removed.
    * Points with distance to current centroid less than radius will be used
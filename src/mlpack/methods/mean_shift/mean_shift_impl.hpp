@@ -23,6 +23,10 @@
 // In case it hasn't been included yet.
 #include "mean_shift.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace meanshift {
 
@@ -176,6 +180,57 @@ CalculateCentroid(const MatType& data,
   return true;
 }
 
+// Remove duplicate centroids.
+template<bool UseKernel, typename KernelType, typename MatType>
+void MeanShift<UseKernel, KernelType, MatType>::RemoveDuplicates(
+    const arma::mat& converged,
+    arma::mat& centroids)
+{
+  // Centroids kept since the last search are checked directly; once there are
+  // this many, the tree is rebuilt.
+  const size_t rebuildSize = 64;
+
+  std::vector<size_t> kept;
+  size_t numSearched = 0;
+  arma::vec nearest(converged.n_cols);
+  nearest.fill(DBL_MAX);
+  for (size_t i = 0; i < converged.n_cols; ++i)
+  {
+    if (kept.size() - numSearched == rebuildSize)
+    {
+      // Find the distance from every remaining centroid to the nearest kept
+      // one.
+      arma::mat keptCentroids(converged.n_rows, kept.size());
+      for (size_t k = 0; k < kept.size(); ++k)
+        keptCentroids.col(k) = converged.col(kept[k]);
+
+      neighbor::KNN neighborSearcher(keptCentroids);
+      arma::Mat<size_t> nearestNeighbors;
+      arma::mat nearestDistances;
+      neighborSearcher.Search(converged.cols(i, converged.n_cols - 1), 1,
+          nearestNeighbors, nearestDistances);
+      nearest.subvec(i, converged.n_cols - 1) = nearestDistances.row(0).t();
+      numSearched = kept.size();
+    }
+
+    // Determine if the centroid is a duplicate of one that was kept.
+    bool isDuplicated = (nearest[i] < radius);
+    for (size_t k = numSearched; k < kept.size() && !isDuplicated; ++k)
+    {
+      if (metric::EuclideanDistance::Evaluate(converged.unsafe_col(i),
+          converged.unsafe_col(kept[k])) < radius)
+        isDuplicated = true;
+    }
+
+    if (!isDuplicated)
+      kept.push_back(i);
+  }
+
+  centroids.set_size(converged.n_rows, kept.size());
+  for (size_t k = 0; k < kept.size(); ++k)
+    centroids.col(k) = converged.col(kept[k]);
+}
+
 /**
  * Perform Mean Shift clustering on the data set, returning a list of cluster
  * assignments and centroids.
@@ -202,7 +257,7 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   }
 
   // Holds all centroids before removing duplicate ones.
-  arma::mat allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  arma::mat allCentroids(*pSeeds);
 
   assignments.set_size(data.n_cols);
 
@@ -211,55 +266,82 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // The seeds that are still being shifted.
+  std::vector<size_t> active(pSeeds->n_cols);
+  for (size_t i = 0; i < active.size(); ++i)
+    active[i] = i;
+
+  // Whether each seed has converged; seeds that run out of neighbors or
+  // iterations are dropped.
+  std::vector<char> converged(pSeeds->n_cols, 0);
+  std::vector<char> done;
+
+  // Perform the mean shift algorithm on all the active seeds at once.
+  arma::mat queries;
+  for (size_t completedIterations = 0; completedIterations < maxIterations &&
+       !active.empty(); completedIterations++)
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations;
-         completedIterations++)
-    {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+    queries.set_size(pSeeds->n_rows, active.size());
+    for (size_t j = 0; j < active.size(); ++j)
+      queries.col(j) = allCentroids.col(active[j]);
+
+    rangeSearcher.Search(queries, validRadius, neighbors, distances);
+
+    done.assign(active.size(), 0);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() <= 1)
-        break;
+    // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+    // loop variables.
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (intmax_t j = 0; j < (intmax_t) active.size(); ++j)
+    {
+      const size_t i = active[j];
+      if (neighbors[j].size() <= 1)
+      {
+        done[j] = 1;
+        continue;
+      }
 
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
+      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      if (!CalculateCentroid(data, neighbors[j], distances[j], newCentroid))
         newCentroid = allCentroids.unsafe_col(i);
 
       // If the mean shift vector is small enough, it has converged.
       if (metric::EuclideanDistance::Evaluate(newCentroid,
           allCentroids.unsafe_col(i)) < 1e-3 * radius)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
-        {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
-        }
-
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
-
-        // Get out of the loop.
-        break;
+        converged[i] = 1;
+        done[j] = 1;
+      }
+      else
+      {
+        // Update the centroid.
+        allCentroids.col(i) = newCentroid;
       }
-
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
     }
+
+    // Drop the seeds that are done.
+    size_t numActive = 0;
+    for (size_t j = 0; j < active.size(); ++j)
+      if (!done[j])
+        active[numActive++] = active[j];
+    active.resize(numActive);
   }
 
+  // Remove duplicates among the converged centroids, in order of their seeds.
+  size_t numConverged = 0;
+  for (size_t i = 0; i < converged.size(); ++i)
+    if (converged[i])
+      ++numConverged;
+
+  arma::mat convergedCentroids(pSeeds->n_rows, numConverged);
+  numConverged = 0;
+  for (size_t i = 0; i < converged.size(); ++i)
+    if (converged[i])
+      convergedCentroids.col(numConverged++) = allCentroids.col(i);
+
+  RemoveDuplicates(convergedCentroids, centroids);
+
   // Assign centroids to each point.
   neighbor::KNN neighborSearcher(centroids);
   arma::mat neighborDistances;
@@ -76,6 +76,12 @@ PROGRAM_INFO("Neighborhood Components Analysis (NCA)",
     "documentation (in lbfgs.hpp) or the vast set of published literature on "
     "L-BFGS."
     "\n\n"
+    "Evaluating the NCA objective takes time quadratic in the number of points."
+    "  For larger datasets, --num_neighbors (-k) restricts the soft neighbor "
+    "assignments of each point to its k nearest neighbors in the current "
+    "stretched space.  The neighbors are found with a tree-based search and "
+    "recomputed every --neighbor_refresh (-r) passes over the data."
+    "\n\n"
     "By default, the SGD optimizer is used.");
 
 PARAM_MATRIX_IN_REQ("input", "Input dataset to run NCA on.", "i");
@@ -110,6 +116,11 @@ PARAM_DOUBLE_IN("min_step", "Minimum step of line search for L-BFGS.", "m",
 PARAM_DOUBLE_IN("max_step", "Maximum step of line search for L-BFGS.", "M",
     1e20);
 
+PARAM_INT_IN("num_neighbors", "If nonzero, only consider this many nearest "
+    "neighbors of each point when computing the objective.", "k", 0);
+PARAM_INT_IN("neighbor_refresh", "Number of passes over the data between "
+    "recomputations of the nearest neighbors (with --num_neighbors).", "r", 5);
+
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 
 using namespace mlpack;
@@ -198,6 +209,20 @@ int main(int argc, char* argv[])
   const double minStep = CLI::GetParam<double>("min_step");
   const double maxStep = CLI::GetParam<double>("max_step");
   const size_t batchSize = (size_t) CLI::GetParam<int>("batch_size");
+  const size_t numNeighbors = (size_t) CLI::GetParam<int>("num_neighbors");
+  const size_t neighborRefresh = (size_t) CLI::GetParam<int>(
+      "neighbor_refresh");
+
+  if (CLI::GetParam<int>("num_neighbors") < 0)
+  {
+    Log::Fatal << "Invalid number of neighbors: "
+        << CLI::GetParam<int>("num_neighbors") << "; must be nonnegative!"
+        << endl;
+  }
+
+  if (CLI::HasParam("neighbor_refresh") && numNeighbors == 0)
+    Log::Warn << "Parameter --neighbor_refresh ignored (--num_neighbors is not"
+        << " specified)." << endl;
 
   // Load data.
   arma::mat data = std::move(CLI::GetParam<arma::mat>("input"));
@@ -246,6 +271,8 @@ int main(int argc, char* argv[])
   if (optimizerType == "sgd")
   {
     NCA<LMetric<2> > nca(data, labels);
+    nca.Optimizer().Function().NumNeighbors() = numNeighbors;
+    nca.Optimizer().Function().RefreshInterval() = neighborRefresh;
     nca.Optimizer().StepSize() = stepSize;
     nca.Optimizer().MaxIterations() = maxIterations;
     nca.Optimizer().Tolerance() = tolerance;
@@ -256,6 +283,8 @@ int main(int argc, char* argv[])
   else if (optimizerType == "lbfgs")
   {
     NCA<LMetric<2>, L_BFGS> nca(data, labels);
+    nca.Optimizer().Function().NumNeighbors() = numNeighbors;
+    nca.Optimizer().Function().RefreshInterval() = neighborRefresh;
     nca.Optimizer().NumBasis() = numBasis;
     nca.Optimizer().MaxIterations() = maxIterations;
     nca.Optimizer().ArmijoConstant() = armijoConstant;
@@ -270,6 +299,8 @@ int main(int argc, char* argv[])
   else if (optimizerType == "minibatch-sgd")
   {
     NCA<LMetric<2>, MiniBatchSGD> nca(data, labels);
+    nca.Optimizer().Function().NumNeighbors() = numNeighbors;
+    nca.Optimizer().Function().RefreshInterval() = neighborRefresh;
     nca.Optimizer().StepSize() = stepSize;
     nca.Optimizer().MaxIterations() = maxIterations;
     nca.Optimizer().Tolerance() = tolerance;
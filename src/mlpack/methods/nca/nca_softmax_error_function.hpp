@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_NCA_NCA_SOFTMAX_ERROR_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -37,6 +38,20 @@ namespace nca {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * Evaluating the exact objective takes O(n^2) time (and each separable
+ * evaluation takes O(n) time).  If numNeighbors is nonzero, the sums in the
+ * denominators and numerators of p_ij are instead restricted to the
+ * numNeighbors nearest neighbors of each point in the stretched space (found
+ * with Euclidean distance by mlpack::neighbor::KNN).  The neighbor lists are
+ * cached, since the neighborhoods change slowly as the stretching matrix is
+ * learned, and they are recomputed after refreshInterval passes over the data:
+ * refreshInterval evaluations of the non-separable objective, or gradients of
+ * refreshInterval * n points with the separable or batch Gradient().  The
+ * separable and batch gradients only refresh the neighbor lists when the
+ * gradient of the first point is taken, so that they stay the same during a
+ * pass over the data; the separable and batch Evaluate() never refresh them.
+ * This approximation makes the objective O(n k) to evaluate.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class SoftmaxErrorFunction
@@ -51,10 +66,16 @@ class SoftmaxErrorFunction
    * @param dataset Matrix containing the dataset.
    * @param labels Vector of class labels for each point in the dataset.
    * @param kernel Instantiated kernel (optional).
+   * @param numNeighbors Number of nearest neighbors to restrict the softmax of
+   *     each point to (0 means all points are used).
+   * @param refreshInterval Number of passes over the data between
+   *     recomputations of the nearest neighbors.
    */
   SoftmaxErrorFunction(const arma::mat& dataset,
                        const arma::Row<size_t>& labels,
-                       MetricType metric = MetricType());
+                       MetricType metric = MetricType(),
+                       const size_t numNeighbors = 0,
+                       const size_t refreshInterval = 5);
 
   /**
    * Evaluate the softmax function for the given covariance matrix.  This is the
@@ -92,7 +113,8 @@ class SoftmaxErrorFunction
    * matrix on only one point of the dataset.  This is the separable
    * implementation, where the objective function is decomposed into the sum of
    * many objective functions, and here, only one of those constituent objective
-   * functions is returned.
+   * functions is returned.  If numNeighbors is nonzero, i is 0, and the refresh
+   * interval has passed, the nearest neighbors are recomputed first.
    *
    * @param covariance Covariance matrix of Mahalanobis distance.
    * @param i Index of point to use for objective function.
@@ -102,6 +124,35 @@ class SoftmaxErrorFunction
                 const size_t i,
                 arma::mat& gradient);
 
+  /**
+   * Evaluate the softmax objective function for the given covariance matrix on
+   * the points begin, ..., begin + batchSize - 1 of the dataset.  This does not
+   * refresh the nearest neighbors.
+   *
+   * @param covariance Covariance matrix of Mahalanobis distance.
+   * @param begin Index of the first point to use for the objective function.
+   * @param batchSize Number of points to use for the objective function.
+   */
+  double Evaluate(const arma::mat& covariance,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Evaluate the gradient of the softmax function for the given covariance
+   * matrix on the points begin, ..., begin + batchSize - 1 of the dataset.
+   * If numNeighbors is nonzero, begin is 0, and the refresh interval has
+   * passed, the nearest neighbors are recomputed first.
+   *
+   * @param covariance Covariance matrix of Mahalanobis distance.
+   * @param begin Index of the first point to use for the gradient.
+   * @param batchSize Number of points to use for the gradient.
+   * @param gradient Matrix to store the calculated gradient in.
+   */
+  void Gradient(const arma::mat& covariance,
+                const size_t begin,
+                const size_t batchSize,
+                arma::mat& gradient);
+
   /**
    * Get the initial point.
    */
@@ -113,6 +164,20 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of nearest neighbors used (0 means all points).
+  size_t NumNeighbors() const { return numNeighbors; }
+  //! Modify the number of nearest neighbors used (0 means all points).
+  size_t& NumNeighbors() { return numNeighbors; }
+
+  //! Get the number of passes over the data between neighbor recomputations.
+  size_t RefreshInterval() const { return refreshInterval; }
+  //! Modify the number of passes over the data between neighbor
+  //! recomputations.
+  size_t& RefreshInterval() { return refreshInterval; }
+
+  //! Get the cached nearest neighbors of each point (one column per point).
+  const arma::Mat<size_t>& Neighbors() const { return neighbors; }
+
  private:
   //! The dataset.
   const arma::mat& dataset;
@@ -135,6 +200,38 @@ class SoftmaxErrorFunction
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
+  //! The number of nearest neighbors used (0 means all points).
+  size_t numNeighbors;
+  //! The number of passes over the data between neighbor recomputations.
+  size_t refreshInterval;
+  //! The cached nearest neighbors of each point in the stretched space.
+  arma::Mat<size_t> neighbors;
+  //! The number of points evaluated since the neighbors were recomputed.
+  size_t pointsSinceRefresh;
+
+  //! Returns true if the nearest neighbors of every point have been computed.
+  bool HasNeighbors() const;
+
+  /**
+   * Compute the nearest neighbors of each point in the space stretched by the
+   * given coordinates.  This is only used when numNeighbors is nonzero.
+   *
+   * @param coordinates Coordinates matrix to stretch the dataset with.
+   */
+  void ComputeNeighbors(const arma::mat& coordinates);
+
+  /**
+   * Recompute the nearest neighbors of each point in the space stretched by
+   * the given coordinates, if they have not been computed yet or the refresh
+   * interval has passed, and then count the given number of evaluated points.
+   * This is only used by the non-separable Evaluate() and Gradient() and the
+   * separable Gradient(), when numNeighbors is nonzero.
+   *
+   * @param coordinates Coordinates matrix to stretch the dataset with.
+   * @param points Number of points that are about to be evaluated.
+   */
+  void UpdateNeighbors(const arma::mat& coordinates, const size_t points);
+
   /**
    * Precalculate the denominators and numerators that will make up the p_ij,
    * but only if the coordinates matrix is different than the last coordinates
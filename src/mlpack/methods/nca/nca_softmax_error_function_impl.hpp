@@ -23,11 +23,16 @@ template<typename MetricType>
 SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     const arma::mat& dataset,
     const arma::Row<size_t>& labels,
-    MetricType metric) :
+    MetricType metric,
+    const size_t numNeighbors,
+    const size_t refreshInterval) :
     dataset(dataset),
     labels(labels),
     metric(metric),
-    precalculated(false)
+    precalculated(false),
+    numNeighbors(numNeighbors),
+    refreshInterval(refreshInterval),
+    pointsSinceRefresh(0)
 { /* nothing to do */ }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -51,8 +56,40 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
   double denominator = 0;
   double numerator = 0;
 
-  // It's quicker to do this now than one point at a time later.
-  stretchedDataset = coordinates * dataset;
+  if (numNeighbors > 0)
+  {
+    // Only the nearest neighbors of the point are considered, so only those
+    // need to be stretched.  Only the gradient counts towards the refresh
+    // interval, so the neighbor lists are never refreshed here.
+    if (!HasNeighbors())
+      ComputeNeighbors(coordinates);
+
+    const arma::vec stretchedPoint = coordinates * dataset.col(i);
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      const size_t k = neighbors(j, i);
+      const arma::vec stretchedNeighbor = coordinates * dataset.col(k);
+      const double eval = std::exp(-metric.Evaluate(stretchedPoint,
+                                                    stretchedNeighbor));
+
+      if (labels[i] == labels[k])
+        numerator += eval;
+
+      denominator += eval;
+    }
+
+    if (denominator == 0.0)
+    {
+      Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
+      return 0;
+    }
+
+    return -(numerator / denominator);
+  }
+
+  // It's quicker to do this now than one point at a time later.  The stretched
+  // dataset of the non-separable overloads is not touched.
+  const arma::mat stretched = coordinates * dataset;
 
   for (size_t k = 0; k < dataset.n_cols; ++k)
   {
@@ -61,8 +98,8 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
       continue;
 
     // We want to evaluate exp(-D(A x_i, A x_k)).
-    double eval = std::exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                            stretchedDataset.unsafe_col(k)));
+    double eval = std::exp(-metric.Evaluate(stretched.unsafe_col(i),
+                                            stretched.unsafe_col(k)));
 
     // If they are in the same class, update the numerator.
     if (labels[i] == labels[k])
@@ -105,6 +142,36 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
   arma::mat sum;
   sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
+
+  if (numNeighbors > 0)
+  {
+    // The neighbor relation is not symmetric, so each p_ik is handled
+    // separately:
+    //   if class of i is the same as the class of k, add
+    //     (p_i - 1) p_ik x_ik x_ik^T
+    //   otherwise, add
+    //     p_i p_ik x_ik x_ik^T
+    for (size_t i = 0; i < stretchedDataset.n_cols; i++)
+    {
+      for (size_t j = 0; j < neighbors.n_rows; j++)
+      {
+        const size_t k = neighbors(j, i);
+        const double eval = exp(-metric.Evaluate(
+            stretchedDataset.unsafe_col(i), stretchedDataset.unsafe_col(k)));
+        const double p_ik = eval / denominators(i);
+
+        arma::vec x_ik = dataset.col(i) - dataset.col(k);
+        if (labels[i] == labels[k])
+          sum += ((p[i] - 1) * p_ik) * (x_ik * trans(x_ik));
+        else
+          sum += (p[i] * p_ik) * (x_ik * trans(x_ik));
+      }
+    }
+
+    gradient = -2 * coordinates * sum;
+    return;
+  }
+
   for (size_t i = 0; i < stretchedDataset.n_cols; i++)
   {
     for (size_t k = (i + 1); k < stretchedDataset.n_cols; k++)
@@ -150,33 +217,69 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
   secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-  // Compute the stretched dataset.
-  stretchedDataset = coordinates * dataset;
-
-  for (size_t k = 0; k < dataset.n_cols; ++k)
+  if (numNeighbors > 0)
   {
-    // Don't consider the case where the points are the same.
-    if (i == k)
-      continue;
+    // Only the nearest neighbors of the point are considered, so only those
+    // need to be stretched.  The neighbor lists are only refreshed when the
+    // gradient of the first point is taken, so they do not change in the
+    // middle of a pass over the data.
+    if (i == 0 || !HasNeighbors())
+      UpdateNeighbors(coordinates, 1);
+    else
+      ++pointsSinceRefresh;
+
+    const arma::vec stretchedPoint = coordinates * dataset.col(i);
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      const size_t k = neighbors(j, i);
+      const arma::vec stretchedNeighbor = coordinates * dataset.col(k);
+      const double eval = exp(-metric.Evaluate(stretchedPoint,
+                                               stretchedNeighbor));
 
-    // Calculate the numerator of p_ik.
-    double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                       stretchedDataset.unsafe_col(k)));
+      arma::vec x_ik = dataset.col(i) - dataset.col(k);
+      if (labels[i] == labels[k])
+      {
+        numerator += eval;
+        secondTerm += eval * x_ik * trans(x_ik);
+      }
 
-    // If the points are in the same class, we must add to the second term of
-    // the gradient as well as the numerator of p_i.  We will divide by the
-    // denominator of p_ik later.  For x_ik we are not using stretched points.
-    arma::vec x_ik = dataset.col(i) - dataset.col(k);
-    if (labels[i] == labels[k])
-    {
-      numerator += eval;
-      secondTerm += eval * x_ik * trans(x_ik);
+      denominator += eval;
+      firstTerm += eval * x_ik * trans(x_ik);
     }
+  }
+  else
+  {
+    // Compute the stretched dataset.  The stretched dataset of the
+    // non-separable overloads is not touched.
+    const arma::mat stretched = coordinates * dataset;
 
-    // We always have to add to the denominator of p_i and the first term of the
-    // gradient computation.  We will divide by the denominator of p_ik later.
-    denominator += eval;
-    firstTerm += eval * x_ik * trans(x_ik);
+    for (size_t k = 0; k < dataset.n_cols; ++k)
+    {
+      // Don't consider the case where the points are the same.
+      if (i == k)
+        continue;
+
+      // Calculate the numerator of p_ik.
+      double eval = exp(-metric.Evaluate(stretched.unsafe_col(i),
+                                         stretched.unsafe_col(k)));
+
+      // If the points are in the same class, we must add to the second term
+      // of the gradient as well as the numerator of p_i.  We will divide by the
+      // denominator of p_ik later.  For x_ik we are not using stretched
+      // points.
+      arma::vec x_ik = dataset.col(i) - dataset.col(k);
+      if (labels[i] == labels[k])
+      {
+        numerator += eval;
+        secondTerm += eval * x_ik * trans(x_ik);
+      }
+
+      // We always have to add to the denominator of p_i and the first term of
+      // the gradient computation.  We will divide by the denominator of p_ik
+      // later.
+      denominator += eval;
+      firstTerm += eval * x_ik * trans(x_ik);
+    }
   }
 
   // Calculate p_i.
@@ -186,7 +289,7 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
     Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
     // If the denominator is zero, then all p_ik should be zero and there is
     // no gradient contribution from this point.
-    gradient.zeros(coordinates.n_rows, coordinates.n_rows);
+    gradient.zeros(coordinates.n_rows, coordinates.n_cols);
     return;
   }
   else
@@ -201,6 +304,42 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   gradient = -2 * coordinates * (p * firstTerm - secondTerm);
 }
 
+//! The batch objective function.
+template<typename MetricType>
+double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
+                                                  const size_t begin,
+                                                  const size_t batchSize)
+{
+  // Only the gradient counts towards the refresh interval, so that evaluating
+  // the objective of a batch that was just used for an update does not count
+  // its points twice.
+  if (numNeighbors > 0 && !HasNeighbors())
+    ComputeNeighbors(coordinates);
+
+  double objective = 0;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+    objective += Evaluate(coordinates, i);
+
+  return objective;
+}
+
+//! The batch gradient.
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
+                                                const size_t begin,
+                                                const size_t batchSize,
+                                                arma::mat& gradient)
+{
+  // The per-point gradients count the points towards the refresh interval.
+  gradient.zeros(coordinates.n_rows, coordinates.n_cols);
+  arma::mat pointGradient;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+  {
+    Gradient(coordinates, i, pointGradient);
+    gradient += pointGradient;
+  }
+}
+
 template<typename MetricType>
 const arma::mat SoftmaxErrorFunction<MetricType>::GetInitialPoint() const
 {
@@ -223,31 +362,52 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   lastCoordinates = coordinates;
   stretchedDataset = coordinates * dataset;
 
-  // For each point i, we must evaluate the softmax function:
-  //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
-  //   p_i = sum_{j in class of i} p_ij
-  // We will do this by keeping track of the denominators for each i as well as
-  // the numerators (the sum for all j in class of i).  This will be on the
-  // order of O((n * (n + 1)) / 2), which really isn't all that great.
   p.zeros(stretchedDataset.n_cols);
   denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; i++)
+  if (numNeighbors > 0)
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; j++)
+    // Only sum over the nearest neighbors of each point.  This is O(n k).
+    UpdateNeighbors(coordinates, dataset.n_cols);
+    for (size_t i = 0; i < stretchedDataset.n_cols; i++)
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
-
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
+      for (size_t j = 0; j < neighbors.n_rows; j++)
+      {
+        const size_t k = neighbors(j, i);
+        const double eval = exp(-metric.Evaluate(
+            stretchedDataset.unsafe_col(i), stretchedDataset.unsafe_col(k)));
 
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
+        denominators[i] += eval;
+        if (labels[i] == labels[k])
+          p[i] += eval;
+      }
+    }
+  }
+  else
+  {
+    // For each point i, we must evaluate the softmax function:
+    //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
+    //   p_i = sum_{j in class of i} p_ij
+    // We will do this by keeping track of the denominators for each i as well
+    // as the numerators (the sum for all j in class of i).  This will be on
+    // the order of O((n * (n + 1)) / 2), which really isn't all that great.
+    for (size_t i = 0; i < stretchedDataset.n_cols; i++)
+    {
+      for (size_t j = (i + 1); j < stretchedDataset.n_cols; j++)
       {
-        p[i] += eval;
-        p[j] += eval;
+        // Evaluate exp(-d(x_i, x_j)).
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(j)));
+
+        // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
+        denominators[i] += eval;
+        denominators[j] += eval;
+
+        // If i and j are the same class, add to numerator of both.
+        if (labels[i] == labels[j])
+        {
+          p[i] += eval;
+          p[j] += eval;
+        }
       }
     }
   }
@@ -272,6 +432,44 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   precalculated = true;
 }
 
+template<typename MetricType>
+bool SoftmaxErrorFunction<MetricType>::HasNeighbors() const
+{
+  // A point is never its own neighbor.
+  const size_t k = std::min(numNeighbors, (size_t) dataset.n_cols - 1);
+
+  return (neighbors.n_rows == k) && (neighbors.n_cols == dataset.n_cols);
+}
+
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::ComputeNeighbors(
+    const arma::mat& coordinates)
+{
+  // A point is never its own neighbor.
+  const size_t k = std::min(numNeighbors, (size_t) dataset.n_cols - 1);
+
+  const arma::mat stretched = coordinates * dataset;
+  neighbor::KNN knn(stretched);
+  arma::mat distances;
+  knn.Search(k, neighbors, distances);
+
+  pointsSinceRefresh = 0;
+  // Any precalculated p_i used the old neighbors.
+  precalculated = false;
+}
+
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::UpdateNeighbors(
+    const arma::mat& coordinates,
+    const size_t points)
+{
+  if (!HasNeighbors() ||
+      (pointsSinceRefresh >= refreshInterval * dataset.n_cols))
+    ComputeNeighbors(coordinates);
+
+  pointsSinceRefresh += points;
+}
+
 } // namespace nca
 } // namespace mlpack
 
@@ -52,6 +52,22 @@ class NeighborSearchRules
                       const double epsilon = 0,
                       const bool sameSet = false);
 
+  /**
+   * Copy the given rules object.  If it holds its own candidate lists, the copy
+   * gets (and uses) a copy of them; a copy of a worker shares the candidate
+   * lists of the worker.
+   */
+  NeighborSearchRules(const NeighborSearchRules& other);
+
+  /**
+   * Take ownership of the state of the given rules object.  If it holds its own
+   * candidate lists, they are moved to this object.
+   */
+  NeighborSearchRules(NeighborSearchRules&& other);
+
+  //! The rules can't be assigned, since they hold references to the data.
+  NeighborSearchRules& operator=(const NeighborSearchRules& other) = delete;
+
   /**
    * Store the list of candidates for each query point in the given matrices.
    *
@@ -61,6 +77,24 @@ class NeighborSearchRules
    */
   void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
 
+  /**
+   * Create a rules object for a worker of a parallel traversal.  The returned
+   * object shares the lists of candidate neighbors with this object, but it
+   * has its own traversal information, base case cache and counters.
+   * Therefore, the worker may be used concurrently with other workers, as long
+   * as no two of them search for the neighbors of the same query point.  This
+   * object must outlive the worker.
+   */
+  NeighborSearchRules Fork();
+
+  /**
+   * Add the number of base cases and scores performed by a worker (created
+   * with Fork()) to the counts of this object.
+   *
+   * @param worker Worker rules object whose traversal is finished.
+   */
+  void Merge(const NeighborSearchRules& worker);
+
   /**
    * Get the distance from the query point to the reference point.
    * This will update the list of candidates with the new point if appropriate
@@ -177,8 +211,13 @@ class NeighborSearchRules
   typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
       CandidateList;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  This is empty if the object
+  //! is a worker created by Fork().
+  std::vector<CandidateList> candidateStorage;
+
+  //! The candidate lists in use; these are held either by this object or by
+  //! the object this worker was forked from.
+  std::vector<CandidateList>* candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -208,6 +247,13 @@ class NeighborSearchRules
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
 
+  /**
+   * Construct a worker rules object that uses the given candidate lists (see
+   * Fork()).
+   */
+  NeighborSearchRules(const NeighborSearchRules& other,
+                      std::vector<CandidateList>* sharedCandidates);
+
   /**
    * Recalculate the bound for a given query node.
    */
@@ -54,9 +54,89 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
+  candidateStorage.reserve(querySet.n_cols);
   for (size_t i = 0; i < querySet.n_cols; i++)
-    candidates.push_back(pqueue);
+    candidateStorage.push_back(pqueue);
+  candidates = &candidateStorage;
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
+    const NeighborSearchRules& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidateStorage(other.candidateStorage),
+    k(other.k),
+    metric(other.metric),
+    sameSet(other.sameSet),
+    epsilon(other.epsilon),
+    lastQueryIndex(other.lastQueryIndex),
+    lastReferenceIndex(other.lastReferenceIndex),
+    lastBaseCase(other.lastBaseCase),
+    baseCases(other.baseCases),
+    scores(other.scores),
+    traversalInfo(other.traversalInfo)
+{
+  // The candidate pointer must not point into the storage of the other object.
+  candidates = (other.candidates == &other.candidateStorage) ?
+      &candidateStorage : other.candidates;
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
+    NeighborSearchRules&& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidateStorage(std::move(other.candidateStorage)),
+    k(other.k),
+    metric(other.metric),
+    sameSet(other.sameSet),
+    epsilon(other.epsilon),
+    lastQueryIndex(other.lastQueryIndex),
+    lastReferenceIndex(other.lastReferenceIndex),
+    lastBaseCase(other.lastBaseCase),
+    baseCases(other.baseCases),
+    scores(other.scores),
+    traversalInfo(other.traversalInfo)
+{
+  candidates = (other.candidates == &other.candidateStorage) ?
+      &candidateStorage : other.candidates;
+  other.candidates = &other.candidateStorage;
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
+    const NeighborSearchRules& other,
+    std::vector<CandidateList>* sharedCandidates) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidates(sharedCandidates),
+    k(other.k),
+    metric(other.metric),
+    sameSet(other.sameSet),
+    epsilon(other.epsilon),
+    lastQueryIndex(other.querySet.n_cols),
+    lastReferenceIndex(other.referenceSet.n_cols),
+    baseCases(0),
+    scores(0),
+    traversalInfo(other.traversalInfo)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+NeighborSearchRules<SortPolicy, MetricType, TreeType>
+NeighborSearchRules<SortPolicy, MetricType, TreeType>::Fork()
+{
+  return NeighborSearchRules(*this, candidates);
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::Merge(
+    const NeighborSearchRules& worker)
+{
+  baseCases += worker.baseCases;
+  scores += worker.scores;
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -69,7 +149,7 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; i++)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; j++)
     {
       neighbors(k - j, i) = pqueue.top().second;
@@ -143,7 +223,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ?
@@ -179,7 +259,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
@@ -404,7 +484,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double distance = candidates[queryNode.Point(i)].top().first;
+    const double distance = (*candidates)[queryNode.Point(i)].top().first;
     if (SortPolicy::IsBetter(worstDistance, distance))
       worstDistance = distance;
     if (SortPolicy::IsBetter(distance, bestPointDistance))
@@ -499,7 +579,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double distance)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(distance, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
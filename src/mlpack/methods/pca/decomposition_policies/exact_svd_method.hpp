@@ -69,6 +69,46 @@ class ExactSVDPolicy
     // Project the samples to the principals.
     transformedData = arma::trans(eigvec) * centeredData;
   }
+
+  /**
+   * Apply Principal Component Analysis to data given by a block reader.  The
+   * covariance matrix is accumulated one centered block at a time and then
+   * decomposed, so this takes a single pass but needs memory quadratic in the
+   * dimensionality of the data.
+   *
+   * @param reader Block reader over the data.
+   * @param mean Mean of the data.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename BlockReaderType>
+  void Apply(BlockReaderType& reader,
+             const arma::vec& mean,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t /* rank */)
+  {
+    arma::mat covariance(reader.Rows(), reader.Rows(), arma::fill::zeros);
+    arma::mat block;
+
+    reader.Reset();
+    while (reader.NextBlock(block))
+    {
+      block.each_col() -= mean;
+      covariance += block * block.t();
+    }
+    reader.Reset();
+
+    covariance /= (reader.Cols() - 1);
+    covariance = 0.5 * (covariance + covariance.t());
+
+    // eig_sym() returns the eigenvalues in ascending order, so reverse them to
+    // match the ordering of the singular values above.
+    arma::eig_sym(eigVal, eigvec, covariance);
+    eigVal = arma::flipud(eigVal);
+    eigvec = arma::fliplr(eigvec);
+  }
 };
 
 } // namespace pca
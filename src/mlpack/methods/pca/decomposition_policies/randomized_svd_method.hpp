@@ -78,6 +78,32 @@ class RandomizedSVDPolicy
     transformedData = arma::trans(eigvec) * centeredData;
   }
 
+  /**
+   * Apply Principal Component Analysis to data given by a block reader using
+   * the streaming variant of the randomized SVD, which takes MaxIterations() +
+   * 1 passes over the data.
+   *
+   * @param reader Block reader over the data.
+   * @param mean Mean of the data.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  template<typename BlockReaderType>
+  void Apply(BlockReaderType& reader,
+             const arma::vec& mean,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t rank)
+  {
+    svd::RandomizedSVD rsvd(iteratedPower, maxIterations);
+    rsvd.Apply(reader, mean, eigvec, eigVal, rank);
+
+    // Square the singular values and divide by the number of points to get the
+    // eigenvalues of the covariance matrix.
+    eigVal %= eigVal / (reader.Cols() - 1);
+  }
+
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
   //! Modify the size of the normalized power iterations.
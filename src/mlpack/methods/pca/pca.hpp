@@ -17,6 +17,7 @@
 #define MLPACK_METHODS_PCA_PCA_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/block_reader.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 
 namespace mlpack {
@@ -105,6 +106,33 @@ class PCAType
    */
   double Apply(arma::mat& data, const double varRetained);
 
+  /**
+   * Apply Principal Component Analysis to data that is read one block of
+   * points at a time (see data::MatrixBlockReader, data::BinaryBlockReader and
+   * data::CSVBlockReader), so the full dataset never needs to be held in
+   * memory.  The data is centered implicitly; no centered copy is made.  The
+   * decomposition policy must provide a streaming Apply() overload; this is
+   * the case for ExactSVDPolicy (which accumulates the covariance matrix, so it
+   * needs memory quadratic in the dimensionality) and RandomizedSVDPolicy.
+   *
+   * Transformed points can be obtained block by block afterwards as
+   * eigvec.t() * (block - mean).  Scaling is not supported in this mode, since
+   * it would need an extra pass over the data; a std::runtime_error is thrown
+   * if ScaleData() is set.
+   *
+   * @param reader Block reader over the data.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param mean Vector to store the mean of the data in.
+   * @param newDimension Number of components to compute (0 means all of them).
+   */
+  template<typename BlockReaderType>
+  void Apply(BlockReaderType& reader,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             arma::vec& mean,
+             const size_t newDimension = 0);
+
   //! Get whether or not this PCA object will scale (by standard deviation)
   //! the data when PCA is performed.
   bool ScaleData() const { return scaleData; }
@@ -173,6 +173,46 @@ double PCAType<DecompositionPolicy>::Apply(arma::mat& data,
   return varSum;
 }
 
+/**
+ * Apply Principal Component Analysis to data given by a block reader.  One
+ * pass computes the mean, and the decomposition policy then takes however many
+ * passes it needs.
+ */
+template<typename DecompositionPolicy>
+template<typename BlockReaderType>
+void PCAType<DecompositionPolicy>::Apply(BlockReaderType& reader,
+                                         arma::vec& eigVal,
+                                         arma::mat& eigvec,
+                                         arma::vec& mean,
+                                         const size_t newDimension)
+{
+  // Parameter validation.
+  if (scaleData)
+    Log::Fatal << "PCA::Apply(): scaling is not supported when the data is "
+        << "given by a block reader!" << endl;
+  if (newDimension > reader.Rows())
+    Log::Fatal << "PCA::Apply(): newDimension (" << newDimension << ") cannot "
+        << "be greater than the existing dimensionality of the data ("
+        << reader.Rows() << ")!" << endl;
+  if (reader.Cols() < 2)
+    Log::Fatal << "PCA::Apply(): at least two points are needed!" << endl;
+
+  const size_t rank = (newDimension == 0) ? reader.Rows() : newDimension;
+
+  Timer::Start("pca");
+
+  data::BlockMean(reader, mean);
+  decomposition.Apply(reader, mean, eigVal, eigvec, rank);
+
+  // The policy may return more components than were asked for.
+  if (eigvec.n_cols > rank)
+    eigvec.shed_cols(rank, eigvec.n_cols - 1);
+  if (eigVal.n_elem > rank)
+    eigVal.shed_rows(rank, eigVal.n_elem - 1);
+
+  Timer::Stop("pca");
+}
+
 } // namespace pca
 } // namespace mlpack
 
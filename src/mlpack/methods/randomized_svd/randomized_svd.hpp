@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/block_reader.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -120,6 +121,46 @@ class RandomizedSVD
              arma::mat& v,
              const size_t rank);
 
+  /**
+   * Compute the leading left singular vectors and singular values of the
+   * (implicitly centered) data given by a block reader, without ever holding
+   * more than one block of points in memory.  One pass is used to compute the
+   * mean, and then MaxIterations() + 1 passes each multiply the range sketch
+   * by the centered covariance; the centering is applied to the sketch rather
+   * than the data, so no centered copy of any block is made.
+   *
+   * The right singular vectors are not computed, since they have one row per
+   * point and would defeat the purpose of streaming.
+   *
+   * @param reader Block reader over the data (see data::MatrixBlockReader).
+   * @param u Matrix to store the left singular vectors in.
+   * @param s Vector to store the singular values in.
+   * @param rank Rank of the approximation.
+   */
+  template<typename BlockReaderType>
+  void Apply(BlockReaderType& reader,
+             arma::mat& u,
+             arma::vec& s,
+             const size_t rank);
+
+  /**
+   * Compute the leading left singular vectors and singular values of the data
+   * given by a block reader, centered by the given mean.  This is the same as
+   * the overload above, but skips the pass that computes the mean.
+   *
+   * @param reader Block reader over the data (see data::MatrixBlockReader).
+   * @param mean Mean of the data.
+   * @param u Matrix to store the left singular vectors in.
+   * @param s Vector to store the singular values in.
+   * @param rank Rank of the approximation.
+   */
+  template<typename BlockReaderType>
+  void Apply(BlockReaderType& reader,
+             const arma::vec& mean,
+             arma::mat& u,
+             arma::vec& s,
+             const size_t rank);
+
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
   //! Modify the size of the normalized power iterations.
@@ -149,4 +190,7 @@ class RandomizedSVD
 } // namespace svd
 } // namespace mlpack
 
+// Include implementation of the streaming variant.
+#include "randomized_svd_impl.hpp"
+
 #endif
@@ -0,0 +1,103 @@
+/**
+ * @file randomized_svd_impl.hpp
+ *
+ * Implementation of the streaming (block reader) variant of the randomized SVD
+ * method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_IMPL_HPP
+#define MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "randomized_svd.hpp"
+
+namespace mlpack {
+namespace svd {
+
+template<typename BlockReaderType>
+void RandomizedSVD::Apply(BlockReaderType& reader,
+                          arma::mat& u,
+                          arma::vec& s,
+                          const size_t rank)
+{
+  arma::vec mean;
+  data::BlockMean(reader, mean);
+
+  Apply(reader, mean, u, s, rank);
+}
+
+template<typename BlockReaderType>
+void RandomizedSVD::Apply(BlockReaderType& reader,
+                          const arma::vec& mean,
+                          arma::mat& u,
+                          arma::vec& s,
+                          const size_t rank)
+{
+  if (reader.Cols() == 0)
+    Log::Fatal << "RandomizedSVD::Apply(): no points given by block reader!"
+        << std::endl;
+  if (rank == 0)
+    Log::Fatal << "RandomizedSVD::Apply(): rank must be greater than zero!"
+        << std::endl;
+
+  // The size of the sketch can't exceed the dimensionality of the data.
+  const size_t sketchSize = std::min((iteratedPower == 0) ? rank + 2 :
+      iteratedPower, (size_t) reader.Rows());
+
+  arma::mat q, r;
+  arma::qr_econ(q, r, arma::randn<arma::mat>(reader.Rows(), sketchSize));
+
+  // Each pass multiplies the sketch by the scatter matrix of the centered data,
+  // (X - m 1') (X - m 1')' Q.  For each block we compute the centered
+  // projection T = (X_b - m 1')' Q as X_b' Q - 1 (m' Q) and then accumulate
+  // X_b T - m (1' T), so the blocks themselves are never centered.
+  arma::mat y(reader.Rows(), sketchSize);
+  arma::mat block, t;
+  for (size_t i = 0; i <= maxIterations; ++i)
+  {
+    if (i > 0)
+      arma::qr_econ(q, r, y);
+
+    const arma::rowvec meanProjection = mean.t() * q;
+
+    y.zeros();
+    reader.Reset();
+    while (reader.NextBlock(block))
+    {
+      t = block.t() * q;
+      t.each_row() -= meanProjection;
+      y += block * t - mean * arma::sum(t, 0);
+    }
+  }
+  reader.Reset();
+
+  // Rayleigh-Ritz: the eigendecomposition of Q' S Q (where S is the scatter
+  // matrix) gives the squared singular values, and Q times its eigenvectors
+  // gives the left singular vectors.
+  arma::mat projected = q.t() * y;
+  projected = 0.5 * (projected + projected.t());
+
+  arma::vec eigval;
+  arma::mat eigvec;
+  arma::eig_sym(eigval, eigvec, projected);
+
+  // eig_sym() returns the eigenvalues in ascending order.
+  const size_t outputRank = std::min(rank, sketchSize);
+  s.set_size(outputRank);
+  u.set_size(reader.Rows(), outputRank);
+  for (size_t i = 0; i < outputRank; ++i)
+  {
+    const size_t index = sketchSize - 1 - i;
+    s[i] = std::sqrt(std::max(eigval[index], 0.0));
+    u.col(i) = q * eigvec.col(index);
+  }
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -212,6 +212,9 @@ class RangeSearch
    *
    * - neighbors[i] and distances[i] are not sorted in any particular order.
    *
+   * Several threads may call this overload on the same object at once only if
+   * SupportsConcurrentSearch() returns true.
+   *
    * @param querySet Set of query points to search with.
    * @param range Range of distances in which to search.
    * @param neighbors Object which will hold the list of neighbors for each
@@ -309,9 +312,23 @@ class RangeSearch
   //! Modify whether naive search is being used.
   bool& Naive() { return naive; }
 
-  //! Get the number of base cases during the last search.
+  /**
+   * Returns true if several threads may call Search() with a query set on this
+   * object at once.  Single-tree search with a tree whose first point is the
+   * centroid of each node (such as the cover tree) caches base cases in the
+   * statistics of the shared reference tree, so it may not.
+   */
+  bool SupportsConcurrentSearch() const
+  {
+    return naive || !singleMode ||
+        !tree::TreeTraits<Tree>::FirstPointIsCentroid;
+  }
+
+  //! Get the number of base cases during the last search.  If several threads
+  //! searched at once, this is the count of the search that finished last.
   size_t BaseCases() const { return baseCases; }
-  //! Get the number of scores during the last search.
+  //! Get the number of scores during the last search.  If several threads
+  //! searched at once, this is the count of the search that finished last.
   size_t Scores() const { return scores; }
 
   //! Serialize the model.
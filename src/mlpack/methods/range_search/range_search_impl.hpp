@@ -462,9 +462,10 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
 
-  // Reset counts.
-  baseCases = 0;
-  scores = 0;
+  // The counts are accumulated locally, so that several threads can search
+  // with the same trained object (see SupportsConcurrentSearch()).
+  size_t searchBaseCases = 0;
+  size_t searchScores = 0;
 
   if (naive)
   {
@@ -476,7 +477,7 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
       for (size_t j = 0; j < referenceSet->n_cols; ++j)
         rules.BaseCase(i, j);
 
-    baseCases += (querySet.n_cols * referenceSet->n_cols);
+    searchBaseCases += (querySet.n_cols * referenceSet->n_cols);
   }
   else if (singleMode)
   {
@@ -489,8 +490,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     for (size_t i = 0; i < querySet.n_cols; ++i)
       traverser.Traverse(i, *referenceTree);
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    searchBaseCases += rules.BaseCases();
+    searchScores += rules.Scores();
   }
   else // Dual-tree recursion.
   {
@@ -509,8 +510,8 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
     traverser.Traverse(*queryTree, *referenceTree);
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+    searchBaseCases += rules.BaseCases();
+    searchScores += rules.Scores();
 
     // Clean up tree memory.
     delete queryTree;
@@ -518,6 +519,14 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   Timer::Stop("range_search/computing_neighbors");
 
+  // The counts are those of this search only, as for the other overloads; if
+  // several threads search at once, the search that finishes last sets them.
+  #pragma omp critical
+  {
+    baseCases = searchBaseCases;
+    scores = searchScores;
+  }
+
   // Map points back to original indices, if necessary.
   if (tree::TreeTraits<Tree>::RearrangesDataset)
   {
@@ -58,6 +58,13 @@ class RAModel;
  *
  * RASearch is currently known to not work with ball trees (#356).
  *
+ * If mlpack is compiled with OpenMP, the search is parallel: single-tree and
+ * naive search divide the query points between threads, and dual-tree search
+ * splits the query tree into disjoint subtrees that are traversed by separate
+ * threads.  Each query point draws its samples from its own random stream (see
+ * math::RandomStream), and the subtrees depend only on the query tree, so after
+ * math::RandomSeed() the results are the same for any number of threads.
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use.
@@ -419,6 +426,44 @@ class RASearch
   void Serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Traverse the reference tree for every query point with the single-tree
+   * traverser.  The query points are divided between OpenMP threads, each of
+   * which uses a worker forked from the given rules.
+   *
+   * @param rules Rules to search with.
+   * @param numQueries Number of query points.
+   */
+  template<typename RuleType>
+  void SingleTreeTraverse(RuleType& rules, const size_t numQueries);
+
+  /**
+   * Traverse the given query tree and the reference tree with the dual-tree
+   * traverser.  The query tree is split into disjoint subtrees (see
+   * QuerySubtrees()), each of which is traversed against the whole reference
+   * tree by an OpenMP thread with a worker forked from the given rules.
+   *
+   * @param rules Rules to search with.
+   * @param queryTree Tree built on the query points.
+   */
+  template<typename RuleType>
+  void DualTreeTraverse(RuleType& rules, Tree& queryTree);
+
+  /**
+   * Collect disjoint subtrees of the given node that together hold all of its
+   * descendants.  A node is split into its children only if it has more than
+   * maxSize descendants and its children do not share descendants; so, the
+   * subtrees depend only on the tree, and not on the number of threads.
+   *
+   * @param node Node to split.
+   * @param maxSize Largest number of descendants of a subtree that is not split
+   *     further.
+   * @param subtrees Vector to append the subtrees to.
+   */
+  static void QuerySubtrees(Tree& node,
+                            const size_t maxSize,
+                            std::vector<Tree*>& subtrees);
+
   //! Permutations of reference points during tree building.
   std::vector<size_t> oldFromNewReferences;
   //! Pointer to the root of the reference tree.
@@ -376,10 +376,22 @@ Search(const MatType& querySet,
         distinctSamples);
 
     // Run the base case on each combination of query point and sampled
-    // reference point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
+    // reference point.  Each thread handles its own query points with its own
+    // worker.
+    #pragma omp parallel
+    {
+      RuleType worker(rules.Fork());
+
+      // Visual Studio only implements OpenMP 2.0, which doesn't support
+      // unsigned loop variables.
+      #pragma omp for schedule(static)
+      for (intmax_t i = 0; i < (intmax_t) querySet.n_cols; ++i)
+        for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+          worker.BaseCase(i, (size_t) distinctSamples[j]);
+
+      #pragma omp critical
+      rules.Merge(worker);
+    }
 
     rules.GetResults(*neighborPtr, *distancePtr);
   }
@@ -394,12 +406,8 @@ Search(const MatType& querySet,
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Traverse for each point.
+      SingleTreeTraverse(rules, querySet.n_cols);
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
@@ -423,12 +431,11 @@ Search(const MatType& querySet,
 
     RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, tau, alpha,
         naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     Log::Info << "Query statistic pre-search: "
         << queryTree->Stat().NumSamplesMade() << std::endl;
 
-    traverser.Traverse(*queryTree, *referenceTree);
+    DualTreeTraverse(rules, *queryTree);
 
     Log::Info << "Dual-tree traversal complete." << std::endl;
     Log::Info << "Average number of distance calculations per query point: "
@@ -537,9 +544,7 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
   RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, tau, alpha,
       naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
-  // Create the traverser.
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
+  DualTreeTraverse(rules, *queryTree);
 
   rules.GetResults(*neighborPtr, distances);
 
@@ -603,26 +608,31 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
     math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
         distinctSamples);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // The naive brute-force solution.  Each thread handles its own query
+    // points with its own worker.
+    #pragma omp parallel
+    {
+      RuleType worker(rules.Fork());
+
+      // Visual Studio only implements OpenMP 2.0, which doesn't support
+      // unsigned loop variables.
+      #pragma omp for schedule(static)
+      for (intmax_t i = 0; i < (intmax_t) referenceSet->n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          worker.BaseCase(i, j);
+
+      #pragma omp critical
+      rules.Merge(worker);
+    }
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+    // Traverse for each point.
+    SingleTreeTraverse(rules, referenceSet->n_cols);
   }
   else
   {
-    // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-    traverser.Traverse(*referenceTree, *referenceTree);
+    DualTreeTraverse(rules, *referenceTree);
   }
 
   rules.GetResults(*neighborPtr, *distancePtr);
@@ -668,6 +678,97 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::ResetQueryTree(
     ResetQueryTree(&queryNode->Child(i));
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType>
+void RASearch<SortPolicy, MetricType, MatType, TreeType>::SingleTreeTraverse(
+    RuleType& rules,
+    const size_t numQueries)
+{
+  #pragma omp parallel
+  {
+    // Each thread traverses for its own query points with its own worker.
+    RuleType worker(rules.Fork());
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(worker);
+
+    // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+    // loop variables.
+    #pragma omp for schedule(dynamic, 16)
+    for (intmax_t i = 0; i < (intmax_t) numQueries; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    #pragma omp critical
+    rules.Merge(worker);
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType>
+void RASearch<SortPolicy, MetricType, MatType, TreeType>::DualTreeTraverse(
+    RuleType& rules,
+    Tree& queryTree)
+{
+  // Query sets of up to a thousand points are traversed in one piece, as
+  // before; larger query trees are split into at least 64 subtrees, which is
+  // enough to balance the work between threads.
+  const size_t maxSize = std::max((size_t) 1024,
+      queryTree.NumDescendants() / 64);
+  std::vector<Tree*> subtrees;
+  QuerySubtrees(queryTree, maxSize, subtrees);
+
+  // Visual Studio only implements OpenMP 2.0, which doesn't support unsigned
+  // loop variables.
+  #pragma omp parallel for schedule(dynamic)
+  for (intmax_t i = 0; i < (intmax_t) subtrees.size(); ++i)
+  {
+    // The subtrees are disjoint, so no two workers touch the results or the
+    // statistics of the same query node.
+    RuleType worker(rules.Fork());
+    typename Tree::template DualTreeTraverser<RuleType> traverser(worker);
+    traverser.Traverse(*subtrees[i], *referenceTree);
+
+    #pragma omp critical
+    rules.Merge(worker);
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RASearch<SortPolicy, MetricType, MatType, TreeType>::QuerySubtrees(
+    Tree& node,
+    const size_t maxSize,
+    std::vector<Tree*>& subtrees)
+{
+  // Only split the node if its children hold all of its descendants, and each
+  // of them only once.
+  size_t childDescendants = 0;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    childDescendants += node.Child(i).NumDescendants();
+
+  if (node.NumDescendants() <= maxSize || node.NumChildren() == 0 ||
+      childDescendants != node.NumDescendants())
+  {
+    subtrees.push_back(&node);
+    return;
+  }
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    QuerySubtrees(node.Child(i), maxSize, subtrees);
+}
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_RANN_RA_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace neighbor {
@@ -51,6 +52,11 @@ class RASearchRules
    *     approximated by sampling.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   *
+   * Every query point draws its samples from its own math::RandomStream,
+   * whose seed is drawn from the global random number generator when the
+   * object is constructed.  So, the samples made for a query point do not
+   * depend on how the query points are divided between threads.
    */
   RASearchRules(const arma::mat& referenceSet,
                 const arma::mat& querySet,
@@ -64,6 +70,23 @@ class RASearchRules
                 const size_t singleSampleLimit = 20,
                 const bool sameSet = false);
 
+  /**
+   * Copy the given rules object.  If it holds its own candidate lists, sample
+   * counts and random streams, the copy gets (and uses) a copy of them; a copy
+   * of a worker shares them with the worker.
+   */
+  RASearchRules(const RASearchRules& other);
+
+  /**
+   * Take ownership of the state of the given rules object.  If it holds its own
+   * candidate lists, sample counts and random streams, they are moved to this
+   * object.
+   */
+  RASearchRules(RASearchRules&& other);
+
+  //! The rules can't be assigned, since they hold references to the data.
+  RASearchRules& operator=(const RASearchRules& other) = delete;
+
   /**
    * Store the list of candidates for each query point in the given matrices.
    *
@@ -73,6 +96,24 @@ class RASearchRules
    */
   void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
 
+  /**
+   * Create a rules object for a worker of a parallel search.  The returned
+   * object shares the lists of candidate neighbors, the sample counts and the
+   * random streams of the query points with this object, but it has its own
+   * traversal information and counters.  Therefore, the worker may be used
+   * concurrently with other workers, as long as no two of them search for the
+   * neighbors of the same query point.  This object must outlive the worker.
+   */
+  RASearchRules Fork();
+
+  /**
+   * Add the number of distance computations performed by a worker (created
+   * with Fork()) to the count of this object.
+   *
+   * @param worker Worker rules object whose search is finished.
+   */
+  void Merge(const RASearchRules& worker);
+
   /**
    * Get the distance from the query point to the reference point.
    * This will update the list of candidates with the new point if appropriate.
@@ -228,10 +269,10 @@ class RASearchRules
   size_t NumDistComputations() { return numDistComputations; }
   size_t NumEffectiveSamples()
   {
-    if (numSamplesMade.n_elem == 0)
+    if (numSamplesMade->n_elem == 0)
       return 0;
     else
-      return arma::sum(numSamplesMade);
+      return arma::sum(*numSamplesMade);
   }
 
   typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
@@ -261,8 +302,13 @@ class RASearchRules
   typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
       CandidateList;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point.  This is empty if the object
+  //! is a worker created by Fork().
+  std::vector<CandidateList> candidateStorage;
+
+  //! The candidate lists in use; these are held either by this object or by
+  //! the object this worker was forked from.
+  std::vector<CandidateList>* candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -282,8 +328,19 @@ class RASearchRules
   //! The minimum number of samples required per query
   size_t numSamplesReqd;
 
-  //! The number of samples made for every query
-  arma::Col<size_t> numSamplesMade;
+  //! The number of samples made for every query.  This is empty if the object
+  //! is a worker created by Fork().
+  arma::Col<size_t> numSamplesMadeStorage;
+
+  //! The sample counts in use; see candidates.
+  arma::Col<size_t>* numSamplesMade;
+
+  //! The random stream of every query.  This is empty if the object is a worker
+  //! created by Fork().
+  std::vector<math::RandomStream> streamStorage;
+
+  //! The random streams in use; see candidates.
+  std::vector<math::RandomStream>* streams;
 
   //! The sampling ratio
   double samplingRatio;
@@ -296,6 +353,15 @@ class RASearchRules
 
   TraversalInfoType traversalInfo;
 
+  /**
+   * Construct a worker rules object that uses the candidate lists, sample
+   * counts and random streams of the given object (see Fork()).
+   */
+  RASearchRules(const RASearchRules& other,
+                std::vector<CandidateList>* sharedCandidates,
+                arma::Col<size_t>* sharedNumSamplesMade,
+                std::vector<math::RandomStream>* sharedStreams);
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
@@ -15,6 +15,10 @@
 // In case it hasn't been included yet.
 #include "ra_search_rules.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace neighbor {
 
@@ -63,7 +67,8 @@ RASearchRules(const arma::mat& referenceSet,
   Timer::Stop("computing_number_of_samples_reqd");
 
   // Initialize some statistics to be collected during the search.
-  numSamplesMade = arma::zeros<arma::Col<size_t> >(querySet.n_cols);
+  numSamplesMadeStorage = arma::zeros<arma::Col<size_t> >(querySet.n_cols);
+  numSamplesMade = &numSamplesMadeStorage;
   numDistComputations = 0;
   samplingRatio = (double) numSamplesReqd / (double) n;
 
@@ -80,23 +85,142 @@ RASearchRules(const arma::mat& referenceSet,
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
+  candidateStorage.reserve(querySet.n_cols);
+  for (size_t i = 0; i < querySet.n_cols; i++)
+    candidateStorage.push_back(pqueue);
+  candidates = &candidateStorage;
+
+  // Give each query its own random stream, so that its samples do not depend
+  // on the order in which the queries are searched.
+  const size_t seed = math::RandomStreamSeed();
+  streamStorage.reserve(querySet.n_cols);
   for (size_t i = 0; i < querySet.n_cols; i++)
-    candidates.push_back(pqueue);
+    streamStorage.push_back(math::RandomStream(seed, i));
+  streams = &streamStorage;
 
   if (naive)// No tree traversal; just do naive sampling here.
   {
-    // Sample enough points.
-    arma::uvec distinctSamples;
-    for (size_t i = 0; i < querySet.n_cols; ++i)
+    #pragma omp parallel
     {
-      math::ObtainDistinctSamples(0, n, numSamplesReqd, distinctSamples);
-      for (size_t j = 0; j < distinctSamples.n_elem; j++)
-        BaseCase(i, (size_t) distinctSamples[j]);
+      // Each thread samples for its own queries with its own worker.
+      RASearchRules worker(Fork());
+      arma::uvec distinctSamples;
+
+      // Visual Studio only implements OpenMP 2.0, which doesn't support
+      // unsigned loop variables.
+      #pragma omp for schedule(dynamic, 16)
+      for (intmax_t i = 0; i < (intmax_t) querySet.n_cols; ++i)
+      {
+        // Sample enough points.
+        math::ObtainDistinctSamples(0, n, numSamplesReqd, distinctSamples,
+            (*streams)[i]);
+        for (size_t j = 0; j < distinctSamples.n_elem; j++)
+          worker.BaseCase(i, (size_t) distinctSamples[j]);
+      }
+
+      #pragma omp critical
+      Merge(worker);
     }
   }
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+RASearchRules<SortPolicy, MetricType, TreeType>::
+RASearchRules(const RASearchRules& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidateStorage(other.candidateStorage),
+    k(other.k),
+    metric(other.metric),
+    sampleAtLeaves(other.sampleAtLeaves),
+    firstLeafExact(other.firstLeafExact),
+    singleSampleLimit(other.singleSampleLimit),
+    numSamplesReqd(other.numSamplesReqd),
+    numSamplesMadeStorage(other.numSamplesMadeStorage),
+    streamStorage(other.streamStorage),
+    samplingRatio(other.samplingRatio),
+    numDistComputations(other.numDistComputations),
+    sameSet(other.sameSet),
+    traversalInfo(other.traversalInfo)
+{
+  // The pointers must not point into the storage of the other object.
+  candidates = (other.candidates == &other.candidateStorage) ?
+      &candidateStorage : other.candidates;
+  numSamplesMade = (other.numSamplesMade == &other.numSamplesMadeStorage) ?
+      &numSamplesMadeStorage : other.numSamplesMade;
+  streams = (other.streams == &other.streamStorage) ?
+      &streamStorage : other.streams;
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+RASearchRules<SortPolicy, MetricType, TreeType>::
+RASearchRules(RASearchRules&& other) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidateStorage(std::move(other.candidateStorage)),
+    k(other.k),
+    metric(other.metric),
+    sampleAtLeaves(other.sampleAtLeaves),
+    firstLeafExact(other.firstLeafExact),
+    singleSampleLimit(other.singleSampleLimit),
+    numSamplesReqd(other.numSamplesReqd),
+    numSamplesMadeStorage(std::move(other.numSamplesMadeStorage)),
+    streamStorage(std::move(other.streamStorage)),
+    samplingRatio(other.samplingRatio),
+    numDistComputations(other.numDistComputations),
+    sameSet(other.sameSet),
+    traversalInfo(other.traversalInfo)
+{
+  candidates = (other.candidates == &other.candidateStorage) ?
+      &candidateStorage : other.candidates;
+  numSamplesMade = (other.numSamplesMade == &other.numSamplesMadeStorage) ?
+      &numSamplesMadeStorage : other.numSamplesMade;
+  streams = (other.streams == &other.streamStorage) ?
+      &streamStorage : other.streams;
+  other.candidates = &other.candidateStorage;
+  other.numSamplesMade = &other.numSamplesMadeStorage;
+  other.streams = &other.streamStorage;
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+RASearchRules<SortPolicy, MetricType, TreeType>::
+RASearchRules(const RASearchRules& other,
+              std::vector<CandidateList>* sharedCandidates,
+              arma::Col<size_t>* sharedNumSamplesMade,
+              std::vector<math::RandomStream>* sharedStreams) :
+    referenceSet(other.referenceSet),
+    querySet(other.querySet),
+    candidates(sharedCandidates),
+    k(other.k),
+    metric(other.metric),
+    sampleAtLeaves(other.sampleAtLeaves),
+    firstLeafExact(other.firstLeafExact),
+    singleSampleLimit(other.singleSampleLimit),
+    numSamplesReqd(other.numSamplesReqd),
+    numSamplesMade(sharedNumSamplesMade),
+    streams(sharedStreams),
+    samplingRatio(other.samplingRatio),
+    numDistComputations(0),
+    sameSet(other.sameSet),
+    traversalInfo(other.traversalInfo)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+RASearchRules<SortPolicy, MetricType, TreeType>
+RASearchRules<SortPolicy, MetricType, TreeType>::Fork()
+{
+  return RASearchRules(*this, candidates, numSamplesMade, streams);
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void RASearchRules<SortPolicy, MetricType, TreeType>::Merge(
+    const RASearchRules& worker)
+{
+  numDistComputations += worker.numDistComputations;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 void RASearchRules<SortPolicy, MetricType, TreeType>::GetResults(
     arma::Mat<size_t>& neighbors,
@@ -107,7 +231,7 @@ void RASearchRules<SortPolicy, MetricType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; i++)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; j++)
     {
       neighbors(k - j, i) = pqueue.top().second;
@@ -133,7 +257,7 @@ double RASearchRules<SortPolicy, MetricType, TreeType>::BaseCase(
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
 
-  numSamplesMade[queryIndex]++;
+  (*numSamplesMade)[queryIndex]++;
 
   // TO REMOVE
   numDistComputations++;
@@ -149,7 +273,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double distance = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   return Score(queryIndex, referenceNode, distance, bestDistance);
 }
@@ -163,7 +287,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
   const arma::vec queryPoint = querySet.unsafe_col(queryIndex);
   const double distance = SortPolicy::BestPointToNodeDistance(queryPoint,
       &referenceNode, baseCaseResult);
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   return Score(queryIndex, referenceNode, distance, bestDistance);
 }
@@ -179,19 +303,19 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
   // will be something down this node.  Also check if enough samples are already
   // made for this query.
   if (SortPolicy::IsBetter(distance, bestDistance)
-      && numSamplesMade[queryIndex] < numSamplesReqd)
+      && (*numSamplesMade)[queryIndex] < numSamplesReqd)
   {
     // We cannot prune this node; try approximating it by sampling.
 
     // If we are required to visit the first leaf (to find possible duplicates),
     // make sure we do not approximate.
-    if (numSamplesMade[queryIndex] > 0 || !firstLeafExact)
+    if ((*numSamplesMade)[queryIndex] > 0 || !firstLeafExact)
     {
       // Check if this node can be approximated by sampling.
       size_t samplesReqd = (size_t) std::ceil(samplingRatio *
           (double) referenceNode.NumDescendants());
       samplesReqd = std::min(samplesReqd,
-          numSamplesReqd - numSamplesMade[queryIndex]);
+          numSamplesReqd - (*numSamplesMade)[queryIndex]);
 
       if (samplesReqd > singleSampleLimit && !referenceNode.IsLeaf())
       {
@@ -206,7 +330,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           // Hence, approximate the node by sampling enough number of points.
           arma::uvec distinctSamples;
           math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
+              samplesReqd, distinctSamples, (*streams)[queryIndex]);
           for (size_t i = 0; i < distinctSamples.n_elem; i++)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
@@ -222,7 +346,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
             // Approximate node by sampling enough number of points.
             arma::uvec distinctSamples;
             math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
+                samplesReqd, distinctSamples, (*streams)[queryIndex]);
             for (size_t i = 0; i < distinctSamples.n_elem; i++)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
@@ -257,7 +381,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
 
     // If enough samples are already made, this step does not change the result
     // of the search.
-    numSamplesMade[queryIndex] += (size_t) std::floor(
+    (*numSamplesMade)[queryIndex] += (size_t) std::floor(
         samplingRatio * (double) referenceNode.NumDescendants());
 
     return DBL_MAX;
@@ -275,13 +399,13 @@ Rescore(const size_t queryIndex,
     return oldScore;
 
   // Just check the score again against the distances.
-  const double bestDistance = candidates[queryIndex].top().first;
+  const double bestDistance = (*candidates)[queryIndex].top().first;
 
   // If this is better than the best distance we've seen so far,
   // maybe there will be something down this node.
   // Also check if enough samples are already made for this query.
   if (SortPolicy::IsBetter(oldScore, bestDistance)
-      && numSamplesMade[queryIndex] < numSamplesReqd)
+      && (*numSamplesMade)[queryIndex] < numSamplesReqd)
   {
     // We cannot prune this node; thus, we try approximating this node by
     // sampling.
@@ -294,7 +418,7 @@ Rescore(const size_t queryIndex,
     size_t samplesReqd = (size_t) std::ceil(samplingRatio *
         (double) referenceNode.NumDescendants());
     samplesReqd = std::min(samplesReqd, numSamplesReqd -
-        numSamplesMade[queryIndex]);
+        (*numSamplesMade)[queryIndex]);
 
     if (samplesReqd > singleSampleLimit && !referenceNode.IsLeaf())
     {
@@ -310,7 +434,7 @@ Rescore(const size_t queryIndex,
         // by sampling enough number of points.
         arma::uvec distinctSamples;
         math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-            samplesReqd, distinctSamples);
+            samplesReqd, distinctSamples, (*streams)[queryIndex]);
         for (size_t i = 0; i < distinctSamples.n_elem; i++)
           // The counting of the samples are done in the 'BaseCase' function so
           // no book-keeping is required here.
@@ -326,7 +450,7 @@ Rescore(const size_t queryIndex,
           // Approximate node by sampling enough points.
           arma::uvec distinctSamples;
           math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
+              samplesReqd, distinctSamples, (*streams)[queryIndex]);
           for (size_t i = 0; i < distinctSamples.n_elem; i++)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
@@ -351,7 +475,7 @@ Rescore(const size_t queryIndex,
     // Add 'fake' samples from this node; they are fake because the distances to
     // these samples need not be computed.  If enough samples are already made,
     // this step does not change the result of the search.
-    numSamplesMade[queryIndex] += (size_t) std::floor(samplingRatio *
+    (*numSamplesMade)[queryIndex] += (size_t) std::floor(samplingRatio *
         (double) referenceNode.NumDescendants());
 
     return DBL_MAX;
@@ -375,7 +499,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); i++)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -414,7 +538,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
 
   for (size_t i = 0; i < queryNode.NumPoints(); i++)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -513,7 +637,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           {
             const size_t queryIndex = queryNode.Descendant(i);
             math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
+                samplesReqd, distinctSamples, (*streams)[queryIndex]);
             for (size_t j = 0; j < distinctSamples.n_elem; j++)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
@@ -543,7 +667,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
             {
               const size_t queryIndex = queryNode.Descendant(i);
               math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                  samplesReqd, distinctSamples);
+                  samplesReqd, distinctSamples, (*streams)[queryIndex]);
               for (size_t j = 0; j < distinctSamples.n_elem; j++)
                 // The counting of the samples are done in the 'BaseCase'
                 // function so no book-keeping is required here.
@@ -628,7 +752,7 @@ Rescore(TreeType& queryNode,
 
   for (size_t i = 0; i < queryNode.NumPoints(); i++)
   {
-    const double bound = candidates[queryNode.Point(i)].top().first
+    const double bound = (*candidates)[queryNode.Point(i)].top().first
         + maxDescendantDistance;
     if (bound < pointBound)
       pointBound = bound;
@@ -718,7 +842,7 @@ Rescore(TreeType& queryNode,
         {
           const size_t queryIndex = queryNode.Descendant(i);
           math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
+              samplesReqd, distinctSamples, (*streams)[queryIndex]);
           for (size_t j = 0; j < distinctSamples.n_elem; j++)
             // The counting of the samples are done in the 'BaseCase'
             // function so no book-keeping is required here.
@@ -747,7 +871,7 @@ Rescore(TreeType& queryNode,
           {
             const size_t queryIndex = queryNode.Descendant(i);
             math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
+                samplesReqd, distinctSamples, (*streams)[queryIndex]);
             for (size_t j = 0; j < distinctSamples.n_elem; j++)
               // The counting of the samples are done in BaseCase() so no
               // book-keeping is required here.
@@ -813,7 +937,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double distance)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(distance, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
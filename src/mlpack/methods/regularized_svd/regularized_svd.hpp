@@ -18,6 +18,7 @@
 #include <mlpack/methods/cf/cf.hpp>
 
 #include "regularized_svd_function.hpp"
+#include "stratified_sgd.hpp"
 
 namespace mlpack {
 namespace svd {
@@ -53,6 +54,9 @@ namespace svd {
  * // Use the Apply() method to get a factorization.
  * rSVD.Apply(data, rank, u, v);
  * @endcode
+ *
+ * To train on several threads, use StratifiedSGD as the optimizer:
+ * RegularizedSVD<StratifiedSGD>.
  */
 template<
   template<typename...> class OptimizerType = mlpack::optimization::StandardSGD
@@ -104,8 +108,8 @@ namespace mlpack {
 namespace cf {
 
 //! Factorizer traits of Regularized SVD.
-template<>
-class FactorizerTraits<mlpack::svd::RegularizedSVD<> >
+template<template<typename...> class OptimizerType>
+class FactorizerTraits<mlpack::svd::RegularizedSVD<OptimizerType> >
 {
  public:
   //! Data provided to RegularizedSVD need not be cleaned.
@@ -122,6 +122,59 @@ void RegularizedSVDFunction::Gradient(const arma::mat& parameters,
   }
 }
 
+double RegularizedSVDFunction::Evaluate(const arma::mat& parameters,
+                                        const size_t begin,
+                                        const size_t batchSize) const
+{
+  // Gather the user and item columns of the batch, so the predictions of the
+  // whole batch can be computed at once.
+  const size_t end = begin + batchSize - 1;
+  const arma::uvec users = arma::conv_to<arma::uvec>::from(
+      data.submat(0, begin, 0, end));
+  const arma::uvec items = arma::conv_to<arma::uvec>::from(
+      data.submat(1, begin, 1, end)) + numUsers;
+
+  const arma::mat userVecs = parameters.cols(users);
+  const arma::mat itemVecs = parameters.cols(items);
+
+  // Squared prediction errors and regularization penalties of the batch.
+  const arma::rowvec ratingErrors = data.submat(2, begin, 2, end) -
+      arma::sum(userVecs % itemVecs, 0);
+
+  return arma::accu(arma::square(ratingErrors)) + lambda *
+      (arma::accu(arma::square(userVecs)) + arma::accu(arma::square(itemVecs)));
+}
+
+void RegularizedSVDFunction::Gradient(const arma::mat& parameters,
+                                      const size_t begin,
+                                      const size_t batchSize,
+                                      arma::mat& gradient) const
+{
+  const size_t end = begin + batchSize - 1;
+  const arma::uvec users = arma::conv_to<arma::uvec>::from(
+      data.submat(0, begin, 0, end));
+  const arma::uvec items = arma::conv_to<arma::uvec>::from(
+      data.submat(1, begin, 1, end)) + numUsers;
+
+  const arma::mat userVecs = parameters.cols(users);
+  const arma::mat itemVecs = parameters.cols(items);
+
+  // Prediction errors of the whole batch.
+  const arma::rowvec ratingErrors = data.submat(2, begin, 2, end) -
+      arma::sum(userVecs % itemVecs, 0);
+
+  // The gradient is non-zero only for the parameter columns of the users and
+  // items in the batch; scatter the contribution of each example.
+  gradient.zeros(rank, numUsers + numItems);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    gradient.col(users[i]) += 2 * (lambda * userVecs.col(i) -
+                                   ratingErrors[i] * itemVecs.col(i));
+    gradient.col(items[i]) += 2 * (lambda * itemVecs.col(i) -
+                                   ratingErrors[i] * userVecs.col(i));
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -144,7 +197,7 @@ double StandardSGD<mlpack::svd::RegularizedSVDFunction>::Optimize(
   for(size_t i = 0; i < numFunctions; i++)
     overallObjective += function.Evaluate(parameters, i);
 
-  const arma::mat data = function.Dataset();
+  const arma::mat& data = function.Dataset();
 
   // Now iterate!
   for(size_t i = 1; i != maxIterations; i++, currentFunction++)
@@ -63,6 +63,33 @@ class RegularizedSVDFunction
   void Gradient(const arma::mat& parameters,
                 arma::mat& gradient) const;
 
+  /**
+   * Evaluates the cost function for the training examples begin, ...,
+   * begin + batchSize - 1.  Useful for the mini-batch SGD optimizer.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param begin Index of the first training example of the batch.
+   * @param batchSize Number of training examples in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
+  /**
+   * Evaluates the gradient of the cost function for the training examples
+   * begin, ..., begin + batchSize - 1.  Useful for the mini-batch SGD
+   * optimizer.
+   *
+   * @param parameters Parameters(user/item matrices) of the decomposition.
+   * @param begin Index of the first training example of the batch.
+   * @param batchSize Number of training examples in the batch.
+   * @param gradient Calculated gradient for the parameters.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                const size_t batchSize,
+                arma::mat& gradient) const;
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
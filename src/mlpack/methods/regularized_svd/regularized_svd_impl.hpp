@@ -35,8 +35,8 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
 {
   // Make the optimizer object using a RegularizedSVDFunction object.
   RegularizedSVDFunction rSVDFunc(data, rank, lambda);
-  mlpack::optimization::StandardSGD<RegularizedSVDFunction> optimizer(
-      rSVDFunc, alpha, iterations * data.n_cols);
+  OptimizerType<RegularizedSVDFunction> optimizer(rSVDFunc, alpha,
+      iterations * data.n_cols);
 
   // Get optimized parameters.
   arma::mat parameters = rSVDFunc.GetInitialPoint();
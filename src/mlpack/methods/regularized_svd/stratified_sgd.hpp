@@ -0,0 +1,129 @@
+/**
+ * @file stratified_sgd.hpp
+ *
+ * Parallel stratified SGD for the regularized SVD objective.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "regularized_svd_function.hpp"
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * Stratified stochastic gradient descent for matrix factorization, which
+ * performs the same updates as the specialization of StandardSGD for
+ * RegularizedSVDFunction, but on several threads at once.  The users and the
+ * items are each split into p contiguous ranges, which splits the ratings into
+ * p x p blocks.  Each epoch is made of p sub-epochs; in sub-epoch s, thread b
+ * processes block (b, (b + s) mod p), so no two threads ever touch the same
+ * user or item factors and no locking is needed.  Within a block, the ratings
+ * are visited sorted by user and then by item, so consecutive updates reuse
+ * the same factor columns.  For more information, see
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title={Large-scale matrix factorization with distributed stochastic
+ *       gradient descent},
+ *   author={Gemulla, R. and Nijkamp, E. and Haas, P.J. and Sismanis, Y.},
+ *   booktitle={Proceedings of the 17th ACM SIGKDD International Conference
+ *       on Knowledge Discovery and Data Mining},
+ *   pages={69--77},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * The order of the sub-epochs is shuffled in every epoch.  For a fixed number
+ * of strata the result does not depend on the number of threads.
+ *
+ * The FunctionType must provide the same interface as RegularizedSVDFunction:
+ * Dataset(), NumUsers(), NumItems(), Lambda(), NumFunctions() and
+ * Evaluate(parameters).
+ *
+ * @tparam FunctionType Matrix factorization objective to optimize.
+ */
+template<typename FunctionType = RegularizedSVDFunction>
+class StratifiedSGD
+{
+ public:
+  /**
+   * Construct the optimizer.  The constructor arguments match those of
+   * StandardSGD, so this can be used as the optimizer of RegularizedSVD.
+   *
+   * @param function Function to be optimized.
+   * @param stepSize Step size for each update.
+   * @param maxIterations Number of individual updates; this is rounded up to a
+   *     whole number of epochs (passes over all ratings).
+   * @param numStrata Number of user and item ranges (0 uses the number of
+   *     OpenMP threads).
+   */
+  StratifiedSGD(FunctionType& function,
+                const double stepSize = 0.01,
+                const size_t maxIterations = 100000,
+                const size_t numStrata = 0);
+
+  /**
+   * Optimize the given function, starting at the given parameters.  The final
+   * parameters are stored in the given matrix, and the final objective is
+   * returned.
+   *
+   * @param parameters Starting point (will be modified).
+   * @return Objective value of the final point.
+   */
+  double Optimize(arma::mat& parameters);
+
+  //! Get the instantiated function to be optimized.
+  const FunctionType& Function() const { return function; }
+  //! Modify the instantiated function.
+  FunctionType& Function() { return function; }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the maximum number of updates (0 indicates a single epoch).
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the maximum number of updates (0 indicates a single epoch).
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of strata (0 uses the number of OpenMP threads).
+  size_t NumStrata() const { return numStrata; }
+  //! Modify the number of strata (0 uses the number of OpenMP threads).
+  size_t& NumStrata() { return numStrata; }
+
+ private:
+  /**
+   * Sort the ratings into the p x p blocks, by user and then item within each
+   * block.  Block (u, i) holds the ratings order[blockStart[u * p + i]] to
+   * order[blockStart[u * p + i + 1] - 1].
+   */
+  void Stratify(const size_t strata,
+                arma::uvec& order,
+                std::vector<size_t>& blockStart) const;
+
+  //! The instantiated function.
+  FunctionType& function;
+  //! The step size for each update.
+  double stepSize;
+  //! The maximum number of updates.
+  size_t maxIterations;
+  //! The number of user and item ranges.
+  size_t numStrata;
+};
+
+} // namespace svd
+} // namespace mlpack
+
+// Include implementation.
+#include "stratified_sgd_impl.hpp"
+
+#endif
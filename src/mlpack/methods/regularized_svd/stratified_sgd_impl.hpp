@@ -0,0 +1,156 @@
+/**
+ * @file stratified_sgd_impl.hpp
+ *
+ * Implementation of parallel stratified SGD for the regularized SVD objective.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_IMPL_HPP
+#define MLPACK_METHODS_REGULARIZED_SVD_STRATIFIED_SGD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "stratified_sgd.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace svd {
+
+template<typename FunctionType>
+StratifiedSGD<FunctionType>::StratifiedSGD(FunctionType& function,
+                                           const double stepSize,
+                                           const size_t maxIterations,
+                                           const size_t numStrata) :
+    function(function),
+    stepSize(stepSize),
+    maxIterations(maxIterations),
+    numStrata(numStrata)
+{ /* Nothing to do. */ }
+
+template<typename FunctionType>
+double StratifiedSGD<FunctionType>::Optimize(arma::mat& parameters)
+{
+  const arma::mat& data = function.Dataset();
+  const size_t numFunctions = function.NumFunctions();
+  const size_t numUsers = function.NumUsers();
+  const size_t numItems = function.NumItems();
+  const double lambda = function.Lambda();
+
+  // There can't be more strata than users or items.
+  size_t strata = numStrata;
+  if (strata == 0)
+  {
+#ifdef HAS_OPENMP
+    strata = omp_get_max_threads();
+#else
+    strata = 1;
+#endif
+  }
+  strata = std::max(std::min(strata, std::min(numUsers, numItems)),
+      (size_t) 1);
+
+  arma::uvec order;
+  std::vector<size_t> blockStart;
+  Stratify(strata, order, blockStart);
+
+  // Round the number of updates up to whole epochs.
+  const size_t numEpochs = (maxIterations == 0) ? 1 :
+      (maxIterations + numFunctions - 1) / numFunctions;
+
+  arma::uvec shifts = arma::linspace<arma::uvec>(0, strata - 1, strata);
+  for (size_t epoch = 0; epoch < numEpochs; ++epoch)
+  {
+    // Visit the sub-epochs in a different order every epoch.
+    shifts = arma::shuffle(shifts);
+
+    for (size_t s = 0; s < strata; ++s)
+    {
+      // The blocks of a sub-epoch share no users or items, so each can be
+      // updated by its own thread.  Visual Studio only implements OpenMP 2.0,
+      // which doesn't support unsigned loop variables.
+      #pragma omp parallel for schedule(dynamic)
+      for (intmax_t b = 0; b < (intmax_t) strata; ++b)
+      {
+        const size_t block = b * strata + (b + shifts[s]) % strata;
+        for (size_t k = blockStart[block]; k < blockStart[block + 1]; ++k)
+        {
+          const size_t i = order[k];
+
+          // Indices for accessing the correct parameter columns.
+          const size_t user = data(0, i);
+          const size_t item = data(1, i) + numUsers;
+
+          // Prediction error for the example.
+          const double ratingError = data(2, i) -
+              arma::dot(parameters.col(user), parameters.col(item));
+
+          // Gradient is non-zero only for the parameter columns corresponding
+          // to the example.
+          parameters.col(user) -= stepSize * (lambda * parameters.col(user) -
+              ratingError * parameters.col(item));
+          parameters.col(item) -= stepSize * (lambda * parameters.col(item) -
+              ratingError * parameters.col(user));
+        }
+      }
+    }
+  }
+
+  return function.Evaluate(parameters);
+}
+
+template<typename FunctionType>
+void StratifiedSGD<FunctionType>::Stratify(
+    const size_t strata,
+    arma::uvec& order,
+    std::vector<size_t>& blockStart) const
+{
+  const arma::mat& data = function.Dataset();
+  const size_t numUsers = function.NumUsers();
+  const size_t numItems = function.NumItems();
+
+  // Find the block of each rating.
+  std::vector<size_t> blocks(data.n_cols);
+  blockStart.assign(strata * strata + 1, 0);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i);
+    blocks[i] = (user * strata / numUsers) * strata + item * strata / numItems;
+    ++blockStart[blocks[i] + 1];
+  }
+
+  for (size_t b = 1; b < blockStart.size(); ++b)
+    blockStart[b] += blockStart[b - 1];
+
+  // Sort by block, then user, then item, so that each block is contiguous and
+  // consecutive updates reuse the same factor columns.
+  std::vector<size_t> indices(data.n_cols);
+  for (size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+
+  std::sort(indices.begin(), indices.end(),
+      [&](const size_t a, const size_t b)
+      {
+        if (blocks[a] != blocks[b])
+          return blocks[a] < blocks[b];
+        if (data(0, a) != data(0, b))
+          return data(0, a) < data(0, b);
+        if (data(1, a) != data(1, b))
+          return data(1, a) < data(1, b);
+        return a < b;
+      });
+
+  order.set_size(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+    order[i] = indices[i];
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
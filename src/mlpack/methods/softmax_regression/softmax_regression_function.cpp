@@ -109,6 +109,15 @@ void SoftmaxRegressionFunction::GetGroundTruthMatrix(const arma::Row<size_t>& la
 void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     const arma::mat& parameters,
     arma::mat& probabilities) const
+{
+  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+}
+
+void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
+    const arma::mat& parameters,
+    arma::mat& probabilities,
+    const size_t begin,
+    const size_t batchSize) const
 {
   arma::mat hypothesis;
 
@@ -120,12 +129,14 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     //
     // Since the cost of join maybe high due to the copy of original data,
     // split the hypothesis computation to two components.
-    hypothesis = arma::exp(arma::repmat(parameters.col(0), 1, data.n_cols) +
-                           parameters.cols(1, parameters.n_cols - 1) * data);
+    hypothesis = arma::exp(arma::repmat(parameters.col(0), 1, batchSize) +
+        parameters.cols(1, parameters.n_cols - 1) *
+        data.cols(begin, begin + batchSize - 1));
   }
   else
   {
-    hypothesis = arma::exp(parameters * data);
+    hypothesis = arma::exp(parameters *
+        data.cols(begin, begin + batchSize - 1));
   }
 
   probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
@@ -205,3 +216,57 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
                lambda * parameters;
   }
 }
+
+/**
+ * Evaluates the objective function over a batch of points.
+ */
+double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
+                                           const size_t begin,
+                                           const size_t batchSize) const
+{
+  arma::mat probabilities;
+  GetProbabilitiesMatrix(parameters, probabilities, begin, batchSize);
+
+  // The log likelihood and the regularization are both split evenly over all
+  // points.
+  const arma::sp_mat batchGroundTruth = groundTruth.cols(begin,
+      begin + batchSize - 1);
+  const double logLikelihood = arma::accu(batchGroundTruth %
+      arma::log(probabilities)) / data.n_cols;
+  const double weightDecay = 0.5 * lambda * arma::accu(parameters %
+      parameters) * batchSize / data.n_cols;
+
+  return -logLikelihood + weightDecay;
+}
+
+/**
+ * Calculates the gradient of the objective function over a batch of points.
+ */
+void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
+                                         const size_t begin,
+                                         const size_t batchSize,
+                                         arma::mat& gradient) const
+{
+  arma::mat probabilities;
+  GetProbabilitiesMatrix(parameters, probabilities, begin, batchSize);
+
+  const size_t end = begin + batchSize - 1;
+  const arma::sp_mat batchGroundTruth = groundTruth.cols(begin, end);
+  const double regularization = lambda * batchSize / data.n_cols;
+
+  gradient.set_size(parameters.n_rows, parameters.n_cols);
+  if (fitIntercept)
+  {
+    const arma::mat inner = probabilities - batchGroundTruth;
+    gradient.col(0) = arma::sum(inner, 1) / data.n_cols +
+        regularization * parameters.col(0);
+    gradient.cols(1, parameters.n_cols - 1) =
+        inner * data.cols(begin, end).t() / data.n_cols +
+        regularization * parameters.cols(1, parameters.n_cols - 1);
+  }
+  else
+  {
+    gradient = (probabilities - batchGroundTruth) * data.cols(begin, end).t() /
+        data.n_cols + regularization * parameters;
+  }
+}
@@ -89,6 +89,20 @@ class SoftmaxRegressionFunction
   void GetProbabilitiesMatrix(const arma::mat& parameters,
                               arma::mat& probabilities) const;
 
+  /**
+   * Evaluate the probabilities matrix with the passed parameters, for the
+   * points begin, ..., begin + batchSize - 1 only.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param probabilities Pointer to arma::mat which stores the probabilities.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  void GetProbabilitiesMatrix(const arma::mat& parameters,
+                              arma::mat& probabilities,
+                              const size_t begin,
+                              const size_t batchSize) const;
+
   /**
    * Evaluates the objective function of the softmax regression model using the
    * given parameters. The cost function has terms for the log likelihood error
@@ -111,6 +125,38 @@ class SoftmaxRegressionFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluates the objective function over the points begin, ...,
+   * begin + batchSize - 1.  The objective is split evenly over the points, so
+   * the sum over all batches is equal to Evaluate(parameters).  This is used
+   * by MiniBatchSGD.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize) const;
+
+  /**
+   * Evaluates the gradient of the objective function over the points begin,
+   * ..., begin + batchSize - 1.  The sum over all batches is equal to
+   * Gradient(parameters, gradient).  This is used by MiniBatchSGD.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   * @param gradient Matrix where gradient values will be stored.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                const size_t batchSize,
+                arma::mat& gradient) const;
+
+  //! Return the number of separable functions (the number of points).
+  size_t NumFunctions() const { return data.n_cols; }
+
   //! Return the initial point for the optimization.
   const arma::mat& GetInitialPoint() const { return initialPoint; }
 
@@ -778,6 +778,64 @@ BOOST_AUTO_TEST_CASE(GradientLSTMLayerTest)
   BOOST_REQUIRE_LE(CheckGradient(function), 1e-4);
 }
 
+/**
+ * LSTM layer numerically gradient test with several input dimensions and
+ * several sequences, so that the gates of every time step are computed from a
+ * multi-dimensional input, and the per-timestep buffers are reused between
+ * sequences.
+ */
+BOOST_AUTO_TEST_CASE(GradientLSTMLayerSequencesTest)
+{
+  // LSTM function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction()
+    {
+      const size_t rho = 4;
+      input = arma::randu(3 * rho, 3);
+      target = arma::mat("1 2 2; 2 1 2; 2 2 1; 1 1 2");
+
+      model = new RNN<NegativeLogLikelihood<> >(input, target, rho);
+      model->Add<IdentityLayer<> >();
+      model->Add<Linear<> >(3, 5);
+      model->Add<LSTM<> >(5, 4, rho);
+      model->Add<Linear<> >(4, 2);
+      model->Add<LogSoftMax<> >();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      // Sum the error and the gradient over all of the sequences.
+      double error = 0;
+      arma::mat sequenceGradient;
+      for (size_t i = 0; i < input.n_cols; ++i)
+      {
+        error += model->Evaluate(model->Parameters(), i);
+        model->Gradient(model->Parameters(), i, sequenceGradient);
+
+        if (i == 0)
+          gradient = sequenceGradient;
+        else
+          gradient += sequenceGradient;
+      }
+
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    RNN<NegativeLogLikelihood<> >* model;
+    arma::mat input, target;
+  } function;
+
+  BOOST_REQUIRE_LE(CheckGradient(function), 1e-4);
+}
+
 /**
  * Simple concat module test.
  */
@@ -912,10 +970,10 @@ BOOST_AUTO_TEST_CASE(SimpleLogSoftmaxLayerTest)
   LogSoftMax<> module;
 
   // Test the Forward function.
-  input = arma::mat("0.5 0.5");
+  input = arma::mat("0.5; 0.5");
   module.Forward(std::move(input), std::move(output));
   BOOST_REQUIRE_SMALL(arma::accu(arma::abs(
-    arma::mat("-0.6931 -0.6931") - output)), 1e-3);
+    arma::mat("-0.6931; -0.6931") - output)), 1e-3);
 
   // Test the Backward function.
   error = arma::zeros(input.n_rows, input.n_cols);
@@ -324,6 +324,74 @@ BOOST_AUTO_TEST_CASE(CFBatchPredictTest)
   }
 }
 
+/**
+ * Make sure that the recommendations for a user are the unrated items with the
+ * highest predicted ratings, in descending order.
+ */
+BOOST_AUTO_TEST_CASE(CFRecommendationsAreTopPredictionsTest)
+{
+  arma::mat dataset;
+  data::Load("GroupLens100k.csv", dataset);
+
+  arma::sp_mat cleanedData;
+  CF::CleanData(dataset, cleanedData);
+
+  CF c(cleanedData);
+
+  const size_t numRecs = 10;
+  arma::Col<size_t> users("3 150 600");
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations, users);
+
+  // Predict the rating of every item for each of the users.
+  const size_t numItems = cleanedData.n_rows;
+  arma::Mat<size_t> combinations(2, numItems * users.n_elem);
+  for (size_t u = 0; u < users.n_elem; ++u)
+  {
+    for (size_t i = 0; i < numItems; ++i)
+    {
+      combinations(0, u * numItems + i) = users[u];
+      combinations(1, u * numItems + i) = i;
+    }
+  }
+
+  arma::vec predictions;
+  c.Predict(combinations, predictions);
+
+  for (size_t u = 0; u < users.n_elem; ++u)
+  {
+    const arma::vec userPredictions = predictions.subvec(u * numItems,
+        (u + 1) * numItems - 1);
+
+    // Recommendations should be unrated and in descending order.
+    for (size_t r = 0; r < numRecs; ++r)
+    {
+      BOOST_REQUIRE_EQUAL((double) cleanedData(recommendations(r, u), users[u]),
+          0.0);
+      if (r > 0)
+        BOOST_REQUIRE_GE(userPredictions[recommendations(r - 1, u)] + 1e-10,
+            userPredictions[recommendations(r, u)]);
+    }
+
+    // No other unrated item should be predicted higher than the last
+    // recommendation.
+    const double threshold = userPredictions[recommendations(numRecs - 1, u)];
+    for (size_t i = 0; i < numItems; ++i)
+    {
+      if (cleanedData(i, users[u]) != 0.0)
+        continue;
+
+      bool recommended = false;
+      for (size_t r = 0; r < numRecs; ++r)
+        if (recommendations(r, u) == i)
+          recommended = true;
+
+      if (!recommended)
+        BOOST_REQUIRE_LE(userPredictions[i], threshold + 1e-10);
+    }
+  }
+}
+
 /**
  * Make sure we can train an already-trained model and it works okay.
  */
@@ -222,4 +222,37 @@ BOOST_AUTO_TEST_CASE(CosineTreeModifiedGramSchmidt)
   }
 }
 
+/**
+ * Checks CosineTree::BlockGramSchmidt() by orthonormalizing a block of random
+ * vectors against a random orthonormal basis.
+ */
+BOOST_AUTO_TEST_CASE(CosineTreeBlockGramSchmidt)
+{
+  arma::mat data = arma::randu(100, 50);
+  CosineTree dummyTree(data, 1, 0.1);
+
+  arma::mat basis, r;
+  arma::qr_econ(basis, r, arma::randn<arma::mat>(100, 20));
+
+  arma::mat vectors = arma::randn<arma::mat>(100, 5);
+  dummyTree.BlockGramSchmidt(basis, vectors);
+
+  // The new vectors should be orthogonal to the basis and orthonormal among
+  // themselves.
+  const arma::mat basisProducts = basis.t() * vectors;
+  const arma::mat vectorProducts = vectors.t() * vectors;
+  for (size_t i = 0; i < basisProducts.n_elem; ++i)
+    BOOST_REQUIRE_SMALL(basisProducts[i], 1e-10);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      if (i == j)
+        BOOST_REQUIRE_CLOSE(vectorProducts(i, j), 1.0, 1e-8);
+      else
+        BOOST_REQUIRE_SMALL(vectorProducts(i, j), 1e-10);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
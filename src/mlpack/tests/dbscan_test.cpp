@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/dbscan/dbscan.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -146,4 +147,131 @@ BOOST_AUTO_TEST_CASE(GaussiansTest)
   }
 }
 
+/**
+ * Check that batch mode follows the definition of DBSCAN clusters: neighboring
+ * core points are in the same cluster, border points are in the cluster of one
+ * of their core neighbors, and all other points are noise.  The clusters of
+ * the core points must not depend on the batch size.
+ */
+BOOST_AUTO_TEST_CASE(BatchModeTest)
+{
+  arma::mat points(2, 400);
+
+  GaussianDistribution g1(2), g2(2), g3(2);
+  g1.Mean() = arma::vec("0.0 0.0");
+  g2.Mean() = arma::vec("6.0 6.0");
+  g3.Mean() = arma::vec("-6.0 1.0");
+  for (size_t i = 0; i < 100; ++i)
+    points.col(i) = g1.Random();
+  for (size_t i = 100; i < 200; ++i)
+    points.col(i) = g2.Random();
+  for (size_t i = 200; i < 300; ++i)
+    points.col(i) = g3.Random();
+  points.cols(300, 399) = 20.0 * arma::randu<arma::mat>(2, 100) - 10.0;
+
+  const double epsilon = 0.6;
+  const size_t minPoints = 5;
+
+  // Find the neighbors of each point by brute force.
+  std::vector<std::vector<size_t>> neighbors(points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    for (size_t j = 0; j < points.n_cols; ++j)
+      if (arma::norm(points.col(i) - points.col(j)) <= epsilon)
+        neighbors[i].push_back(j);
+
+  arma::Row<size_t> baseline;
+  const size_t batchSizes[] = { 1, 37, 1000 };
+  for (size_t b = 0; b < 3; ++b)
+  {
+    DBSCAN<> d(epsilon, minPoints, range::RangeSearch<>(),
+        RandomPointSelection(), batchSizes[b]);
+
+    arma::Row<size_t> assignments;
+    const size_t clusters = d.Cluster(points, assignments);
+    BOOST_REQUIRE_EQUAL(assignments.n_elem, points.n_cols);
+
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      if (neighbors[i].size() >= minPoints)
+      {
+        BOOST_REQUIRE_LT(assignments[i], clusters);
+        for (size_t j = 0; j < neighbors[i].size(); ++j)
+        {
+          if (neighbors[neighbors[i][j]].size() >= minPoints)
+            BOOST_REQUIRE_EQUAL(assignments[i], assignments[neighbors[i][j]]);
+        }
+      }
+      else
+      {
+        bool hasCoreNeighbor = false;
+        bool matchesCoreNeighbor = false;
+        for (size_t j = 0; j < neighbors[i].size(); ++j)
+        {
+          if (neighbors[neighbors[i][j]].size() >= minPoints)
+          {
+            hasCoreNeighbor = true;
+            if (assignments[neighbors[i][j]] == assignments[i])
+              matchesCoreNeighbor = true;
+          }
+        }
+
+        if (hasCoreNeighbor)
+          BOOST_REQUIRE(matchesCoreNeighbor);
+        else
+          BOOST_REQUIRE_EQUAL(assignments[i], SIZE_MAX);
+      }
+    }
+
+    if (b == 0)
+    {
+      baseline = assignments;
+    }
+    else
+    {
+      for (size_t i = 0; i < points.n_cols; ++i)
+        if (neighbors[i].size() >= minPoints)
+          BOOST_REQUIRE_EQUAL(assignments[i], baseline[i]);
+    }
+  }
+}
+
+/**
+ * Single-tree range search with the cover tree can't be run by several threads
+ * at once, so batch mode has to search with one thread; it should still find
+ * the same clusters and noise as batch mode with the default range search.
+ */
+BOOST_AUTO_TEST_CASE(BatchModeSingleCoverTreeTest)
+{
+  arma::mat points(2, 300);
+
+  GaussianDistribution g1(2), g2(2);
+  g1.Mean() = arma::vec("0.0 0.0");
+  g2.Mean() = arma::vec("6.0 6.0");
+  for (size_t i = 0; i < 100; ++i)
+    points.col(i) = g1.Random();
+  for (size_t i = 100; i < 200; ++i)
+    points.col(i) = g2.Random();
+  points.cols(200, 299) = 20.0 * arma::randu<arma::mat>(2, 100) - 10.0;
+
+  typedef range::RangeSearch<metric::EuclideanDistance, arma::mat,
+      tree::StandardCoverTree> CoverTreeRangeSearch;
+
+  DBSCAN<> d(0.6, 5, range::RangeSearch<>(), RandomPointSelection(), 37);
+  DBSCAN<CoverTreeRangeSearch> coverTreeD(0.6, 5,
+      CoverTreeRangeSearch(false, true), RandomPointSelection(), 37);
+
+  arma::Row<size_t> assignments, coverTreeAssignments;
+  const size_t clusters = d.Cluster(points, assignments);
+  const size_t coverTreeClusters = coverTreeD.Cluster(points,
+      coverTreeAssignments);
+
+  BOOST_REQUIRE_EQUAL(coverTreeClusters, clusters);
+  BOOST_REQUIRE_EQUAL(coverTreeAssignments.n_elem, points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(coverTreeAssignments[i] == SIZE_MAX,
+        assignments[i] == SIZE_MAX);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -772,4 +772,101 @@ BOOST_AUTO_TEST_CASE(MoveOperatorTest)
   BOOST_REQUIRE_CLOSE(testDTree2.Right()->SplitValue(), 0.5, 1e-5);
 }
 
+#ifndef _WIN32
+// Make sure that growing a tree on the indices of some of the points of a
+// dataset gives the same tree as sorting the points of each node of a copy of
+// those points and splitting it in place.
+BOOST_AUTO_TEST_CASE(GrowOnPointsTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 5000);
+
+  // Use all points but a block in the middle, like a cross-validation fold.
+  arma::Col<size_t> points(4000);
+  for (size_t i = 0; i < 1000; ++i)
+    points[i] = i;
+  for (size_t i = 2000; i < 5000; ++i)
+    points[i - 1000] = i;
+
+  arma::mat subset(4, 4000);
+  for (size_t i = 0; i < points.n_elem; ++i)
+    subset.col(i) = dataset.col(points[i]);
+
+  arma::Col<size_t> oldFromNew(4000);
+  for (size_t i = 0; i < oldFromNew.n_elem; ++i)
+    oldFromNew[i] = i;
+
+  DTree<arma::mat> tree(subset);
+  DTree<arma::mat> inPlaceTree(subset);
+  const double alpha = tree.GrowOnPoints(dataset, points, false, 10, 5);
+  const double inPlaceAlpha = inPlaceTree.GrowNode(subset, oldFromNew, false,
+      10, 5);
+
+  BOOST_REQUIRE_CLOSE(alpha, inPlaceAlpha, 1e-10);
+
+  // The points must have been reordered in the same way.
+  for (size_t i = 0; i < points.n_elem; ++i)
+  {
+    const size_t original = (oldFromNew[i] < 1000) ? oldFromNew[i] :
+        oldFromNew[i] + 1000;
+    BOOST_REQUIRE_EQUAL(points[i], original);
+  }
+
+  // Now compare the structure of the trees.
+  std::stack<std::pair<DTree<arma::mat>*, DTree<arma::mat>*>> stack;
+  stack.push(std::make_pair(&tree, &inPlaceTree));
+  while (!stack.empty())
+  {
+    DTree<arma::mat>* node = stack.top().first;
+    DTree<arma::mat>* inPlaceNode = stack.top().second;
+    stack.pop();
+
+    BOOST_REQUIRE_EQUAL(node->Start(), inPlaceNode->Start());
+    BOOST_REQUIRE_EQUAL(node->End(), inPlaceNode->End());
+    BOOST_REQUIRE_EQUAL(node->SubtreeLeaves(), inPlaceNode->SubtreeLeaves());
+    BOOST_REQUIRE_CLOSE(node->LogNegError(), inPlaceNode->LogNegError(),
+        1e-10);
+
+    if (node->SubtreeLeaves() > 1)
+    {
+      BOOST_REQUIRE_EQUAL(node->SplitDim(), inPlaceNode->SplitDim());
+      BOOST_REQUIRE_EQUAL(node->SplitValue(), inPlaceNode->SplitValue());
+
+      stack.push(std::make_pair(node->Left(), inPlaceNode->Left()));
+      stack.push(std::make_pair(node->Right(), inPlaceNode->Right()));
+    }
+  }
+}
+
+// Make sure that growing a tree on the indices of some of the points of a
+// sparse dataset gives the same tree as growing it on a copy of those points.
+BOOST_AUTO_TEST_CASE(SparseGrowOnPointsTest)
+{
+  arma::sp_mat dataset = arma::sprandu<arma::sp_mat>(4, 3000, 0.3);
+
+  // Use every other point.
+  arma::Col<size_t> points(1500);
+  for (size_t i = 0; i < points.n_elem; ++i)
+    points[i] = 2 * i + 1;
+
+  arma::sp_mat subset(4, 1500);
+  for (size_t i = 0; i < points.n_elem; ++i)
+    subset.col(i) = dataset.col(points[i]);
+
+  arma::Col<size_t> oldFromNew(1500);
+  for (size_t i = 0; i < oldFromNew.n_elem; ++i)
+    oldFromNew[i] = i;
+
+  DTree<arma::sp_mat> tree(subset);
+  DTree<arma::sp_mat> inPlaceTree(subset);
+  const double alpha = tree.GrowOnPoints(dataset, points, false, 10, 5);
+  const double inPlaceAlpha = inPlaceTree.Grow(subset, oldFromNew, false, 10,
+      5);
+
+  BOOST_REQUIRE_CLOSE(alpha, inPlaceAlpha, 1e-10);
+  BOOST_REQUIRE_EQUAL(tree.SubtreeLeaves(), inPlaceTree.SubtreeLeaves());
+  for (size_t i = 0; i < points.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(points[i], 2 * oldFromNew[i] + 1);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END();
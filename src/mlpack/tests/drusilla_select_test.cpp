@@ -76,6 +76,40 @@ BOOST_AUTO_TEST_CASE(DrusillaSelectExhaustiveExactTest)
   }
 }
 
+// The query points are searched in blocks; make sure the results match a
+// brute-force search of the candidate set when there are several blocks.
+BOOST_AUTO_TEST_CASE(DrusillaSelectBlocksTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 600);
+
+  DrusillaSelect<> ds(dataset, 5, 10);
+
+  arma::mat distances;
+  arma::Mat<size_t> neighbors;
+  ds.Search(dataset, 3, neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, 600);
+  BOOST_REQUIRE_EQUAL(distances.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(distances.n_cols, 600);
+
+  for (size_t q = 0; q < dataset.n_cols; ++q)
+  {
+    arma::vec candidateDistances(ds.CandidateSet().n_cols);
+    for (size_t c = 0; c < candidateDistances.n_elem; ++c)
+      candidateDistances[c] = metric::EuclideanDistance::Evaluate(
+          dataset.col(q), ds.CandidateSet().col(c));
+    candidateDistances = arma::sort(candidateDistances, "descend");
+
+    for (size_t j = 0; j < 3; ++j)
+    {
+      BOOST_REQUIRE_CLOSE(distances(j, q), candidateDistances[j], 1e-5);
+      BOOST_REQUIRE_CLOSE(distances(j, q), metric::EuclideanDistance::Evaluate(
+          dataset.col(q), dataset.col(neighbors(j, q))), 1e-5);
+    }
+  }
+}
+
 // Test that we can call Train() after calling the constructor.
 BOOST_AUTO_TEST_CASE(RetrainTest)
 {
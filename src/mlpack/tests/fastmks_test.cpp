@@ -206,6 +206,47 @@ BOOST_AUTO_TEST_CASE(SparsePolynomialFastMKSTest)
   }
 }
 
+// Make sure that a kernel value found in the cache is reused, and that the
+// reference point is not inserted into the results a second time.
+BOOST_AUTO_TEST_CASE(KernelCacheTest)
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 100);
+  arma::mat querySet = arma::randu<arma::mat>(5, 10);
+  LinearKernel lk;
+
+  typedef FastMKSRules<LinearKernel, FastMKS<LinearKernel>::Tree> RuleType;
+  RuleType rules(referenceSet, querySet, 3, lk);
+
+  const double kernel = rules.BaseCase(3, 7);
+  rules.BaseCase(3, 8);
+  BOOST_REQUIRE_EQUAL(rules.BaseCase(3, 7), kernel);
+
+  BOOST_REQUIRE_EQUAL(rules.BaseCases(), 2);
+  BOOST_REQUIRE_EQUAL(rules.CacheHits(), 1);
+
+  arma::Mat<size_t> indices;
+  arma::mat kernels;
+  rules.GetResults(indices, kernels);
+
+  // Only two of the three candidates of the query point were found.
+  BOOST_REQUIRE_EQUAL(indices(2, 3), size_t() - 1);
+  BOOST_REQUIRE((indices(0, 3) == 7 && indices(1, 3) == 8) ||
+                (indices(0, 3) == 8 && indices(1, 3) == 7));
+
+  // The cache only holds the kernel values of the current query point, so the
+  // same reference point is evaluated again for another query point, and the
+  // values of the first query point are gone after that.  GetResults() empties
+  // the candidate lists, so this needs new rules.
+  RuleType newRules(referenceSet, querySet, 3, lk);
+  newRules.BaseCase(3, 7);
+  newRules.BaseCase(4, 7);
+  BOOST_REQUIRE_EQUAL(newRules.BaseCases(), 2);
+  BOOST_REQUIRE_EQUAL(newRules.CacheHits(), 0);
+  BOOST_REQUIRE_EQUAL(newRules.BaseCase(3, 7), kernel);
+  BOOST_REQUIRE_EQUAL(newRules.BaseCases(), 3);
+  BOOST_REQUIRE_EQUAL(newRules.CacheHits(), 0);
+}
+
 // Make sure the empty constructor works.
 BOOST_AUTO_TEST_CASE(EmptyConstructorTest)
 {
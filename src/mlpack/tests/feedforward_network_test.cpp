@@ -410,4 +410,93 @@ BOOST_AUTO_TEST_CASE(DropConnectNetworkTest)
       (dataset, labels, dataset, labels, 2, 10, 50, 0.2);
 }
 
+/**
+ * Check that the batch Evaluate() and Gradient() overloads of the given network
+ * give the sum of the objective and of the gradient over the points of the
+ * batch.
+ */
+template<typename ModelType>
+void CheckBatchEvaluation(ModelType& model)
+{
+  // Initialize the parameters.
+  model.Evaluate(model.Parameters(), 0);
+
+  const size_t begin = 2;
+  const size_t batchSize = 6;
+
+  double objective = 0;
+  arma::mat gradient, pointGradient;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+  {
+    objective += model.Evaluate(model.Parameters(), i);
+    model.Gradient(model.Parameters(), i, pointGradient);
+
+    if (i == begin)
+      gradient = pointGradient;
+    else
+      gradient += pointGradient;
+  }
+
+  const double batchObjective = model.Evaluate(model.Parameters(), begin,
+      batchSize);
+  arma::mat batchGradient;
+  model.Gradient(model.Parameters(), begin, batchSize, batchGradient);
+
+  BOOST_REQUIRE_CLOSE(batchObjective, objective, 1e-5);
+  BOOST_REQUIRE_EQUAL(batchGradient.n_elem, gradient.n_elem);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+  {
+    if (std::abs(gradient[i]) < 1e-10)
+      BOOST_REQUIRE_SMALL(batchGradient[i], 1e-10);
+    else
+      BOOST_REQUIRE_CLOSE(batchGradient[i], gradient[i], 1e-5);
+  }
+}
+
+/**
+ * Make sure that evaluating a batch of points in a single pass through the
+ * Linear, LinearNoBias, Add, activation and LogSoftMax layers, with the
+ * negative log likelihood and the mean squared error output layers, gives the
+ * sum over the points of the batch.
+ */
+BOOST_AUTO_TEST_CASE(BatchEvaluateGradientTest)
+{
+  arma::mat data = arma::randu<arma::mat>(4, 10);
+  arma::mat labels = arma::floor(3 * arma::randu<arma::mat>(1, 10)) + 1;
+  arma::mat responses = arma::randu<arma::mat>(2, 10);
+
+  FFN<NegativeLogLikelihood<> > classifier(data, labels);
+  classifier.Add<Linear<> >(4, 8);
+  classifier.Add<SigmoidLayer<> >();
+  classifier.Add<LinearNoBias<> >(8, 3);
+  classifier.Add<Add<> >(3);
+  classifier.Add<LogSoftMax<> >();
+  CheckBatchEvaluation(classifier);
+
+  FFN<MeanSquaredError<> > regressor(data, responses);
+  regressor.Add<Linear<> >(4, 5);
+  regressor.Add<TanHLayer<> >();
+  regressor.Add<Linear<> >(5, 2);
+  CheckBatchEvaluation(regressor);
+}
+
+/**
+ * Make sure that the convolution and pooling layers are not given batches of
+ * points, since they interpret their input as an image.
+ */
+BOOST_AUTO_TEST_CASE(BatchSupportVisitorTest)
+{
+  LayerTypes linear = new Linear<>(4, 8);
+  LayerTypes pooling = new MaxPooling<>(2, 2);
+  LayerTypes convolution = new Convolution<>(1, 2, 3, 3);
+
+  BOOST_REQUIRE(boost::apply_visitor(BatchSupportVisitor(), linear));
+  BOOST_REQUIRE(!boost::apply_visitor(BatchSupportVisitor(), pooling));
+  BOOST_REQUIRE(!boost::apply_visitor(BatchSupportVisitor(), convolution));
+
+  boost::apply_visitor(DeleteVisitor(), linear);
+  boost::apply_visitor(DeleteVisitor(), pooling);
+  boost::apply_visitor(DeleteVisitor(), convolution);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
\ No newline at end of file
@@ -762,4 +762,166 @@ BOOST_AUTO_TEST_CASE(UseExistingModelTest)
 }
 
 
+/**
+ * Make sure that the probabilities, log probabilities and classes computed for
+ * a whole matrix of observations (which is split into blocks) match those
+ * computed one observation at a time.
+ */
+BOOST_AUTO_TEST_CASE(GMMBlockProbabilityTest)
+{
+  GMM gmm(3, 2);
+  gmm.Component(0) = distribution::GaussianDistribution("0 0", "1 0; 0 1");
+  gmm.Component(1) = distribution::GaussianDistribution("1 3", "3 2; 2 3");
+  gmm.Component(2) = distribution::GaussianDistribution("-2 -2",
+      "2.2 1.4; 1.4 5.1");
+  gmm.Weights() = "0.6 0.25 0.15";
+
+  // Use enough observations for several blocks, and a partial last block.
+  arma::mat observations = 4.0 * arma::randn<arma::mat>(2, 2500);
+
+  arma::vec probabilities;
+  arma::vec logProbabilities;
+  arma::Row<size_t> classes;
+  gmm.Probability(observations, probabilities);
+  gmm.LogProbability(observations, logProbabilities);
+  gmm.Classify(observations, classes);
+
+  BOOST_REQUIRE_EQUAL(probabilities.n_elem, observations.n_cols);
+  BOOST_REQUIRE_EQUAL(logProbabilities.n_elem, observations.n_cols);
+  BOOST_REQUIRE_EQUAL(classes.n_elem, observations.n_cols);
+
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    const double probability = gmm.Probability(observations.col(i));
+    BOOST_REQUIRE_CLOSE(probabilities[i], probability, 1e-5);
+    BOOST_REQUIRE_CLOSE(logProbabilities[i], std::log(probability), 1e-5);
+
+    size_t label = 0;
+    for (size_t j = 1; j < gmm.Gaussians(); ++j)
+      if (gmm.Probability(observations.col(i), j) >=
+          gmm.Probability(observations.col(i), label))
+        label = j;
+    BOOST_REQUIRE_EQUAL(classes[i], label);
+  }
+
+  // Far from every component the densities underflow, but the log probability
+  // is still finite.
+  const arma::mat farObservations("200 -200; 200 200");
+  gmm.Probability(farObservations, probabilities);
+  gmm.LogProbability(farObservations, logProbabilities);
+  gmm.Classify(farObservations, classes);
+
+  for (size_t i = 0; i < farObservations.n_cols; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(gmm.Probability(farObservations.col(i)), 0.0);
+    BOOST_REQUIRE_EQUAL(probabilities[i], 0.0);
+    BOOST_REQUIRE(std::isfinite(logProbabilities[i]));
+    BOOST_REQUIRE_LT(logProbabilities[i], -1000.0);
+  }
+
+  // The classes are still decided by the log probabilities of the components.
+  BOOST_REQUIRE_EQUAL(classes[0], 1);
+  BOOST_REQUIRE_EQUAL(classes[1], 2);
+}
+
+/**
+ * Train a GMM with online EM from a file that is read in blocks, and make sure
+ * that it recovers the mixture the data was drawn from.
+ */
+BOOST_AUTO_TEST_CASE(GMMTrainOnlineEMTest)
+{
+  std::vector<distribution::GaussianDistribution> trueDists;
+  trueDists.push_back(distribution::GaussianDistribution("0 0", "1 0; 0 1"));
+  trueDists.push_back(distribution::GaussianDistribution("10 0",
+      "2 0.5; 0.5 1"));
+  trueDists.push_back(distribution::GaussianDistribution("0 10",
+      "0.5 0; 0 0.5"));
+  const arma::vec trueWeights("0.5 0.3 0.2");
+
+  arma::mat data(2, 6000);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const double randValue = math::Random();
+    const size_t component = (randValue < 0.5) ? 0 : (randValue < 0.8) ? 1 : 2;
+    data.col(i) = trueDists[component].Random();
+  }
+
+  data::Save("gmm_online_test.bin", data);
+  data::BinaryBlockReader reader("gmm_online_test.bin", 500);
+
+  // Start from a rough model, so that the test does not depend on the initial
+  // clustering.
+  GMM gmm(3, 2);
+  gmm.Component(0) = distribution::GaussianDistribution("1 1", "1 0; 0 1");
+  gmm.Component(1) = distribution::GaussianDistribution("8 1", "1 0; 0 1");
+  gmm.Component(2) = distribution::GaussianDistribution("1 8", "1 0; 0 1");
+  gmm.Weights().fill(1.0 / 3.0);
+  const double logLikelihood = gmm.Train(reader, true);
+
+  // The returned log-likelihood is that of all of the data.
+  arma::vec logProbabilities;
+  gmm.LogProbability(data, logProbabilities);
+  BOOST_REQUIRE_CLOSE(logLikelihood, arma::accu(logProbabilities), 1e-5);
+
+  // Match each true component with the closest trained component.
+  for (size_t i = 0; i < trueDists.size(); ++i)
+  {
+    size_t closest = 0;
+    for (size_t j = 1; j < gmm.Gaussians(); ++j)
+    {
+      if (arma::norm(gmm.Component(j).Mean() - trueDists[i].Mean()) <
+          arma::norm(gmm.Component(closest).Mean() - trueDists[i].Mean()))
+        closest = j;
+    }
+
+    BOOST_REQUIRE_SMALL(gmm.Weights()[closest] - trueWeights[i], 0.05);
+    for (size_t j = 0; j < 2; ++j)
+    {
+      BOOST_REQUIRE_SMALL(gmm.Component(closest).Mean()[j] -
+          trueDists[i].Mean()[j], 0.2);
+      for (size_t k = 0; k < 2; ++k)
+        BOOST_REQUIRE_SMALL(gmm.Component(closest).Covariance()(j, k) -
+            trueDists[i].Covariance()(j, k), 0.3);
+    }
+  }
+
+  remove("gmm_online_test.bin");
+}
+
+/**
+ * Update a trained GMM with new data using online EM, and make sure that the
+ * step size schedule controls how far the model moves.
+ */
+BOOST_AUTO_TEST_CASE(GMMOnlineEMUpdateTest)
+{
+  // Train on data centered at the origin, with mini-batches from a matrix.
+  arma::mat oldData = arma::randn<arma::mat>(2, 2000);
+  GMM gmm(1, 2);
+  gmm.Train(oldData, 1, false, OnlineEMFit<>(10, 1e-5, 200));
+
+  BOOST_REQUIRE_SMALL(gmm.Component(0).Mean()[0], 0.15);
+  BOOST_REQUIRE_SMALL(gmm.Component(0).Mean()[1], 0.15);
+
+  // New data arrives, centered at (3, 3).
+  arma::mat newData = arma::randn<arma::mat>(2, 2000);
+  newData += 3.0;
+  data::MatrixBlockReader reader(newData, 200);
+
+  // With tiny step sizes the model barely moves.
+  GMM slowGMM(gmm);
+  slowGMM.Train(reader, true, OnlineEMFit<>(1, 1e-5, 200,
+      PolynomialStepSize(1.0, 1e6)));
+  BOOST_REQUIRE_SMALL(slowGMM.Component(0).Mean()[0] -
+      gmm.Component(0).Mean()[0], 0.01);
+  BOOST_REQUIRE_SMALL(slowGMM.Component(0).Mean()[1] -
+      gmm.Component(0).Mean()[1], 0.01);
+
+  // With the default schedule it follows the new data.
+  gmm.Train(reader, true);
+  BOOST_REQUIRE_CLOSE(gmm.Component(0).Mean()[0], 3.0, 5.0);
+  BOOST_REQUIRE_CLOSE(gmm.Component(0).Mean()[1], 3.0, 5.0);
+  BOOST_REQUIRE_CLOSE(gmm.Component(0).Covariance()(0, 0), 1.0, 15.0);
+  BOOST_REQUIRE_CLOSE(gmm.Component(0).Covariance()(1, 1), 1.0, 15.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
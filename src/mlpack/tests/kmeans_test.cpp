@@ -704,4 +704,168 @@ BOOST_AUTO_TEST_CASE(SampleInitializationTest)
   }
 }
 
+/**
+ * Make sure that each mini-batch update keeps every centroid at the mean of all
+ * the points that have been assigned to it.
+ */
+BOOST_AUTO_TEST_CASE(MiniBatchKMeansUpdateTest)
+{
+  arma::mat dataset; // Not used by Update().
+  EuclideanDistance metric;
+  MiniBatchKMeans<EuclideanDistance, arma::mat> step(dataset, metric, 1000, 2,
+      1e-4);
+
+  arma::mat centroids("0 10; 0 10");
+  const double drift1 = step.Update(arma::mat("1 0 9; 0 1 10"), centroids);
+
+  BOOST_REQUIRE_CLOSE(centroids(0, 0), 0.5, 1e-5);
+  BOOST_REQUIRE_CLOSE(centroids(1, 0), 0.5, 1e-5);
+  BOOST_REQUIRE_CLOSE(centroids(0, 1), 9.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(centroids(1, 1), 10.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(drift1, std::sqrt(1.5), 1e-5);
+  BOOST_REQUIRE(!step.Converged());
+
+  const double drift2 = step.Update(arma::mat("-1; -1"), centroids);
+
+  BOOST_REQUIRE_SMALL(centroids(0, 0), 1e-5);
+  BOOST_REQUIRE_SMALL(centroids(1, 0), 1e-5);
+  BOOST_REQUIRE_CLOSE(centroids(0, 1), 9.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(centroids(1, 1), 10.0, 1e-5);
+  BOOST_REQUIRE_CLOSE(drift2, std::sqrt(0.5), 1e-5);
+  BOOST_REQUIRE_CLOSE(step.WindowDrift(), (drift1 + drift2) / 2, 1e-5);
+
+  BOOST_REQUIRE_EQUAL(step.Counts()[0], 3);
+  BOOST_REQUIRE_EQUAL(step.Counts()[1], 1);
+
+  // A mini-batch that moves nothing brings the mean drift over the window of
+  // two iterations down, but not below the tolerance yet.
+  step.Update(arma::mat("0; 0"), centroids);
+  BOOST_REQUIRE(!step.Converged());
+  step.Update(arma::mat("0; 0"), centroids);
+  BOOST_REQUIRE(step.Converged());
+}
+
+/**
+ * The mini-batches sampled by Iterate() should only depend on the random seed
+ * set before the MiniBatchKMeans object is constructed, and sampling them
+ * should not draw from the global random number generator.
+ */
+BOOST_AUTO_TEST_CASE(MiniBatchKMeansRandomStreamTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(2, 500);
+  EuclideanDistance metric;
+  const arma::mat centroids("0.25 0.75; 0.25 0.75");
+
+  math::RandomSeed(42);
+  MiniBatchKMeans<EuclideanDistance, arma::mat> step(dataset, metric, 50);
+  const double expected = math::Random();
+
+  math::RandomSeed(42);
+  MiniBatchKMeans<EuclideanDistance, arma::mat> otherStep(dataset, metric, 50);
+  arma::mat newCentroids, otherCentroids;
+  arma::Col<size_t> counts, otherCounts;
+  step.Iterate(centroids, newCentroids, counts);
+  otherStep.Iterate(centroids, otherCentroids, otherCounts);
+
+  // Both objects used the same stream seed, and the global generator was not
+  // used by Iterate().
+  BOOST_REQUIRE_EQUAL(math::Random(), expected);
+  for (size_t i = 0; i < newCentroids.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(newCentroids[i], otherCentroids[i]);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], otherCounts[i]);
+}
+
+/**
+ * Generate three well-separated clusters of 1000 points each, and the initial
+ * centroids to use for them.
+ */
+void MiniBatchKMeansData(arma::mat& dataset, arma::mat& centroids)
+{
+  const arma::mat means("0 10 0; 0 0 10");
+  dataset.randn(2, 3000);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    dataset.col(i) += means.col(i / 1000);
+  dataset = arma::shuffle(dataset, 1);
+
+  centroids = means + 1.0;
+}
+
+/**
+ * Mini-batch k-means should find the same clusters as the naive algorithm on
+ * well-separated data.
+ */
+BOOST_AUTO_TEST_CASE(MiniBatchKMeansTest)
+{
+  arma::mat dataset, centroids;
+  MiniBatchKMeansData(dataset, centroids);
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km;
+  arma::Row<size_t> assignments;
+  km.Cluster(dataset, 3, assignments, naiveCentroids, false, true);
+
+  KMeans<EuclideanDistance, SampleInitialization, AllowEmptyClusters,
+      MiniBatchKMeans> miniBatch;
+  arma::mat miniBatchCentroids(centroids);
+  arma::Row<size_t> miniBatchAssignments;
+  miniBatch.Cluster(dataset, 3, miniBatchAssignments, miniBatchCentroids,
+      false, true);
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    BOOST_REQUIRE_SMALL(miniBatchCentroids[i] - naiveCentroids[i], 0.05);
+
+  // Only points right on the boundary between two clusters could differ.
+  size_t same = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    if (assignments[i] == miniBatchAssignments[i])
+      ++same;
+  BOOST_REQUIRE_GE(same, 2990);
+}
+
+/**
+ * Clustering points given by block readers should find the same clusters as
+ * the naive algorithm on the same points in memory.
+ */
+BOOST_AUTO_TEST_CASE(MiniBatchKMeansBlockReaderTest)
+{
+  arma::mat dataset, centroids;
+  MiniBatchKMeansData(dataset, centroids);
+
+  arma::mat naiveCentroids(centroids);
+  KMeans<> km;
+  km.Cluster(dataset, 3, naiveCentroids, true);
+
+  data::Save("kmeans_block_test.csv", dataset);
+  data::MatrixBlockReader matrixReader(dataset, 250);
+  data::CSVBlockReader csvReader("kmeans_block_test.csv", 250);
+
+  KMeans<> streamKM(200);
+  arma::mat matrixCentroids(centroids), csvCentroids(centroids);
+  streamKM.Cluster(matrixReader, 3, matrixCentroids, true);
+  streamKM.Cluster(csvReader, 3, csvCentroids, true);
+
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+  {
+    BOOST_REQUIRE_SMALL(matrixCentroids[i] - naiveCentroids[i], 0.05);
+    BOOST_REQUIRE_SMALL(csvCentroids[i] - matrixCentroids[i], 1e-5);
+  }
+
+  // A maximum of 0 iterations means the blocks are passed over until the
+  // centroids converge.
+  KMeans<> unlimitedKM(0);
+  arma::mat unlimitedCentroids(centroids);
+  unlimitedKM.Cluster(matrixReader, 3, unlimitedCentroids, true);
+  for (size_t i = 0; i < centroids.n_elem; ++i)
+    BOOST_REQUIRE_SMALL(unlimitedCentroids[i] - naiveCentroids[i], 0.05);
+
+  // Without an initial guess, the initial centroids come from the first block.
+  arma::mat sampledCentroids;
+  streamKM.Cluster(matrixReader, 3, sampledCentroids);
+  BOOST_REQUIRE_EQUAL(sampledCentroids.n_rows, 2);
+  BOOST_REQUIRE_EQUAL(sampledCentroids.n_cols, 3);
+
+  remove("kmeans_block_test.csv");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
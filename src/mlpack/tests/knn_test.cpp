@@ -890,6 +890,70 @@ BOOST_AUTO_TEST_CASE(DualBallTreeTest)
   }
 }
 
+/**
+ * Test the breadth-first dual-tree traversal (which traverses query subtrees in
+ * parallel if OpenMP is available) against the naive method, both for
+ * monochromatic and bichromatic search.
+ */
+BOOST_AUTO_TEST_CASE(BreadthFirstDualTreeVsNaive)
+{
+  arma::mat dataset;
+  data::Load("test_data_3_1000.csv", dataset);
+  arma::mat querySet = arma::randu<arma::mat>(3, 2000);
+
+  typedef NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      KDTree, KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat>::template BreadthFirstDualTreeTraverser> BreadthFirstKNN;
+
+  BreadthFirstKNN bfknn(dataset);
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> bfNeighbors, naiveNeighbors;
+  arma::mat bfDistances, naiveDistances;
+
+  bfknn.Search(10, bfNeighbors, bfDistances);
+  naive.Search(10, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < bfNeighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(bfNeighbors[i], naiveNeighbors[i]);
+    BOOST_REQUIRE_CLOSE(bfDistances[i], naiveDistances[i], 1e-5);
+  }
+
+  bfknn.Search(querySet, 10, bfNeighbors, bfDistances);
+  naive.Search(querySet, 10, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < bfNeighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(bfNeighbors[i], naiveNeighbors[i]);
+    BOOST_REQUIRE_CLOSE(bfDistances[i], naiveDistances[i], 1e-5);
+  }
+
+  // A serial traversal must give the same results.  Each worker only touches
+  // its own query subtree and starts from the traversal info of its parent, so
+  // the base cases counted across all workers must also match.
+  const size_t parallelBaseCases = bfknn.BaseCases();
+  BOOST_REQUIRE_GT(parallelBaseCases, 0);
+
+  arma::Mat<size_t> serialNeighbors;
+  arma::mat serialDistances;
+#ifdef HAS_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  bfknn.Search(querySet, 10, serialNeighbors, serialDistances);
+#ifdef HAS_OPENMP
+  omp_set_num_threads(threads);
+#endif
+
+  BOOST_REQUIRE_EQUAL(bfknn.BaseCases(), parallelBaseCases);
+  for (size_t i = 0; i < bfNeighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(bfNeighbors[i], serialNeighbors[i]);
+    BOOST_REQUIRE_EQUAL(bfDistances[i], serialDistances[i]);
+  }
+}
+
 /**
  * Test the spill tree hybrid sp-tree search (defeatist search on overlapping
  * nodes, and backtracking in non-overlapping nodes) against the naive method.
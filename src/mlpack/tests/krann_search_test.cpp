@@ -715,4 +715,83 @@ BOOST_AUTO_TEST_CASE(RAModelTest)
   }
 }
 
+/**
+ * Make sure that single-tree and dual-tree search give the same results after
+ * the random seed is reset, and, when OpenMP is available, that the results do
+ * not depend on the number of threads.  The query set is large enough that the
+ * dual-tree search is split into several query subtrees.
+ */
+BOOST_AUTO_TEST_CASE(ReproducibleSearchTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 2000);
+  arma::mat queryData = arma::randu<arma::mat>(3, 3000);
+
+  for (size_t mode = 0; mode < 2; ++mode)
+  {
+    RASearch<> rs(referenceData, false, (mode == 0), 5.0);
+
+    arma::Mat<size_t> neighbors1, neighbors2;
+    arma::mat distances1, distances2;
+
+    math::RandomSeed(123);
+    rs.Search(queryData, 3, neighbors1, distances1);
+
+    math::RandomSeed(123);
+#ifdef HAS_OPENMP
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    rs.Search(queryData, 3, neighbors2, distances2);
+#ifdef HAS_OPENMP
+    omp_set_num_threads(threads);
+#endif
+
+    BOOST_REQUIRE_EQUAL(neighbors1.n_cols, queryData.n_cols);
+    for (size_t i = 0; i < neighbors1.n_elem; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(neighbors1[i], neighbors2[i]);
+      BOOST_REQUIRE_EQUAL(distances1[i], distances2[i]);
+    }
+  }
+}
+
+/**
+ * Make sure that copies and moves of the rules use their own candidate lists,
+ * sample counts and random streams, and not those of the original object.
+ */
+BOOST_AUTO_TEST_CASE(RulesCopyMoveTest)
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 100);
+  arma::mat queryData = arma::randu<arma::mat>(3, 20);
+  EuclideanDistance metric;
+
+  typedef RASearchRules<NearestNeighborSort, EuclideanDistance,
+      RASearch<>::Tree> RuleType;
+
+  // Naive rules sample for every query point on construction.
+  RuleType rules(referenceData, queryData, 3, metric, 5.0, 0.95, true);
+  RuleType copy(rules);
+  RuleType otherCopy(rules);
+  RuleType moved(std::move(otherCopy));
+
+  // GetResults() empties the candidate lists it reads, so each object must
+  // still have all of its own candidates.
+  arma::Mat<size_t> neighbors, copyNeighbors, movedNeighbors;
+  arma::mat distances, copyDistances, movedDistances;
+  copy.GetResults(copyNeighbors, copyDistances);
+  moved.GetResults(movedNeighbors, movedDistances);
+  rules.GetResults(neighbors, distances);
+
+  BOOST_REQUIRE_EQUAL(rules.NumEffectiveSamples(), copy.NumEffectiveSamples());
+  BOOST_REQUIRE_EQUAL(rules.NumEffectiveSamples(),
+      moved.NumEffectiveSamples());
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors[i], copyNeighbors[i]);
+    BOOST_REQUIRE_EQUAL(distances[i], copyDistances[i]);
+    BOOST_REQUIRE_EQUAL(neighbors[i], movedNeighbors[i]);
+    BOOST_REQUIRE_EQUAL(distances[i], movedDistances[i]);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -13,12 +13,15 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/optimizers/lbfgs/lbfgs.hpp>
 #include <mlpack/core/optimizers/lbfgs/test_functions.hpp>
+#include <mlpack/core/optimizers/parallel_separable/parallel_separable_function.hpp>
+#include <mlpack/methods/logistic_regression/logistic_regression_function.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
 using namespace mlpack::optimization;
 using namespace mlpack::optimization::test;
+using namespace mlpack::regression;
 
 BOOST_AUTO_TEST_SUITE(LBFGSTest);
 
@@ -117,4 +120,50 @@ BOOST_AUTO_TEST_CASE(RosenbrockWoodFunctionTest)
   }
 }
 
+/**
+ * Make sure that ParallelSeparableFunction computes the same objective and
+ * gradient as the wrapped function, and that L-BFGS finds the same optimum
+ * with it.
+ */
+BOOST_AUTO_TEST_CASE(ParallelSeparableFunctionTest)
+{
+  const size_t points = 1000;
+  arma::mat data = arma::randn<arma::mat>(5, points);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+    responses[i] = (data(0, i) + 0.5 * data(3, i) > 0.0) ? 1 : 0;
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.1);
+  // Use small blocks so that the data is split when there are several threads.
+  ParallelSeparableFunction<LogisticRegressionFunction<>> plrf(lrf, 7);
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    const arma::mat parameters = arma::randn<arma::mat>(6, 1);
+
+    BOOST_REQUIRE_CLOSE(plrf.Evaluate(parameters), lrf.Evaluate(parameters),
+        1e-5);
+
+    arma::mat gradient, parallelGradient;
+    lrf.Gradient(parameters, gradient);
+    plrf.Gradient(parameters, parallelGradient);
+
+    BOOST_REQUIRE_EQUAL(parallelGradient.n_rows, gradient.n_rows);
+    BOOST_REQUIRE_EQUAL(parallelGradient.n_cols, gradient.n_cols);
+    for (size_t i = 0; i < gradient.n_elem; ++i)
+      BOOST_REQUIRE_CLOSE(parallelGradient[i], gradient[i], 1e-5);
+  }
+
+  L_BFGS<LogisticRegressionFunction<>> lbfgs(lrf);
+  arma::mat coords = lrf.GetInitialPoint();
+  lbfgs.Optimize(coords);
+
+  L_BFGS<ParallelSeparableFunction<LogisticRegressionFunction<>>> plbfgs(plrf);
+  arma::mat parallelCoords = lrf.GetInitialPoint();
+  plbfgs.Optimize(parallelCoords);
+
+  for (size_t i = 0; i < coords.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(parallelCoords[i], coords[i], 1e-3);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
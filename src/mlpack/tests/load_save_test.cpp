@@ -996,6 +996,48 @@ BOOST_AUTO_TEST_CASE(DatasetInfoTest)
   BOOST_REQUIRE_EQUAL(strThird, "test_mapping_3");
 }
 
+/**
+ * Make sure that mapping a batch of strings with MapTokens() gives the same
+ * values as mapping them one at a time with MapString().
+ */
+BOOST_AUTO_TEST_CASE(DatasetInfoMapTokensTest)
+{
+  // Use enough strings that the batch is split into several chunks.
+  vector<string> tokens(50000);
+  for (size_t i = 0; i < tokens.size(); ++i)
+    tokens[i] = "id" + to_string(math::RandInt(5000));
+
+  // Map some of the strings beforehand, so that some of the batch already has
+  // a mapping.
+  DatasetInfo serial(3), batch(3);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    serial.MapString<double>(tokens[i], 1);
+    batch.MapString<double>(tokens[i], 1);
+  }
+
+  arma::rowvec values;
+  batch.MapTokens<double>(tokens, 1, values);
+
+  BOOST_REQUIRE_EQUAL(values.n_elem, tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i)
+    BOOST_REQUIRE_EQUAL(values[i], serial.MapString<double>(tokens[i], 1));
+
+  BOOST_REQUIRE(batch.Type(1) == Datatype::categorical);
+  BOOST_REQUIRE_EQUAL(batch.NumMappings(0), 0);
+  BOOST_REQUIRE_EQUAL(batch.NumMappings(1), serial.NumMappings(1));
+  BOOST_REQUIRE_EQUAL(batch.NumMappings(2), 0);
+  for (size_t i = 0; i < batch.NumMappings(1); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(batch.UnmapString(i, 1), serial.UnmapString(i, 1));
+    BOOST_REQUIRE_EQUAL(batch.UnmapValue(serial.UnmapString(i, 1), 1), i);
+  }
+
+  BOOST_REQUIRE_THROW(batch.UnmapString(batch.NumMappings(1), 1),
+      std::invalid_argument);
+  BOOST_REQUIRE_THROW(batch.UnmapValue("unknown", 1), std::invalid_argument);
+}
+
 /**
  * Test loading regular CSV with DatasetInfo.  Everything should be numeric.
  */
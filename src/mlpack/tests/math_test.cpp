@@ -583,4 +583,135 @@ BOOST_AUTO_TEST_CASE(RangeContainsRange)
   BOOST_REQUIRE_EQUAL(b.Contains(a), true);
 }
 
+/**
+ * Make sure that RandomStream matches the known answer of Philox4x32-10 for a
+ * zero key and counter, and that streams are reproducible and independent.
+ */
+BOOST_AUTO_TEST_CASE(RandomStreamTest)
+{
+  RandomStream zero(0, 0);
+  BOOST_REQUIRE_EQUAL(zero(), 0x6627e8d5U);
+  BOOST_REQUIRE_EQUAL(zero(), 0xe169c58dU);
+  BOOST_REQUIRE_EQUAL(zero(), 0xbc57ac4cU);
+  BOOST_REQUIRE_EQUAL(zero(), 0x9b00dbd8U);
+
+  RandomStream a(17, 3), b(17, 3), c(17, 4);
+  size_t differences = 0;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const double x = a.Random();
+    BOOST_REQUIRE_EQUAL(x, b.Random());
+    BOOST_REQUIRE_GE(x, 0.0);
+    BOOST_REQUIRE_LT(x, 1.0);
+
+    if (x != c.Random())
+      ++differences;
+
+    const int r = a.RandInt(5, 10);
+    BOOST_REQUIRE_EQUAL(r, b.RandInt(5, 10));
+    BOOST_REQUIRE_GE(r, 5);
+    BOOST_REQUIRE_LT(r, 10);
+    c.RandInt(5, 10);
+  }
+  BOOST_REQUIRE_GT(differences, 990);
+
+  // Distinct samples drawn from a stream are reproducible too.
+  arma::uvec samples1, samples2;
+  RandomStream d(5, 0), e(5, 0);
+  ObtainDistinctSamples(10, 1000, 50, samples1, d);
+  ObtainDistinctSamples(10, 1000, 50, samples2, e);
+  BOOST_REQUIRE_EQUAL(samples1.n_elem, samples2.n_elem);
+  for (size_t i = 0; i < samples1.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(samples1[i], samples2[i]);
+    BOOST_REQUIRE_GE(samples1[i], 10);
+    BOOST_REQUIRE_LT(samples1[i], 1000);
+  }
+
+  // Stream seeds follow the global seed.
+  RandomSeed(42);
+  const size_t seed1 = RandomStreamSeed();
+  RandomSeed(42);
+  BOOST_REQUIRE_EQUAL(seed1, RandomStreamSeed());
+}
+
+/**
+ * Make sure that the bulk fills of RandomStream give the same numbers as
+ * drawing them one at a time, for any number of threads.
+ */
+BOOST_AUTO_TEST_CASE(RandomStreamFillTest)
+{
+  // Large enough to be filled in parallel; the odd size leaves half a block.
+  arma::mat u(101, 201), n(101, 201);
+  RandomStream a(11, 2), b(11, 2);
+  a.Randu(u);
+  a.Randn(n);
+
+  for (size_t i = 0; i < u.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(u[i], b.Random());
+  // The second half of the last block is skipped.
+  b.Random();
+  for (size_t i = 0; i < n.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(n[i], b.RandNormal());
+
+  // Both streams continue from the same block.
+  b.RandNormal();
+  BOOST_REQUIRE_EQUAL(a.Random(), b.Random());
+
+  BOOST_REQUIRE_SMALL(arma::mean(arma::vectorise(n)), 0.02);
+  BOOST_REQUIRE_CLOSE(arma::var(arma::vectorise(n)), 1.0, 3.0);
+
+  arma::fcube c(30, 40, 50);
+  RandomStream(11, 3).Randu(c);
+  BOOST_REQUIRE_GE(c.min(), 0.0);
+  BOOST_REQUIRE_LE(c.max(), 1.0);
+
+#ifdef HAS_OPENMP
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  arma::mat serial(101, 201);
+  RandomStream(11, 2).Randu(serial);
+  omp_set_num_threads(threads);
+
+  for (size_t i = 0; i < u.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(u[i], serial[i]);
+#endif
+}
+
+/**
+ * Make sure that the stream of each thread is reset by RandomSeed().
+ */
+BOOST_AUTO_TEST_CASE(ThreadStreamTest)
+{
+  RandomSeed(7);
+  const double x = ThreadStream().Random();
+  const double y = ThreadStream().Random();
+  BOOST_REQUIRE_NE(x, y);
+
+  RandomSeed(7);
+  BOOST_REQUIRE_EQUAL(ThreadStream().Random(), x);
+  BOOST_REQUIRE_EQUAL(ThreadStream().Random(), y);
+
+  RandomSeed(8);
+  BOOST_REQUIRE_NE(ThreadStream().Random(), x);
+
+  // Every thread draws from a different stream.
+  RandomSeed(7);
+  arma::vec draws(4);
+  #pragma omp parallel for num_threads(4) schedule(static, 1)
+  for (intmax_t i = 0; i < 4; ++i)
+    draws[i] = ThreadStream().Random();
+
+#ifdef HAS_OPENMP
+  for (size_t i = 0; i < 4; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(draws[i], RandomStream(7, i).Random());
+    for (size_t j = i + 1; j < 4; ++j)
+      BOOST_REQUIRE_NE(draws[i], draws[j]);
+  }
+#else
+  BOOST_REQUIRE_EQUAL(draws[0], x);
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -145,4 +145,58 @@ BOOST_AUTO_TEST_CASE(GaussianClustering)
       BOOST_REQUIRE_NE(minIndices[i], minIndices[j]);
 }
 
+/**
+ * Find many small, well-separated clusters using every point as a seed, so
+ * that removing duplicate centroids has to search for nearby centroids several
+ * times.
+ */
+BOOST_AUTO_TEST_CASE(ManyClustersTest)
+{
+  const size_t numClusters = 150;
+  const size_t clusterSize = 10;
+
+  arma::mat means(2, numClusters);
+  arma::mat dataset(2, numClusters * clusterSize);
+  for (size_t c = 0; c < numClusters; ++c)
+  {
+    means(0, c) = 10.0 * (c % 15);
+    means(1, c) = 10.0 * (c / 15);
+    for (size_t i = 0; i < clusterSize; ++i)
+    {
+      dataset.col(c * clusterSize + i) = means.col(c) +
+          0.1 * arma::randn<arma::vec>(2);
+    }
+  }
+
+  MeanShift<> meanShift(2.0);
+
+  arma::Col<size_t> assignments;
+  arma::mat centroids;
+  meanShift.Cluster(dataset, assignments, centroids, false);
+
+  BOOST_REQUIRE_EQUAL(centroids.n_cols, numClusters);
+
+  // Each centroid should be close to a different mean.
+  std::vector<size_t> centroidOfMean(numClusters, numClusters);
+  for (size_t k = 0; k < centroids.n_cols; ++k)
+  {
+    size_t closest = 0;
+    for (size_t c = 1; c < numClusters; ++c)
+    {
+      if (arma::norm(centroids.col(k) - means.col(c)) <
+          arma::norm(centroids.col(k) - means.col(closest)))
+        closest = c;
+    }
+
+    BOOST_REQUIRE_LT(arma::norm(centroids.col(k) - means.col(closest)), 0.5);
+    BOOST_REQUIRE_EQUAL(centroidOfMean[closest], numClusters);
+    centroidOfMean[closest] = k;
+  }
+
+  // Each point should be assigned to the centroid of its mean.
+  for (size_t c = 0; c < numClusters; ++c)
+    for (size_t i = 0; i < clusterSize; ++i)
+      BOOST_REQUIRE_EQUAL(assignments[c * clusterSize + i], centroidOfMean[c]);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -159,4 +159,45 @@ BOOST_AUTO_TEST_CASE(ZeroBatchSizeTest)
   BOOST_REQUIRE_EQUAL(finite, true);
 }
 
+/**
+ * The batch overloads of LogisticRegressionFunction should be detected and
+ * should give the sum of the per-point objectives and gradients.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionBatchFunctionTest)
+{
+  const bool lrfHasBatch =
+      HasBatchFunctions<LogisticRegressionFunction<>>::value;
+  const bool testHasBatch = HasBatchFunctions<SGDTestFunction>::value;
+  BOOST_REQUIRE_EQUAL(lrfHasBatch, true);
+  BOOST_REQUIRE_EQUAL(testHasBatch, false);
+
+  arma::mat data = arma::randu<arma::mat>(4, 100);
+  arma::Row<size_t> responses(100);
+  for (size_t i = 0; i < 100; ++i)
+    responses[i] = (data(0, i) > 0.5) ? 1 : 0;
+
+  LogisticRegressionFunction<> lrf(data, responses, 0.5);
+  const arma::mat parameters = arma::randu<arma::mat>(5, 1);
+
+  const size_t begin = 17;
+  const size_t batchSize = 30;
+  double objective = 0;
+  arma::mat gradient = arma::zeros<arma::mat>(5, 1);
+  arma::mat pointGradient;
+  for (size_t i = begin; i < begin + batchSize; ++i)
+  {
+    objective += lrf.Evaluate(parameters, i);
+    lrf.Gradient(parameters, i, pointGradient);
+    gradient += pointGradient;
+  }
+
+  arma::mat batchGradient;
+  lrf.Gradient(parameters, begin, batchSize, batchGradient);
+
+  BOOST_REQUIRE_CLOSE(lrf.Evaluate(parameters, begin, batchSize), objective,
+      1e-5);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(batchGradient[i], gradient[i], 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -323,4 +323,145 @@ BOOST_AUTO_TEST_CASE(NCALBFGSSimpleDataset)
 
 }
 
+/**
+ * When every other point is a neighbor, the neighbor-truncated objective and
+ * gradient must be the same as the exact ones.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxTruncatedAllNeighbors)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 30);
+  arma::Row<size_t> labels(30);
+  for (size_t i = 0; i < 30; ++i)
+    labels[i] = (data(0, i) > 0.5) ? 1 : 0;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+  SoftmaxErrorFunction<SquaredEuclideanDistance> tsef(data, labels,
+      SquaredEuclideanDistance(), 100);
+
+  arma::mat coordinates = arma::randu<arma::mat>(3, 3);
+
+  BOOST_REQUIRE_CLOSE(tsef.Evaluate(coordinates), sef.Evaluate(coordinates),
+      1e-5);
+  BOOST_REQUIRE_EQUAL(tsef.Neighbors().n_rows, (arma::uword) 29);
+
+  arma::mat gradient, truncatedGradient;
+  sef.Gradient(coordinates, gradient);
+  tsef.Gradient(coordinates, truncatedGradient);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(truncatedGradient[i], gradient[i], 1e-5);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(tsef.Evaluate(coordinates, i),
+        sef.Evaluate(coordinates, i), 1e-5);
+
+    sef.Gradient(coordinates, i, gradient);
+    tsef.Gradient(coordinates, i, truncatedGradient);
+    for (size_t j = 0; j < gradient.n_elem; ++j)
+      BOOST_REQUIRE_CLOSE(truncatedGradient[j], gradient[j], 1e-5);
+  }
+}
+
+/**
+ * Make sure that NCA with a neighbor-truncated objective still separates the
+ * points of our simple dataset.
+ */
+BOOST_AUTO_TEST_CASE(NCALBFGSTruncatedSimpleDataset)
+{
+  // Useful but simple dataset with six points and two classes.
+  arma::mat data           = "-0.1 -0.1 -0.1  0.1  0.1  0.1;"
+                             " 1.0  0.0 -1.0  1.0  0.0 -1.0 ";
+  arma::Row<size_t> labels = " 0    0    0    1    1    1   ";
+
+  NCA<SquaredEuclideanDistance, L_BFGS> nca(data, labels);
+  nca.Optimizer().NumBasis() = 5;
+  nca.Optimizer().Function().NumNeighbors() = 3;
+  nca.Optimizer().Function().RefreshInterval() = 1;
+
+  arma::mat outputMatrix;
+  nca.LearnDistance(outputMatrix);
+
+  // Check the exact objective.
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+
+  double initObj = sef.Evaluate(arma::eye<arma::mat>(2, 2));
+  double finalObj = sef.Evaluate(outputMatrix);
+
+  // The approximation does not reach the exact optimum, but the classes should
+  // be mostly separated.
+  BOOST_REQUIRE_LT(finalObj, initObj);
+  BOOST_REQUIRE_LT(finalObj, -5.0);
+}
+
+/**
+ * The per-point and batch gradients must only refresh the neighbor lists when
+ * the gradient of the first point is taken, and the per-point and batch
+ * objectives must never refresh them.  The batch overloads must also give the
+ * sums of the per-point ones.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxTruncatedSeparableRefresh)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 30);
+  arma::Row<size_t> labels(30);
+  for (size_t i = 0; i < 30; ++i)
+    labels[i] = (data(0, i) > 0.5) ? 1 : 0;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> tsef(data, labels,
+      SquaredEuclideanDistance(), 5, 1);
+
+  arma::mat coordinates = arma::eye<arma::mat>(3, 3);
+  arma::mat newCoordinates = arma::randu<arma::mat>(3, 3);
+
+  // Compute the neighbors with the first coordinates.  This counts as a pass
+  // over the data.
+  tsef.Evaluate(coordinates);
+  const arma::Mat<size_t> neighbors = tsef.Neighbors();
+
+  // Per-point objectives with other coordinates never refresh the neighbors.
+  double objective = 0.0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+    objective += tsef.Evaluate(newCoordinates, i);
+  BOOST_REQUIRE_EQUAL(arma::accu(tsef.Neighbors() != neighbors),
+      (arma::uword) 0);
+
+  // Neither do the gradients of the other points, in the middle of a pass.
+  arma::mat pointGradient;
+  for (size_t i = 1; i < data.n_cols; ++i)
+    tsef.Gradient(newCoordinates, i, pointGradient);
+  BOOST_REQUIRE_EQUAL(arma::accu(tsef.Neighbors() != neighbors),
+      (arma::uword) 0);
+
+  // The batch objective does not refresh the neighbors either.
+  const size_t begin = 0;
+  const size_t batchSize = data.n_cols;
+  BOOST_REQUIRE_CLOSE(tsef.Evaluate(newCoordinates, begin, batchSize),
+      objective, 1e-5);
+  BOOST_REQUIRE_EQUAL(arma::accu(tsef.Neighbors() != neighbors),
+      (arma::uword) 0);
+
+  // But the gradient of the first point starts a new pass, so it refreshes the
+  // neighbors in the space stretched by the new coordinates.
+  tsef.Gradient(newCoordinates, 0, pointGradient);
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> newTsef(data, labels,
+      SquaredEuclideanDistance(), 5, 1);
+  newTsef.Evaluate(newCoordinates);
+  BOOST_REQUIRE_EQUAL(arma::accu(tsef.Neighbors() != newTsef.Neighbors()),
+      (arma::uword) 0);
+
+  // With the refreshed neighbors, the batch gradient is the sum of the
+  // per-point gradients.
+  arma::mat batchGradient;
+  tsef.Gradient(newCoordinates, begin, batchSize, batchGradient);
+
+  arma::mat gradient(3, 3, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    tsef.Gradient(newCoordinates, i, pointGradient);
+    gradient += pointGradient;
+  }
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(batchGradient[i], gradient[i], 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
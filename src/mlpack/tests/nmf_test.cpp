@@ -16,6 +16,8 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_div.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
+#include <mlpack/methods/amf/update_rules/weighted_als.hpp>
+#include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -221,4 +223,83 @@ BOOST_AUTO_TEST_CASE(SparseNMFALSTest)
       1e-5);
 }
 
+/**
+ * Check that a single weighted ALS update of H solves the regularized least
+ * squares problem for each column, for both explicit and implicit feedback.
+ */
+BOOST_AUTO_TEST_CASE(WeightedALSUpdateTest)
+{
+  sp_mat v;
+  v.sprandu(20, 15, 0.3);
+  const mat w = randu<mat>(20, 4);
+  const mat dv(v);
+
+  // Explicit feedback: only the observed entries of each column are fit.
+  WeightedALSUpdate explicitUpdate(0.5);
+  mat h;
+  explicitUpdate.HUpdate(v, w, h);
+
+  BOOST_REQUIRE_EQUAL(h.n_rows, 4);
+  BOOST_REQUIRE_EQUAL(h.n_cols, 15);
+  for (size_t j = 0; j < v.n_cols; ++j)
+  {
+    const uvec observed = find(dv.col(j) != 0);
+    if (observed.n_elem == 0)
+    {
+      BOOST_REQUIRE_SMALL(norm(h.col(j)), 1e-12);
+      continue;
+    }
+
+    const mat wo = w.rows(observed);
+    const mat a = wo.t() * wo + 0.5 * observed.n_elem * eye<mat>(4, 4);
+    const vec b = wo.t() * dv.col(j).eval().elem(observed);
+    const vec expected = solve(a, b);
+    for (size_t k = 0; k < 4; ++k)
+      BOOST_REQUIRE_SMALL(h(k, j) - expected[k], 1e-8);
+  }
+
+  // Implicit feedback: every entry is fit, weighted by its confidence.
+  WeightedALSUpdate implicitUpdate(0.5, 10.0);
+  implicitUpdate.HUpdate(v, w, h);
+  for (size_t j = 0; j < v.n_cols; ++j)
+  {
+    const vec confidence = 1.0 + 10.0 * dv.col(j);
+    const vec preference = conv_to<vec>::from(dv.col(j) != 0);
+    const mat a = w.t() * diagmat(confidence) * w + 0.5 * eye<mat>(4, 4);
+    const vec b = w.t() * (confidence % preference);
+    const vec expected = solve(a, b);
+    for (size_t k = 0; k < 4; ++k)
+      BOOST_REQUIRE_SMALL(h(k, j) - expected[k], 1e-8);
+  }
+}
+
+/**
+ * Factorize a partially observed low-rank matrix with weighted ALS, and make
+ * sure that both the observed and the held out entries are recovered.
+ */
+BOOST_AUTO_TEST_CASE(WeightedALSRecoveryTest)
+{
+  const mat truth = randu<mat>(30, 3) * randu<mat>(3, 40);
+
+  // Observe about half of the entries.
+  const mat mask = conv_to<mat>::from(randu<mat>(30, 40) < 0.5);
+  const sp_mat v(truth % mask);
+
+  MaxIterationTermination mit(100);
+  AMF<MaxIterationTermination, RandomInitialization, WeightedALSUpdate>
+      als(mit, RandomInitialization(), WeightedALSUpdate(1e-6));
+
+  mat w, h;
+  als.Apply(v, 3, w, h);
+
+  const mat estimate = w * h;
+  const double observedError = norm((estimate - truth) % mask, "fro") /
+      norm(truth % mask, "fro");
+  const double heldOutError = norm((estimate - truth) % (1 - mask), "fro") /
+      norm(truth % (1 - mask), "fro");
+
+  BOOST_REQUIRE_SMALL(observedError, 1e-3);
+  BOOST_REQUIRE_SMALL(heldOutError, 1e-2);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -290,4 +290,58 @@ BOOST_AUTO_TEST_CASE(PCAScalingTest)
 }
 
 
+/**
+ * PCA on data given by a block reader should match PCA on the same data held in
+ * memory, for both policies that support streaming.
+ */
+BOOST_AUTO_TEST_CASE(BlockReaderPCATest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 300);
+  data.row(1) += 3 * data.row(0);
+  data.row(4) *= 4;
+
+  arma::mat transData, eigvec;
+  arma::vec eigval;
+  PCA p;
+  p.Apply(data, transData, eigval, eigvec);
+
+  data::MatrixBlockReader reader(data, 32);
+
+  arma::mat exactEigvec;
+  arma::vec exactEigval, exactMean;
+  p.Apply(reader, exactEigval, exactEigvec, exactMean);
+
+  arma::mat randomizedEigvec;
+  arma::vec randomizedEigval, randomizedMean;
+  PCAType<RandomizedSVDPolicy> rp(false, RandomizedSVDPolicy(5, 5));
+  rp.Apply(reader, randomizedEigval, randomizedEigvec, randomizedMean, 2);
+
+  BOOST_REQUIRE_EQUAL(exactEigvec.n_cols, (arma::uword) 5);
+  BOOST_REQUIRE_EQUAL(randomizedEigvec.n_cols, (arma::uword) 2);
+  for (size_t i = 0; i < 5; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(exactMean[i], arma::mean(data.row(i)), 1e-5);
+    BOOST_REQUIRE_CLOSE(exactEigval[i], eigval[i], 1e-5);
+    for (size_t j = 0; j < 5; ++j)
+      BOOST_REQUIRE_SMALL(std::abs(exactEigvec(j, i)) -
+          std::abs(eigvec(j, i)), 1e-5);
+  }
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(randomizedEigval[i], eigval[i], 1e-3);
+    for (size_t j = 0; j < 5; ++j)
+      BOOST_REQUIRE_SMALL(std::abs(randomizedEigvec(j, i)) -
+          std::abs(eigvec(j, i)), 1e-4);
+  }
+
+  // Transforming the data block by block gives the in-memory transformation
+  // (up to sign).
+  arma::mat streamTransData = exactEigvec.t() * data;
+  streamTransData.each_col() -= exactEigvec.t() * exactMean;
+  for (size_t i = 0; i < 5; ++i)
+    BOOST_REQUIRE_SMALL(std::abs(streamTransData(i, 10)) -
+        std::abs(transData(i, 10)), 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -107,6 +107,35 @@ BOOST_AUTO_TEST_CASE(QDAFNUniformSet)
   BOOST_REQUIRE_GE(successes, 700);
 }
 
+/**
+ * With one projection that stores every point, all the points are visited, so
+ * the results should be exact for every k.
+ */
+BOOST_AUTO_TEST_CASE(QDAFNExhaustiveExactTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 200);
+
+  QDAFN<> qdafn(dataset, 1, 200);
+
+  arma::Mat<size_t> neighbors, trueNeighbors;
+  arma::mat distances, trueDistances;
+  qdafn.Search(dataset, 3, neighbors, distances);
+
+  AllkFN kfn(dataset);
+  kfn.Search(dataset, 3, trueNeighbors, trueDistances);
+
+  BOOST_REQUIRE_EQUAL(neighbors.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(neighbors.n_cols, 200);
+  BOOST_REQUIRE_EQUAL(distances.n_rows, 3);
+  BOOST_REQUIRE_EQUAL(distances.n_cols, 200);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors[i], trueNeighbors[i]);
+    BOOST_REQUIRE_CLOSE(distances[i], trueDistances[i], 1e-5);
+  }
+}
+
 /**
  * Test re-training method.
  */
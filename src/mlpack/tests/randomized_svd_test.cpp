@@ -12,6 +12,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/randomized_svd/randomized_svd.hpp>
+#include <mlpack/core/data/block_reader.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -64,4 +65,63 @@ BOOST_AUTO_TEST_CASE(RandomizedSVDReconstructionError)
   BOOST_REQUIRE_SMALL(error, 1e-5);
 }
 
+/**
+ * The streaming variant should recover the singular values and left singular
+ * vectors of the centered data, whether the blocks come from memory, a CSV
+ * file, or a binary file.
+ */
+BOOST_AUTO_TEST_CASE(RandomizedSVDBlockReaderTest)
+{
+  // Rank-3 data with a nonzero mean.
+  arma::mat U, V, R;
+  arma::qr_econ(U, R, arma::randn<arma::mat>(10, 3));
+  arma::qr_econ(V, R, arma::randn<arma::mat>(200, 3));
+  arma::mat data = U * arma::diagmat(arma::vec("10 5 1")) * V.t();
+  data.each_col() += arma::linspace<arma::vec>(1, 10, 10);
+
+  arma::mat centeredData;
+  math::Center(data, centeredData);
+
+  arma::mat U1, V1;
+  arma::vec s1;
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  data::Save("rsvd_block_test.csv", data);
+  data::Save("rsvd_block_test.bin", data);
+
+  data::MatrixBlockReader matrixReader(data, 17);
+  data::CSVBlockReader csvReader("rsvd_block_test.csv", 17);
+  data::BinaryBlockReader binaryReader("rsvd_block_test.bin", 17);
+
+  BOOST_REQUIRE_EQUAL(csvReader.Rows(), (size_t) 10);
+  BOOST_REQUIRE_EQUAL(csvReader.Cols(), (size_t) 200);
+  BOOST_REQUIRE_EQUAL(binaryReader.Rows(), (size_t) 10);
+  BOOST_REQUIRE_EQUAL(binaryReader.Cols(), (size_t) 200);
+
+  svd::RandomizedSVD rSVD(0, 4);
+  arma::mat U2, U3, U4;
+  arma::vec s2, s3, s4;
+  rSVD.Apply(matrixReader, U2, s2, 3);
+  rSVD.Apply(csvReader, U3, s3, 3);
+  rSVD.Apply(binaryReader, U4, s4, 3);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(s2[i], s1[i], 1e-3);
+    BOOST_REQUIRE_CLOSE(s3[i], s1[i], 1e-3);
+    BOOST_REQUIRE_CLOSE(s4[i], s1[i], 1e-3);
+
+    // Singular vectors are only defined up to sign.
+    for (size_t j = 0; j < 10; ++j)
+    {
+      BOOST_REQUIRE_SMALL(std::abs(U2(j, i)) - std::abs(U1(j, i)), 1e-5);
+      BOOST_REQUIRE_SMALL(std::abs(U3(j, i)) - std::abs(U1(j, i)), 1e-5);
+      BOOST_REQUIRE_SMALL(std::abs(U4(j, i)) - std::abs(U1(j, i)), 1e-5);
+    }
+  }
+
+  remove("rsvd_block_test.csv");
+  remove("rsvd_block_test.bin");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -1696,4 +1696,21 @@ BOOST_AUTO_TEST_CASE(MoveOperatorNaiveTest)
   }
 }
 
+/**
+ * Only single-tree search with the cover tree writes to the statistics of the
+ * reference tree, so it is the only search that can't be run concurrently.
+ */
+BOOST_AUTO_TEST_CASE(SupportsConcurrentSearchTest)
+{
+  typedef RangeSearch<EuclideanDistance, arma::mat, StandardCoverTree>
+      CoverTreeRangeSearch;
+
+  BOOST_REQUIRE(RangeSearch<>(false, false).SupportsConcurrentSearch());
+  BOOST_REQUIRE(RangeSearch<>(false, true).SupportsConcurrentSearch());
+  BOOST_REQUIRE(RangeSearch<>(true, false).SupportsConcurrentSearch());
+  BOOST_REQUIRE(CoverTreeRangeSearch(false, false).SupportsConcurrentSearch());
+  BOOST_REQUIRE(!CoverTreeRangeSearch(false, true).SupportsConcurrentSearch());
+  BOOST_REQUIRE(CoverTreeRangeSearch(true, true).SupportsConcurrentSearch());
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -152,6 +152,72 @@ BOOST_AUTO_TEST_CASE(SequenceClassificationTest)
   BOOST_REQUIRE_GE(successes, 1);
 }
 
+/**
+ * Make sure that the gradient is reproducible when the per-timestep buffers are
+ * reused, and that truncated backpropagation through time (BPTT) leaves the
+ * network in a consistent state.
+ */
+BOOST_AUTO_TEST_CASE(TruncatedBPTTGradientTest)
+{
+  const size_t rho = 10;
+
+  arma::mat input, labelsTemp;
+  GenerateNoisySines(input, labelsTemp, rho, 2);
+
+  arma::mat labels = arma::zeros<arma::mat>(rho, labelsTemp.n_cols);
+  for (size_t i = 0; i < labelsTemp.n_cols; ++i)
+  {
+    const int value = arma::as_scalar(arma::find(
+        arma::max(labelsTemp.col(i)) == labelsTemp.col(i), 1)) + 1;
+    labels.col(i).fill(value);
+  }
+
+  RNN<> model(input, labels, rho);
+  model.Add<IdentityLayer<> >();
+  model.Add<LSTM<> >(1, 4, rho);
+  model.Add<Linear<> >(4, 10);
+  model.Add<LogSoftMax<> >();
+
+  BOOST_REQUIRE_EQUAL(model.BPTTSteps(), rho);
+
+  arma::mat gradient1, gradient2, gradient3, gradient4;
+  model.Gradient(model.Parameters(), 0, gradient1);
+  model.Gradient(model.Parameters(), 0, gradient2);
+
+  // Backpropagate only through the last three steps.
+  model.BPTTSteps() = 3;
+  model.Gradient(model.Parameters(), 0, gradient3);
+
+  model.BPTTSteps() = rho;
+  model.Gradient(model.Parameters(), 0, gradient4);
+
+  BOOST_REQUIRE_EQUAL(gradient1.n_elem, gradient3.n_elem);
+  for (size_t i = 0; i < gradient1.n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(gradient1[i], gradient2[i], 1e-5);
+    BOOST_REQUIRE_CLOSE(gradient1[i], gradient4[i], 1e-5);
+    BOOST_REQUIRE(std::isfinite(gradient3[i]));
+  }
+
+  // The truncated gradient ignores the first steps of the sequence.
+  BOOST_REQUIRE_GT(arma::norm(gradient1 - gradient3), 1e-10);
+
+  // More steps than rho give the full gradient, and 0 steps are treated as 1.
+  arma::mat gradient5, gradient6, gradient7;
+  model.BPTTSteps() = rho + 5;
+  model.Gradient(model.Parameters(), 0, gradient5);
+  model.BPTTSteps() = 0;
+  model.Gradient(model.Parameters(), 0, gradient6);
+  model.BPTTSteps() = 1;
+  model.Gradient(model.Parameters(), 0, gradient7);
+
+  for (size_t i = 0; i < gradient1.n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(gradient1[i], gradient5[i], 1e-5);
+    BOOST_REQUIRE_CLOSE(gradient7[i], gradient6[i], 1e-5);
+  }
+}
+
 /**
  * Generate a random Reber grammar.
  *
@@ -249,4 +249,150 @@ BOOST_AUTO_TEST_CASE(RegularizedSVDFunctionOptimize)
   BOOST_REQUIRE_SMALL(relativeError, 1e-2);
 }
 
+/**
+ * The batch objective should be the sum of the per-example objectives, and the
+ * batch gradient over all examples should be the full gradient.
+ */
+BOOST_AUTO_TEST_CASE(RegularizedSVDFunctionBatchTest)
+{
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 500;
+  const size_t rank = 5;
+
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data.row(2) = floor(data.row(2) * 5 + 0.5);
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  RegularizedSVDFunction rSVDFunc(data, rank, 0.5);
+  const arma::mat parameters = arma::randu(rank, numUsers + numItems);
+
+  double cost = 0;
+  for (size_t i = 100; i < 200; ++i)
+    cost += rSVDFunc.Evaluate(parameters, i);
+  BOOST_REQUIRE_CLOSE(rSVDFunc.Evaluate(parameters, 100, 100), cost, 1e-5);
+
+  arma::mat gradient, batchGradient;
+  rSVDFunc.Gradient(parameters, gradient);
+  rSVDFunc.Gradient(parameters, 0, numRatings, batchGradient);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+  {
+    if (std::abs(gradient[i]) < 1e-8)
+      BOOST_REQUIRE_SMALL(batchGradient[i], 1e-8);
+    else
+      BOOST_REQUIRE_CLOSE(batchGradient[i], gradient[i], 1e-5);
+  }
+}
+
+/**
+ * Make a random rating dataset from random low-rank factors.  The last rating
+ * is for the last user and the last item, so that the data has numUsers users
+ * and numItems items.
+ */
+void LowRankRatings(const size_t numUsers,
+                    const size_t numItems,
+                    const size_t numRatings,
+                    const size_t rank,
+                    arma::mat& data)
+{
+  arma::mat parameters = arma::randu(rank, numUsers + numItems);
+  data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+  for (size_t i = 0; i < numRatings; i++)
+  {
+    data(2, i) = arma::dot(parameters.col(data(0, i)),
+                           parameters.col(numUsers + data(1, i)));
+  }
+}
+
+/**
+ * Stratified SGD should fit the ratings as well as StandardSGD, and for a fixed
+ * number of strata the result should not depend on the number of threads.
+ */
+BOOST_AUTO_TEST_CASE(RegularizedSVDStratifiedSGDTest)
+{
+  const size_t numUsers = 50;
+  const size_t numItems = 40;
+  const size_t numRatings = 600;
+  const size_t rank = 5;
+
+  arma::mat data;
+  LowRankRatings(numUsers, numItems, numRatings, rank, data);
+
+  RegularizedSVDFunction rSVDFunc(data, rank, 0.001);
+  StratifiedSGD<> optimizer(rSVDFunc, 0.02, 200 * numRatings, 4);
+
+  const arma::mat initialPoint = arma::randu(rank, numUsers + numItems);
+
+  arma::mat optParameters = initialPoint;
+  math::RandomSeed(42);
+  optimizer.Optimize(optParameters);
+
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; i++)
+  {
+    predictedData(0, i) = arma::dot(optParameters.col(data(0, i)),
+                                    optParameters.col(numUsers + data(1, i)));
+  }
+
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data.row(2), "frob");
+  BOOST_REQUIRE_SMALL(relativeError, 0.05);
+
+#ifdef HAS_OPENMP
+  // Run again on a single thread with the same seed; the blocks are the same,
+  // so the result should be identical.
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  arma::mat serialParameters = initialPoint;
+  math::RandomSeed(42);
+  optimizer.Optimize(serialParameters);
+  omp_set_num_threads(threads);
+
+  for (size_t i = 0; i < optParameters.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(optParameters[i], serialParameters[i], 1e-10);
+#endif
+}
+
+/**
+ * RegularizedSVD<StratifiedSGD>::Apply() should give user and item matrices
+ * that reconstruct the ratings.
+ */
+BOOST_AUTO_TEST_CASE(RegularizedSVDStratifiedSGDApplyTest)
+{
+  const size_t numUsers = 50;
+  const size_t numItems = 40;
+  const size_t numRatings = 600;
+  const size_t rank = 5;
+
+  arma::mat data;
+  LowRankRatings(numUsers, numItems, numRatings, rank, data);
+
+  RegularizedSVD<StratifiedSGD> rSVD(200, 0.02, 0.001);
+  arma::mat u, v;
+  rSVD.Apply(data, rank, u, v);
+
+  BOOST_REQUIRE_EQUAL(u.n_rows, numItems);
+  BOOST_REQUIRE_EQUAL(u.n_cols, rank);
+  BOOST_REQUIRE_EQUAL(v.n_rows, rank);
+  BOOST_REQUIRE_EQUAL(v.n_cols, numUsers);
+
+  // u holds the item vectors as rows, and v holds the user vectors as columns.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; i++)
+  {
+    predictedData(0, i) = arma::dot(u.row(data(1, i)), v.col(data(0, i)));
+  }
+
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data.row(2), "frob");
+  BOOST_REQUIRE_SMALL(relativeError, 0.05);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
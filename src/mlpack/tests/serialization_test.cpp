@@ -1690,4 +1690,154 @@ BOOST_AUTO_TEST_CASE(HoeffdingTreeTest)
   }
 }
 
+/**
+ * Make sure the mappings of a DatasetInfo survive serialization.
+ */
+BOOST_AUTO_TEST_CASE(DatasetInfoTest)
+{
+  data::DatasetInfo info(4);
+  for (size_t i = 0; i < 1000; ++i)
+    info.MapString<double>("string" + std::to_string(i), 1);
+  info.MapString<double>("a", 3);
+  info.MapString<double>("b", 3);
+
+  data::DatasetInfo xmlInfo(1), textInfo(2), binaryInfo(3);
+  xmlInfo.MapString<double>("c", 0);
+
+  SerializeObjectAll(info, xmlInfo, textInfo, binaryInfo);
+
+  BOOST_REQUIRE_EQUAL(xmlInfo.Dimensionality(), 4);
+  BOOST_REQUIRE_EQUAL(textInfo.Dimensionality(), 4);
+  BOOST_REQUIRE_EQUAL(binaryInfo.Dimensionality(), 4);
+  for (size_t d = 0; d < 4; ++d)
+  {
+    BOOST_REQUIRE(xmlInfo.Type(d) == info.Type(d));
+    BOOST_REQUIRE(textInfo.Type(d) == info.Type(d));
+    BOOST_REQUIRE(binaryInfo.Type(d) == info.Type(d));
+
+    BOOST_REQUIRE_EQUAL(xmlInfo.NumMappings(d), info.NumMappings(d));
+    BOOST_REQUIRE_EQUAL(textInfo.NumMappings(d), info.NumMappings(d));
+    BOOST_REQUIRE_EQUAL(binaryInfo.NumMappings(d), info.NumMappings(d));
+
+    for (size_t i = 0; i < info.NumMappings(d); ++i)
+    {
+      const std::string& s = info.UnmapString(i, d);
+      BOOST_REQUIRE_EQUAL(xmlInfo.UnmapString(i, d), s);
+      BOOST_REQUIRE_EQUAL(textInfo.UnmapString(i, d), s);
+      BOOST_REQUIRE_EQUAL(binaryInfo.UnmapString(i, d), s);
+      BOOST_REQUIRE_EQUAL(xmlInfo.UnmapValue(s, d), i);
+      BOOST_REQUIRE_EQUAL(textInfo.UnmapValue(s, d), i);
+      BOOST_REQUIRE_EQUAL(binaryInfo.UnmapValue(s, d), i);
+    }
+  }
+}
+
+/**
+ * The layout of DatasetInfo before version 1, which held the mappings of each
+ * dimension as a boost::bimap and the number of mappings.  It is used to write
+ * version 0 archives.
+ */
+class OldDatasetInfo
+{
+ public:
+  std::vector<data::Datatype> types;
+  std::unordered_map<size_t,
+      std::pair<boost::bimap<std::string, size_t>, size_t>> maps;
+
+  template<typename Archive>
+  void Serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & data::CreateNVP(types, "types");
+    ar & data::CreateNVP(maps, "maps");
+  }
+};
+
+/**
+ * Save an OldDatasetInfo and load it as a DatasetInfo with the given archive
+ * types.
+ */
+template<typename IArchiveType, typename OArchiveType>
+void LoadOldDatasetInfo(OldDatasetInfo& oldInfo, data::DatasetInfo& info)
+{
+  std::ofstream ofs("test", std::ios::binary);
+  {
+    OArchiveType o(ofs);
+    o << data::CreateNVP(oldInfo, "t");
+  }
+  ofs.close();
+
+  std::ifstream ifs("test", std::ios::binary);
+  bool success = true;
+  try
+  {
+    IArchiveType i(ifs);
+    i >> data::CreateNVP(info, "t");
+  }
+  catch (boost::archive::archive_exception& e)
+  {
+    success = false;
+  }
+  ifs.close();
+
+  BOOST_REQUIRE_EQUAL(success, true);
+}
+
+/**
+ * Make sure a DatasetInfo can still be loaded from a version 0 archive, where
+ * the mappings were stored as bimaps.
+ */
+BOOST_AUTO_TEST_CASE(DatasetInfoVersionZeroTest)
+{
+  typedef boost::bimap<std::string, size_t>::value_type Mapping;
+
+  OldDatasetInfo oldInfo;
+  oldInfo.types = { data::Datatype::numeric, data::Datatype::categorical,
+      data::Datatype::numeric, data::Datatype::categorical };
+
+  // The strings are not in the order of their values.
+  oldInfo.maps[1].first.insert(Mapping("c", 0));
+  oldInfo.maps[1].first.insert(Mapping("a", 1));
+  oldInfo.maps[1].first.insert(Mapping("b", 2));
+  oldInfo.maps[1].second = 3;
+  for (size_t i = 0; i < 1000; ++i)
+    oldInfo.maps[3].first.insert(Mapping("string" + std::to_string(i), i));
+  oldInfo.maps[3].second = 1000;
+
+  data::DatasetInfo xmlInfo(1), textInfo(2), binaryInfo(3);
+  LoadOldDatasetInfo<xml_iarchive, xml_oarchive>(oldInfo, xmlInfo);
+  LoadOldDatasetInfo<text_iarchive, text_oarchive>(oldInfo, textInfo);
+  LoadOldDatasetInfo<binary_iarchive, binary_oarchive>(oldInfo, binaryInfo);
+
+  std::vector<data::DatasetInfo*> infos = { &xmlInfo, &textInfo,
+      &binaryInfo };
+  for (data::DatasetInfo* info : infos)
+  {
+    BOOST_REQUIRE_EQUAL(info->Dimensionality(), 4);
+    for (size_t d = 0; d < 4; ++d)
+    {
+      BOOST_REQUIRE(info->Type(d) == oldInfo.types[d]);
+
+      const size_t numMappings = (oldInfo.maps.count(d) == 0) ? 0 :
+          oldInfo.maps[d].second;
+      BOOST_REQUIRE_EQUAL(info->NumMappings(d), numMappings);
+    }
+
+    BOOST_REQUIRE_EQUAL(info->UnmapValue("c", 1), 0);
+    BOOST_REQUIRE_EQUAL(info->UnmapValue("a", 1), 1);
+    BOOST_REQUIRE_EQUAL(info->UnmapValue("b", 1), 2);
+    BOOST_REQUIRE_EQUAL(info->UnmapString(0, 1), "c");
+    BOOST_REQUIRE_EQUAL(info->UnmapString(1, 1), "a");
+    BOOST_REQUIRE_EQUAL(info->UnmapString(2, 1), "b");
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const std::string str = "string" + std::to_string(i);
+      BOOST_REQUIRE_EQUAL(info->UnmapString(i, 3), str);
+      BOOST_REQUIRE_EQUAL(info->UnmapValue(str, 3), i);
+    }
+
+    // New strings continue after the loaded ones.
+    BOOST_REQUIRE_EQUAL(info->MapString<double>("d", 1), 3.0);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
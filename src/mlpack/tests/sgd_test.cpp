@@ -58,4 +58,75 @@ BOOST_AUTO_TEST_CASE(GeneralizedRosenbrockTest)
   }
 }
 
+/**
+ * Make sure that the objective policies report the expected objectives, and
+ * that SGD still converges with each of them.
+ */
+BOOST_AUTO_TEST_CASE(SGDObjectivePolicyTest)
+{
+  SGDTestFunction f;
+  arma::mat coordinates = f.GetInitialPoint();
+  const double objective = f.Evaluate(coordinates, 0) +
+      f.Evaluate(coordinates, 1) + f.Evaluate(coordinates, 2);
+
+  // The exact policy (which evaluates the starting point in batches of two
+  // functions here) and a sample containing every function must both report
+  // the true objective of the starting point.
+  ExactObjective exact;
+  exact.Initialize(f, coordinates, 2);
+  double epochObjective = 0.0;
+  BOOST_REQUIRE(exact.EpochObjective(f, coordinates, epochObjective));
+  BOOST_REQUIRE_CLOSE(epochObjective, objective, 1e-5);
+
+  SampledObjective sampled(2, 10);
+  sampled.Initialize(f, coordinates, 1);
+  epochObjective = 0.0;
+  BOOST_REQUIRE(sampled.EpochObjective(f, coordinates, epochObjective));
+  BOOST_REQUIRE_CLOSE(epochObjective, objective, 1e-5);
+  // The next pass is skipped.
+  BOOST_REQUIRE(!sampled.EpochObjective(f, coordinates, epochObjective));
+
+  // The moving average has nothing to report before the first update, and
+  // after one update it is the (scaled) loss of that batch.
+  MovingAverageObjective average(0.9, 1);
+  average.Initialize(f, coordinates, 1);
+  BOOST_REQUIRE(!average.EpochObjective(f, coordinates, epochObjective));
+  average.Update(f, coordinates, 1, 1);
+  BOOST_REQUIRE(average.EpochObjective(f, coordinates, epochObjective));
+  BOOST_REQUIRE_CLOSE(epochObjective, 3 * f.Evaluate(coordinates, 1), 1e-5);
+
+  NoObjective none;
+  BOOST_REQUIRE(!none.EpochObjective(f, coordinates, epochObjective));
+
+  // All of the policies must still find the minimum.  The optimizations start
+  // close to the minimum, so that few iterations are needed.
+  const arma::mat start("1; 1; 1");
+  SGD<SGDTestFunction, VanillaUpdate, MovingAverageObjective> s1(f, 0.0003,
+      200000, 1e-9, true, VanillaUpdate(), MovingAverageObjective(0.99, 1));
+  coordinates = start;
+  s1.Optimize(coordinates);
+  BOOST_REQUIRE_SMALL(coordinates[0], 1e-3);
+  BOOST_REQUIRE_SMALL(coordinates[1], 1e-7);
+  BOOST_REQUIRE_SMALL(coordinates[2], 1e-7);
+
+  SGD<SGDTestFunction, VanillaUpdate, SampledObjective> s2(f, 0.0003, 200000,
+      1e-9, true, VanillaUpdate(), SampledObjective(5));
+  coordinates = start;
+  s2.Optimize(coordinates);
+  BOOST_REQUIRE_SMALL(coordinates[0], 1e-3);
+  BOOST_REQUIRE_SMALL(coordinates[1], 1e-7);
+  BOOST_REQUIRE_SMALL(coordinates[2], 1e-7);
+
+  // Without an objective, SGD runs for all of the iterations, and the final
+  // objective is computed exactly.
+  SGD<SGDTestFunction, VanillaUpdate, NoObjective> s3(f, 0.0003, 200000,
+      1e-9, true);
+  coordinates = start;
+  const double result = s3.Optimize(coordinates);
+  BOOST_REQUIRE_CLOSE(result, -1.0, 0.05);
+  BOOST_REQUIRE_SMALL(coordinates[0], 1e-3);
+  BOOST_REQUIRE_SMALL(coordinates[1], 1e-7);
+  BOOST_REQUIRE_SMALL(coordinates[2], 1e-7);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
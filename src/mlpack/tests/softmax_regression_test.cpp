@@ -671,4 +671,46 @@ BOOST_AUTO_TEST_CASE(SoftmaxRegressionComputeProbabilitiesAndLabelsTest)
   }
 }
 
+/**
+ * The batch objective and gradient, summed over all batches, should be equal
+ * to the full objective and gradient.
+ */
+BOOST_AUTO_TEST_CASE(SoftmaxRegressionFunctionBatchTest)
+{
+  const size_t points = 1000;
+  const size_t inputSize = 10;
+  const size_t numClasses = 5;
+  const size_t batchSize = 300;
+
+  arma::mat data;
+  data.randu(inputSize, points);
+
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; i++)
+    labels(i) = math::RandInt(0, numClasses);
+
+  SoftmaxRegressionFunction srf(data, labels, numClasses, 1.0, true);
+
+  arma::mat parameters;
+  parameters.randu(numClasses, inputSize + 1);
+
+  arma::mat gradient, batchGradient;
+  srf.Gradient(parameters, gradient);
+
+  double objective = 0;
+  arma::mat batchGradientSum = arma::zeros<arma::mat>(gradient.n_rows,
+      gradient.n_cols);
+  for (size_t begin = 0; begin < points; begin += batchSize)
+  {
+    const size_t size = std::min(batchSize, points - begin);
+    objective += srf.Evaluate(parameters, begin, size);
+    srf.Gradient(parameters, begin, size, batchGradient);
+    batchGradientSum += batchGradient;
+  }
+
+  BOOST_REQUIRE_CLOSE(objective, srf.Evaluate(parameters), 1e-5);
+  for (size_t i = 0; i < gradient.n_elem; ++i)
+    BOOST_REQUIRE_CLOSE(batchGradientSum[i], gradient[i], 1e-5);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
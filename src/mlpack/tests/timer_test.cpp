@@ -90,4 +90,44 @@ BOOST_AUTO_TEST_CASE(TwiceStartTimerTest)
   BOOST_REQUIRE_THROW(Timer::Start("test_timer"), std::runtime_error);
 }
 
+/**
+ * Timers started through handles from several threads should be merged, and
+ * nested timers should record their parent.
+ */
+BOOST_AUTO_TEST_CASE(HandleTimerStatisticsTest)
+{
+  const TimerHandle outer = Timer::Handle("test_outer_timer");
+  const TimerHandle inner = Timer::Handle("test_inner_timer");
+  BOOST_REQUIRE_EQUAL(outer.ID(), Timer::Handle("test_outer_timer").ID());
+
+  Timer::Start(outer);
+
+  #pragma omp parallel for
+  for (int i = 0; i < 100; ++i)
+  {
+    ScopedTimer t(inner);
+  }
+
+  Timer::Stop(outer);
+  BOOST_REQUIRE_THROW(Timer::Stop(outer), std::runtime_error);
+
+  const TimerStatistics innerStats = Timer::GetStatistics("test_inner_timer");
+  BOOST_REQUIRE_EQUAL(innerStats.calls, (size_t) 100);
+  BOOST_REQUIRE_GE(innerStats.threads, (size_t) 1);
+  BOOST_REQUIRE_LE(innerStats.min.count(), innerStats.max.count());
+  BOOST_REQUIRE_EQUAL(innerStats.total.count(), Timer::Get(inner).count());
+
+  const TimerStatistics outerStats = Timer::GetStatistics("test_outer_timer");
+  BOOST_REQUIRE_EQUAL(outerStats.calls, (size_t) 1);
+  BOOST_REQUIRE_EQUAL(outerStats.min.count(), outerStats.max.count());
+
+  // The timer run on the main thread is nested inside the outer timer.
+  std::ostringstream json;
+  Timer::ToJSON(json);
+  BOOST_REQUIRE_NE(json.str().find("\"name\": \"test_inner_timer\""),
+      std::string::npos);
+  BOOST_REQUIRE_NE(json.str().find("\"parent\": \"test_outer_timer\""),
+      std::string::npos);
+}
+
 BOOST_AUTO_TEST_SUITE_END();